@@ -5,6 +5,7 @@
 #include "flutter/assets/asset_manager.h"
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -67,6 +68,8 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  fml::StartupProfiler::ScopedSpan startup_span("AssetManager::GetAsMapping",
+                                                asset_name);
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
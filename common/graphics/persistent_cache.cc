@@ -4,6 +4,7 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 #include <string>
@@ -21,7 +22,8 @@
 #include "flutter/shell/version/version.h"
 #include "openssl/sha.h"
 #include "rapidjson/document.h"
-#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
 namespace flutter {
@@ -30,6 +32,9 @@ std::string PersistentCache::cache_base_path_;
 
 std::shared_ptr<AssetManager> PersistentCache::asset_manager_;
 
+// How often the shader usage gathered by a run is written back to disk.
+static constexpr uint32_t kSkSLUsagePersistFrameInterval = 120;
+
 std::mutex PersistentCache::instance_mutex_;
 std::unique_ptr<PersistentCache> PersistentCache::gPersistentCache;
 
@@ -191,33 +196,6 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return data;
 }
 
-size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
-  // clang-tidy has trouble reasoning about some of the complicated array and
-  // pointer-arithmetic code in rapidjson.
-  // NOLINTNEXTLINE(clang-analyzer-cplusplus.PlacementNew)
-  auto known_sksls = LoadSkSLs();
-  // A trace must be present even if no precompilations have been completed.
-  FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
-                  known_sksls.size());
-
-  if (context == nullptr) {
-    return 0;
-  }
-
-  size_t precompiled_count = 0;
-  for (const auto& sksl : known_sksls) {
-    TRACE_EVENT0("flutter", "PrecompilingSkSL");
-    if (context->precompileShader(*sksl.key, *sksl.value)) {
-      precompiled_count++;
-    }
-  }
-
-  FML_TRACE_COUNTER("flutter", "PersistentCache::PrecompiledSkSLs",
-                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
-                    "Successful", precompiled_count);
-  return precompiled_count;
-}
-
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
@@ -279,7 +257,8 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      sksl_usage_(std::make_shared<SkSLUsageState>()) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -340,10 +319,107 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
       PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    RecordSkSLUse(file_name);
   }
   return result;
 }
 
+void PersistentCache::MarkFrameStart() {
+  if (++frame_count_ % kSkSLUsagePersistFrameInterval == 0) {
+    PersistSkSLUsage();
+  }
+}
+
+struct PersistentCache::SkSLUsageState {
+  std::mutex mutex;
+  // The usage written by previous runs, read from disk on first access.
+  bool persisted_loaded = false;
+  std::unordered_map<std::string, SkSLUsage> persisted;
+  // The usage recorded by this run.
+  std::unordered_map<std::string, SkSLUsage> recorded;
+  bool dirty = false;
+  // Held while the usage is written so that writes land in order.
+  std::mutex write_mutex;
+};
+
+static PersistentCache::SkSLUsage MergeSkSLUsage(
+    const PersistentCache::SkSLUsage& a,
+    const PersistentCache::SkSLUsage& b) {
+  return {
+      .first_use_frame = std::min(a.first_use_frame, b.first_use_frame),
+      .use_count =
+          a.use_count > std::numeric_limits<uint32_t>::max() - b.use_count
+              ? std::numeric_limits<uint32_t>::max()
+              : a.use_count + b.use_count,
+  };
+}
+
+static void LoadPersistedSkSLUsage(
+    const fml::UniqueFD& cache_directory,
+    std::unordered_map<std::string, PersistentCache::SkSLUsage>* usage) {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLUsage");
+  auto file = fml::OpenFileReadOnly(cache_directory,
+                                    PersistentCache::kSkSLUsageFileName);
+  if (!file.is_valid()) {
+    return;
+  }
+  fml::FileMapping mapping(file);
+  if (mapping.GetSize() == 0) {
+    return;
+  }
+  rapidjson::Document json_doc;
+  rapidjson::ParseResult parse_result =
+      json_doc.Parse(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+  if (parse_result.IsError() || !json_doc.IsObject() ||
+      !json_doc.HasMember("shaders") || !json_doc["shaders"].IsObject()) {
+    FML_LOG(ERROR) << "Failed to parse json file: "
+                   << PersistentCache::kSkSLUsageFileName;
+    return;
+  }
+  for (auto& item : json_doc["shaders"].GetObject()) {
+    const auto& value = item.value;
+    if (!value.IsArray() || value.Size() != 2 || !value[0].IsUint() ||
+        !value[1].IsUint()) {
+      continue;
+    }
+    (*usage)[item.name.GetString()] = {
+        .first_use_frame = value[0].GetUint(),
+        .use_count = value[1].GetUint(),
+    };
+  }
+}
+
+void PersistentCache::RecordSkSLUse(const std::string& file_name) {
+  std::scoped_lock lock(sksl_usage_->mutex);
+  SkSLUsage& usage = sksl_usage_->recorded[file_name];
+  usage = MergeSkSLUsage(usage, {.first_use_frame = frame_count_.load(),
+                                 .use_count = 1});
+  sksl_usage_->dirty = true;
+}
+
+PersistentCache::SkSLUsage PersistentCache::GetSkSLUsage(
+    const SkData& key) const {
+  auto file_name = SkKeyToFilePath(key);
+  std::scoped_lock lock(sksl_usage_->mutex);
+  if (!sksl_usage_->persisted_loaded) {
+    sksl_usage_->persisted_loaded = true;
+    if (IsValid()) {
+      LoadPersistedSkSLUsage(*cache_directory_, &sksl_usage_->persisted);
+    }
+  }
+  SkSLUsage usage;
+  if (auto found = sksl_usage_->persisted.find(file_name);
+      found != sksl_usage_->persisted.end()) {
+    usage = found->second;
+  }
+  if (auto found = sksl_usage_->recorded.find(file_name);
+      found != sksl_usage_->recorded.end()) {
+    usage = MergeSkSLUsage(usage, found->second);
+  }
+  return usage;
+}
+
 static void PersistentCacheStore(
     const fml::RefPtr<fml::TaskRunner>& worker,
     const std::shared_ptr<fml::UniqueFD>& cache_directory,
@@ -413,6 +489,8 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
+  RecordSkSLUse(file_name);
+
   std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
   if (!mapping) {
     return;
@@ -423,6 +501,76 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::PersistSkSLUsage() {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(sksl_usage_->mutex);
+    if (!sksl_usage_->dirty) {
+      return;
+    }
+    sksl_usage_->dirty = false;
+  }
+
+  auto task = [state = sksl_usage_, cache_directory = cache_directory_]() {
+    TRACE_EVENT0("flutter", "PersistentCache::PersistSkSLUsage");
+    std::scoped_lock write_lock(state->write_mutex);
+    // Read the usage of previous runs without blocking the recording of new
+    // usage.
+    bool persisted_loaded;
+    {
+      std::scoped_lock lock(state->mutex);
+      persisted_loaded = state->persisted_loaded;
+    }
+    std::unordered_map<std::string, SkSLUsage> persisted;
+    if (!persisted_loaded) {
+      LoadPersistedSkSLUsage(*cache_directory, &persisted);
+    }
+
+    std::unordered_map<std::string, SkSLUsage> usage;
+    {
+      std::scoped_lock lock(state->mutex);
+      if (!state->persisted_loaded) {
+        state->persisted_loaded = true;
+        state->persisted = std::move(persisted);
+      }
+      usage = state->persisted;
+      for (const auto& [file_name, recorded] : state->recorded) {
+        usage[file_name] = MergeSkSLUsage(usage[file_name], recorded);
+      }
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("shaders");
+    writer.StartObject();
+    for (const auto& [file_name, file_usage] : usage) {
+      writer.Key(file_name.c_str(), file_name.size());
+      writer.StartArray();
+      writer.Uint(file_usage.first_use_frame);
+      writer.Uint(file_usage.use_count);
+      writer.EndArray();
+    }
+    writer.EndObject();
+    writer.EndObject();
+
+    fml::NonOwnedMapping mapping(
+        reinterpret_cast<const uint8_t*>(buffer.GetString()),
+        buffer.GetSize());
+    if (!fml::WriteAtomically(*cache_directory, kSkSLUsageFileName, mapping)) {
+      FML_LOG(WARNING) << "Could not write shader usage to persistent store.";
+    }
+  };
+
+  if (auto worker = GetWorkerTaskRunner()) {
+    worker->PostTask(std::move(task));
+  } else {
+    task();
+  }
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
@@ -5,9 +5,13 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
@@ -77,6 +81,11 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // frame so we can know if Skia tries to compile new shaders in that frame.
   bool StoredNewShaders() const { return stored_new_shaders_; }
   void ResetStoredNewShaders() { stored_new_shaders_ = false; }
+
+  // Advances the frame counter that shader usage is attributed to. This is
+  // called by the rasterizer before each frame. The usage gathered so far is
+  // periodically written back to disk from here.
+  void MarkFrameStart();
   void DumpSkp(const SkData& data);
   bool IsDumpingSkp() const { return is_dumping_skp_; }
   void SetIsDumpingSkp(bool value) { is_dumping_skp_ = value; }
@@ -96,20 +105,31 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   /// Load all the SkSL shader caches in the right directory.
   std::vector<SkSLCache> LoadSkSLs() const;
 
-  //----------------------------------------------------------------------------
-  /// @brief      Precompile SkSLs packaged with the application and gathered
-  ///             during previous runs in the given context.
-  ///
-  /// @warning    The context must be the rendering context. This context may be
-  ///             destroyed during application suspension and subsequently
-  ///             recreated. The SkSLs must be precompiled again in the new
-  ///             context.
-  ///
-  /// @param      context  The rendering context to precompile shaders in.
-  ///
-  /// @return     The number of SkSLs precompiled.
-  ///
-  size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
+  /// How a cached shader was used by this and previous runs of the
+  /// application.
+  struct SkSLUsage {
+    static constexpr uint32_t kUnknownFrame =
+        std::numeric_limits<uint32_t>::max();
+
+    /// The earliest frame in which Skia asked for the shader, counting from
+    /// one. Shaders requested before the first frame report frame zero.
+    uint32_t first_use_frame = kUnknownFrame;
+    /// How many times Skia asked for the shader to be loaded or stored.
+    uint32_t use_count = 0;
+  };
+
+  /// The recorded usage of the shader with the given key, or the default
+  /// usage if the shader has never been seen. The usage of previous runs is
+  /// read from disk on the first call, so this should only be called while
+  /// SkSLs are being loaded anyway.
+  SkSLUsage GetSkSLUsage(const SkData& key) const;
+
+  /// Write the shader usage recorded so far to disk so that the next run can
+  /// prioritize its warmup accordingly. The usage is merged and written on a
+  /// worker task runner, or on the calling thread if there is none. This
+  /// happens periodically on its own and only needs to be called explicitly
+  /// to persist usage immediately.
+  void PersistSkSLUsage();
 
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
@@ -129,6 +149,7 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kSkSLUsageFileName[] = "sksl_usage.json";
 
  private:
   static std::string cache_base_path_;
@@ -157,12 +178,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
 
+  // Frames started since the cache was created.
+  std::atomic<uint32_t> frame_count_ = 0;
+  // Shader usage keyed by cache file name. Usage is recorded in memory on the
+  // raster thread, and only merged with the usage of previous runs and
+  // written to disk on a worker. It is shared with the tasks that do so.
+  struct SkSLUsageState;
+  std::shared_ptr<SkSLUsageState> sksl_usage_;
+
   static SkSLCache LoadFile(const fml::UniqueFD& dir,
                             const std::string& file_name,
                             bool need_key);
 
   bool IsValid() const;
 
+  void RecordSkSLUse(const std::string& file_name);
+
   explicit PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/sksl_warmup.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+SkSLWarmup::SkSLWarmup(const PersistentCache& cache) {
+  struct Candidate {
+    PersistentCache::SkSLCache sksl;
+    PersistentCache::SkSLUsage usage;
+    bool critical;
+  };
+
+  std::vector<Candidate> candidates;
+  for (auto& sksl : cache.LoadSkSLs()) {
+    auto usage = cache.GetSkSLUsage(*sksl.key);
+    // Without recorded usage there is no telling when the shader is needed,
+    // so it is treated the way all shaders were before usage was recorded.
+    bool critical = usage.first_use_frame <= kCriticalFrame ||
+                    usage.first_use_frame ==
+                        PersistentCache::SkSLUsage::kUnknownFrame;
+    candidates.push_back({std::move(sksl), usage, critical});
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) {
+                     return std::make_tuple(!a.critical,
+                                            a.usage.first_use_frame,
+                                            b.usage.use_count) <
+                            std::make_tuple(!b.critical,
+                                            b.usage.first_use_frame,
+                                            a.usage.use_count);
+                   });
+
+  sksls_.reserve(candidates.size());
+  for (auto& candidate : candidates) {
+    if (candidate.critical) {
+      critical_count_++;
+    }
+    sksls_.push_back(std::move(candidate.sksl));
+  }
+}
+
+SkSLWarmup::~SkSLWarmup() = default;
+
+size_t SkSLWarmup::PrecompileCritical(GrDirectContext* context) {
+  FML_TRACE_EVENT("flutter", "SkSLWarmup::PrecompileCritical", "count",
+                  critical_count_);
+  if (context == nullptr) {
+    return 0;
+  }
+  size_t precompiled = 0;
+  while (next_ < critical_count_) {
+    if (PrecompileNext(context)) {
+      precompiled++;
+    }
+  }
+  ReportProgress();
+  return precompiled;
+}
+
+size_t SkSLWarmup::PrecompileBatch(GrDirectContext* context,
+                                   fml::TimeDelta budget) {
+  TRACE_EVENT0("flutter", "SkSLWarmup::PrecompileBatch");
+  if (context == nullptr) {
+    return 0;
+  }
+  const auto deadline = fml::TimePoint::Now() + budget;
+  size_t precompiled = 0;
+  do {
+    if (IsComplete()) {
+      break;
+    }
+    if (PrecompileNext(context)) {
+      precompiled++;
+    }
+  } while (fml::TimePoint::Now() < deadline);
+  ReportProgress();
+  if (IsComplete()) {
+    FML_DLOG(INFO) << "Precompiled " << precompiled_count_ << " of "
+                   << sksls_.size() << " known SkSLs.";
+  }
+  return precompiled;
+}
+
+bool SkSLWarmup::PrecompileNext(GrDirectContext* context) {
+  TRACE_EVENT0("flutter", "PrecompilingSkSL");
+  const auto& sksl = sksls_[next_++];
+  if (!context->precompileShader(*sksl.key, *sksl.value)) {
+    return false;
+  }
+  precompiled_count_++;
+  return true;
+}
+
+void SkSLWarmup::ReportProgress() const {
+  FML_TRACE_COUNTER("flutter", "SkSLWarmup::Progress",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Precompiled", precompiled_count_, "Pending",
+                    GetPendingCount());
+}
+
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_SKSL_WARMUP_H_
+#define FLUTTER_COMMON_GRAPHICS_SKSL_WARMUP_H_
+
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Precompiles the SkSLs known to a persistent cache in the order
+///             in which previous runs needed them.
+///
+///             Shaders that were needed by the first frame, along with shaders
+///             for which no usage has been recorded yet, are critical and are
+///             meant to be precompiled before the first frame. The remaining
+///             shaders are ordered by the frame that first needed them and
+///             then by how often they were needed, and are meant to be
+///             precompiled in small batches while the engine is idle so that
+///             they delay neither the first frame nor later ones.
+///
+///             This object is not thread safe. Precompilation must happen on
+///             the thread on which the context is used.
+///
+class SkSLWarmup {
+ public:
+  /// The last frame whose shaders are precompiled before the first frame.
+  static constexpr uint32_t kCriticalFrame = 1;
+
+  explicit SkSLWarmup(const PersistentCache& cache);
+
+  ~SkSLWarmup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompiles all critical shaders that have not been
+  ///             precompiled yet.
+  ///
+  /// @return     The number of shaders successfully precompiled.
+  ///
+  size_t PrecompileCritical(GrDirectContext* context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompiles the next pending shaders until the time budget
+  ///             is exhausted. At least one shader is precompiled if any are
+  ///             pending.
+  ///
+  /// @return     The number of shaders successfully precompiled.
+  ///
+  size_t PrecompileBatch(GrDirectContext* context, fml::TimeDelta budget);
+
+  /// Whether every known shader has been visited.
+  bool IsComplete() const { return next_ >= sksls_.size(); }
+
+  size_t GetCriticalCount() const { return critical_count_; }
+
+  size_t GetPendingCount() const { return sksls_.size() - next_; }
+
+  size_t GetPrecompiledCount() const { return precompiled_count_; }
+
+  /// The known shaders, in the order in which they are precompiled.
+  const std::vector<PersistentCache::SkSLCache>& GetSkSLs() const {
+    return sksls_;
+  }
+
+ private:
+  std::vector<PersistentCache::SkSLCache> sksls_;
+  size_t critical_count_ = 0;
+  size_t next_ = 0;
+  size_t precompiled_count_ = 0;
+
+  bool PrecompileNext(GrDirectContext* context);
+
+  void ReportProgress() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SkSLWarmup);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_SKSL_WARMUP_H_
@@ -126,6 +126,21 @@ struct Settings {
   std::string application_kernel_list_asset;  // deprecated
   MappingsCallback application_kernels;
 
+  // Whether the pages of the VM and isolate snapshots are read into memory on
+  // a worker thread as the VM starts, instead of being faulted in as they are
+  // first accessed.
+  bool prefetch_dart_snapshot = false;
+
+  // The path of the page profile that drives the snapshot prefetch. If the
+  // file exists, only the pages it records are prefetched. Otherwise, it is
+  // written once the first frame has been rasterized. Only used if
+  // |prefetch_dart_snapshot| is set.
+  std::string snapshot_page_profile_path;
+
+  // Whether the instructions of AOT snapshots are backed by transparent huge
+  // pages. This is only supported on Linux and Android.
+  bool aot_instructions_huge_pages = false;
+
   std::string temp_directory_path;
   std::vector<std::string> dart_flags;
   // Isolate settings
@@ -301,6 +316,16 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // Max bytes of the decoded image cache shared by all engines in the process,
+  // or 0 to disable it. When engines in the same process specify different
+  // values, the largest one is used.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  // Budget in bytes for the caches of the engine that retain memory across
+  // frames, or 0 for no budget. When a frame leaves them over budget, they
+  // are trimmed, starting with the cheapest to rebuild.
+  size_t resource_memory_budget_bytes = 0;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
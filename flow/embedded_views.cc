@@ -107,6 +107,10 @@ void MutatorsStack::PushBackdropFilter(
   vector_.push_back(element);
 };
 
+void MutatorsStack::Push(const std::shared_ptr<Mutator>& mutator) {
+  vector_.push_back(mutator);
+}
+
 void MutatorsStack::Pop() {
   vector_.pop_back();
 };
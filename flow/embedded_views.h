@@ -141,7 +141,7 @@ class Mutator {
 
   bool operator!=(const Mutator& other) const { return !operator==(other); }
 
-  bool IsClipType() {
+  bool IsClipType() const {
     return type_ == kClipRect || type_ == kClipRRect || type_ == kClipPath;
   }
 
@@ -188,6 +188,11 @@ class MutatorsStack {
   void PushBackdropFilter(const std::shared_ptr<const DlImageFilter>& filter,
                           const SkRect& filter_rect);
 
+  // Pushes an existing `Mutator`. Mutators are immutable, so the same
+  // instance can be shared by the stacks of several platform views that have
+  // common ancestors, which avoids allocating it for every view.
+  void Push(const std::shared_ptr<Mutator>& mutator);
+
   // Removes the `Mutator` on the top of the stack
   // and destroys it.
   void Pop();
@@ -219,7 +224,9 @@ class MutatorsStack {
       return false;
     }
     for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
+      // Stacks of views with common ancestors share their mutators, so most
+      // elements compare by identity without comparing their contents.
+      if (vector_[i] != other.vector_[i] && *vector_[i] != *other.vector_[i]) {
         return false;
       }
     }
@@ -260,7 +267,7 @@ class EmbeddedViewParams {
                      bool display_list_enabled = false)
       : matrix_(matrix),
         size_points_(size_points),
-        mutators_stack_(mutators_stack),
+        mutators_stack_(std::move(mutators_stack)),
         display_list_enabled_(display_list_enabled) {
     SkPath path;
     SkRect starting_rect = SkRect::MakeSize(size_points);
@@ -294,10 +301,10 @@ class EmbeddedViewParams {
   bool display_list_enabled() const { return display_list_enabled_; }
 
   bool operator==(const EmbeddedViewParams& other) const {
-    return size_points_ == other.size_points_ &&
-           mutators_stack_ == other.mutators_stack_ &&
+    // The mutators stack is compared last as it is the most expensive.
+    return size_points_ == other.size_points_ && matrix_ == other.matrix_ &&
            final_bounding_rect_ == other.final_bounding_rect_ &&
-           matrix_ == other.matrix_;
+           mutators_stack_ == other.mutators_stack_;
   }
 
  private:
@@ -148,7 +148,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    layer->PrerollRetained(context);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
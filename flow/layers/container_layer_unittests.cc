@@ -117,6 +117,77 @@ TEST_F(ContainerLayerTest, Simple) {
                 0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
+TEST_F(ContainerLayerTest, RetainedSubtreeReusesPrerollWithinSameTransform) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+
+  preroll_context()->frame_id = 1;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(root->children_renderable_state_flags(), 0);
+
+  // Layers are immutable once built, so the only way to observe whether the
+  // retained subtree was prerolled again is to change the mock behind its
+  // back.
+  mock_layer->set_fake_opacity_compatible(true);
+
+  // Prerolling the same tree again outside of a frame does not reuse results.
+  preroll_context()->frame_id = 0;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  mock_layer->set_fake_opacity_compatible(false);
+  preroll_context()->frame_id = 2;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->children_renderable_state_flags(), 0);
+
+  // A later frame with the same transform reuses the recorded results.
+  mock_layer->set_fake_opacity_compatible(true);
+  preroll_context()->frame_id = 3;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(root->children_renderable_state_flags(), 0);
+
+  // A different transform prerolls the subtree again.
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.translate(10, 10);
+    preroll_context()->frame_id = 4;
+    root->Preroll(preroll_context());
+  }
+  EXPECT_EQ(root->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeWithReadbackIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_reads_surface(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+
+  preroll_context()->frame_id = 1;
+  root->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+
+  preroll_context()->surface_needs_readback = false;
+  mock_layer->set_fake_opacity_compatible(true);
+  preroll_context()->frame_id = 2;
+  root->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_EQ(root->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
 TEST_F(ContainerLayerTest, Multiple) {
   SkPath child_path1;
   child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
@@ -17,6 +17,51 @@ Layer::Layer()
 
 Layer::~Layer() = default;
 
+void Layer::PrerollRetained(PrerollContext* context) {
+  if (context->frame_id == 0 || !context->raster_cached_entries) {
+    Preroll(context);
+    return;
+  }
+
+  SkM44 matrix = context->state_stack.transform_4x4();
+  SkRect cull_rect = context->state_stack.device_cull_rect();
+  if (retained_preroll_.has_value() &&
+      retained_preroll_->frame_id < context->frame_id &&
+      retained_preroll_->raster_cache == context->raster_cache &&
+      retained_preroll_->gr_context == context->gr_context &&
+      retained_preroll_->cull_rect == cull_rect &&
+      retained_preroll_->matrix == matrix) {
+    // The paint bounds and the absence of platform views and texture layers
+    // are still those of the recorded Preroll.
+    retained_preroll_->frame_id = context->frame_id;
+    context->renderable_state_flags = retained_preroll_->renderable_state_flags;
+    return;
+  }
+
+  // Readback is accumulated across siblings, so isolate this subtree's.
+  bool prev_surface_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback = false;
+  size_t raster_cached_entries = context->raster_cached_entries->size();
+
+  Preroll(context);
+
+  if (context->has_platform_view || context->has_texture_layer ||
+      context->surface_needs_readback ||
+      context->raster_cached_entries->size() != raster_cached_entries) {
+    retained_preroll_.reset();
+  } else {
+    retained_preroll_ = {
+        .frame_id = context->frame_id,
+        .matrix = matrix,
+        .cull_rect = cull_rect,
+        .raster_cache = context->raster_cache,
+        .gr_context = context->gr_context,
+        .renderable_state_flags = context->renderable_state_flags,
+    };
+  }
+  context->surface_needs_readback |= prev_surface_needs_readback;
+}
+
 uint64_t Layer::NextUniqueID() {
   static std::atomic<uint64_t> next_id(1);
   uint64_t id;
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -87,6 +88,11 @@ struct PrerollContext {
   // the embedders that must decide between creating SkPicture or
   // DisplayList objects for the inter-view slices of the layer tree.
   bool display_list_enabled = false;
+
+  // Identifies the frame that is being prerolled, or 0 if this Preroll is
+  // not part of rendering a frame. Layers that are retained across frames
+  // can only reuse the results of an earlier Preroll when this is set.
+  uint64_t frame_id = 0;
 };
 
 struct PaintContext {
@@ -168,6 +174,16 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls |Preroll| unless this layer was already prerolled for an earlier
+  // frame under the same transform and cull rect, in which case the results
+  // of that Preroll are reused. Layers are never modified once they are part
+  // of a layer tree, so an identical instance appearing in a later frame
+  // (because the framework retained it) prerolls to the same results as
+  // long as its subtree does not depend on per-frame state. Subtrees that
+  // contain platform views, texture layers, readback or raster cache items
+  // are therefore always prerolled.
+  void PrerollRetained(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -269,6 +285,18 @@ class Layer {
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
 
+  // The inputs and the outputs not stored elsewhere on the layer of its last
+  // Preroll that is safe to reuse. See |PrerollRetained|.
+  struct RetainedPreroll {
+    uint64_t frame_id;
+    SkM44 matrix;
+    SkRect cull_rect;
+    const RasterCache* raster_cache;
+    const GrDirectContext* gr_context;
+    int renderable_state_flags;
+  };
+  std::optional<RetainedPreroll> retained_preroll_;
+
   static uint64_t NextUniqueID();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
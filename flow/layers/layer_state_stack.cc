@@ -321,7 +321,7 @@ class OpacityEntry : public LayerStateStack::StateEntry {
     stack->outstanding_.opacity = old_opacity_;
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushOpacity(DlColor::toAlpha(opacity_));
+    PushMutator(mutators_stack, static_cast<int>(DlColor::toAlpha(opacity_)));
   }
 
  private:
@@ -437,7 +437,7 @@ class TranslateEntry : public LayerStateStack::StateEntry {
     stack->delegate_->translate(tx_, ty_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(SkMatrix::Translate(tx_, ty_));
+    PushMutator(mutators_stack, SkMatrix::Translate(tx_, ty_));
   }
 
  private:
@@ -455,7 +455,7 @@ class TransformMatrixEntry : public LayerStateStack::StateEntry {
     stack->delegate_->transform(matrix_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(matrix_);
+    PushMutator(mutators_stack, matrix_);
   }
 
  private:
@@ -472,7 +472,7 @@ class TransformM44Entry : public LayerStateStack::StateEntry {
     stack->delegate_->transform(m44_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(m44_.asM33());
+    PushMutator(mutators_stack, m44_.asM33());
   }
 
  private:
@@ -502,7 +502,7 @@ class ClipRectEntry : public LayerStateStack::StateEntry {
     stack->delegate_->clipRect(clip_rect_, SkClipOp::kIntersect, is_aa_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipRect(clip_rect_);
+    PushMutator(mutators_stack, clip_rect_);
   }
 
  private:
@@ -521,7 +521,7 @@ class ClipRRectEntry : public LayerStateStack::StateEntry {
     stack->delegate_->clipRRect(clip_rrect_, SkClipOp::kIntersect, is_aa_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipRRect(clip_rrect_);
+    PushMutator(mutators_stack, clip_rrect_);
   }
 
  private:
@@ -541,7 +541,7 @@ class ClipPathEntry : public LayerStateStack::StateEntry {
     stack->delegate_->clipPath(clip_path_, SkClipOp::kIntersect, is_aa_);
   }
   void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipPath(clip_path_);
+    PushMutator(mutators_stack, clip_path_);
   }
 
  private:
@@ -441,6 +441,19 @@ class LayerStateStack {
    protected:
     StateEntry() = default;
 
+    // Pushes the mutator for this entry, creating it on first use so that
+    // all platform views under this entry share the same instance.
+    template <typename T>
+    void PushMutator(MutatorsStack* mutators_stack, const T& mutation) const {
+      if (!mutator_) {
+        mutator_ = std::make_shared<Mutator>(mutation);
+      }
+      mutators_stack->Push(mutator_);
+    }
+
+   private:
+    mutable std::shared_ptr<Mutator> mutator_;
+
     FML_DISALLOW_COPY_ASSIGN_AND_MOVE(StateEntry);
   };
   friend class SaveEntry;
@@ -516,5 +516,28 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, FillSharesMutatorsBetweenStacks) {
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(kGiantRect, SkMatrix::I());
+
+  auto mutator = state_stack.save();
+  mutator.translate(10, 10);
+  mutator.clipRect(SkRect::MakeWH(100, 100), false);
+
+  MutatorsStack first;
+  MutatorsStack second;
+  state_stack.fill(&first);
+  state_stack.fill(&second);
+
+  ASSERT_EQ(first.stack_count(), 2u);
+  ASSERT_EQ(second.stack_count(), 2u);
+  for (auto i = first.Begin(), j = second.Begin(); i != first.End(); ++i, ++j) {
+    ASSERT_EQ(*i, *j);
+  }
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first.Begin()->get()->GetType(), MutatorType::kTransform);
+  ASSERT_EQ(first.Begin()->get()->GetMatrix(), SkMatrix::Translate(10, 10));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <atomic>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layer_snapshot_store.h"
@@ -32,6 +34,11 @@ inline SkColorSpace* GetColorSpace(SkCanvas* canvas) {
   return canvas ? canvas->imageInfo().colorSpace() : nullptr;
 }
 
+static uint64_t NextPrerollFrameId() {
+  static std::atomic<uint64_t> next_id(1);
+  return next_id.fetch_add(1);
+}
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
@@ -66,6 +73,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .raster_cached_entries         = &raster_cache_items_,
       .display_list_enabled          = frame.display_list_builder() != nullptr,
+      .frame_id                      = NextPrerollFrameId(),
       // clang-format on
   };
 
@@ -26,7 +26,7 @@ void PlatformViewLayer::Preroll(PrerollContext* context) {
   context->state_stack.fill(&mutators);
   std::unique_ptr<EmbeddedViewParams> params =
       std::make_unique<EmbeddedViewParams>(context->state_stack.transform_3x3(),
-                                           size_, mutators,
+                                           size_, std::move(mutators),
                                            context->display_list_enabled);
   context->view_embedder->PrerollCompositeEmbeddedView(view_id_,
                                                        std::move(params));
@@ -113,6 +113,25 @@ TEST(MutatorsStack, PushBackdropFilter) {
   ASSERT_EQ(i, num_of_mutators);
 }
 
+TEST(MutatorsStack, PushSharedMutator) {
+  auto mutator = std::make_shared<Mutator>(SkRect::MakeWH(10, 10));
+  MutatorsStack stack;
+  MutatorsStack other_stack;
+  stack.Push(mutator);
+  other_stack.Push(mutator);
+  ASSERT_EQ(*stack.Begin(), mutator);
+  ASSERT_EQ(*other_stack.Begin(), mutator);
+  ASSERT_TRUE(stack == other_stack);
+
+  // Stacks that only share a prefix still compare the remaining contents.
+  stack.PushOpacity(240);
+  other_stack.PushOpacity(240);
+  ASSERT_TRUE(stack == other_stack);
+  other_stack.Pop();
+  other_stack.PushOpacity(241);
+  ASSERT_TRUE(stack != other_stack);
+}
+
 TEST(MutatorsStack, Pop) {
   MutatorsStack stack;
   SkMatrix matrix;
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -153,6 +154,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint);
+    entry.last_drawn_frame = frame_count_;
     return true;
   }
 
@@ -160,6 +162,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 }
 
 void RasterCache::BeginFrame() {
+  frame_count_++;
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -176,6 +179,13 @@ void RasterCache::UpdateMetrics() {
     }
     entry.encountered_this_frame = false;
   }
+
+  layer_metrics_.eviction_count += trimmed_layer_metrics_.eviction_count;
+  layer_metrics_.eviction_bytes += trimmed_layer_metrics_.eviction_bytes;
+  picture_metrics_.eviction_count += trimmed_picture_metrics_.eviction_count;
+  picture_metrics_.eviction_bytes += trimmed_picture_metrics_.eviction_bytes;
+  trimmed_layer_metrics_ = {};
+  trimmed_picture_metrics_ = {};
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
@@ -207,6 +217,39 @@ void RasterCache::Clear() {
   cache_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
+  trimmed_picture_metrics_ = {};
+  trimmed_layer_metrics_ = {};
+}
+
+size_t RasterCache::Trim(size_t bytes_to_free) {
+  std::vector<RasterCacheKey::Map<Entry>::iterator> candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& entry = it->second;
+    if (entry.image && entry.last_drawn_frame != frame_count_) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) {
+              return a->second.last_drawn_frame < b->second.last_drawn_frame;
+            });
+
+  size_t freed_bytes = 0;
+  for (auto it : candidates) {
+    if (freed_bytes >= bytes_to_free) {
+      break;
+    }
+    size_t image_bytes = it->second.image->image_bytes();
+    RasterCacheMetrics& metrics =
+        it->first.kind() == RasterCacheKeyKind::kLayerMetrics
+            ? trimmed_layer_metrics_
+            : trimmed_picture_metrics_;
+    metrics.eviction_count++;
+    metrics.eviction_bytes += image_bytes;
+    freed_bytes += image_bytes;
+    cache_.erase(it);
+  }
+  return freed_bytes;
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
@@ -158,6 +158,19 @@ class RasterCache {
 
   void Clear();
 
+  /**
+   * @brief Evict populated entries, least recently drawn first, until at
+   * least |bytes_to_free| bytes of images have been released. Entries drawn
+   * in the current frame are kept, as they would only be rasterized again
+   * for the next one.
+   *
+   * As trimming may happen between frames, the evictions are included in the
+   * metrics of the frame that ends next.
+   *
+   * @return the number of bytes of images that were evicted.
+   */
+  size_t Trim(size_t bytes_to_free);
+
   void SetCheckboardCacheImages(bool checkerboard);
 
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
@@ -245,6 +258,8 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The frame in which the image was last drawn, or 0 if it never was.
+    size_t last_drawn_frame = 0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
@@ -255,8 +270,13 @@ class RasterCache {
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
+  // Counts the frames begun so far, starting with frame 1.
+  size_t frame_count_ = 0;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
+  // Evictions by Trim that are not yet included in the metrics above.
+  RasterCacheMetrics trimmed_layer_metrics_;
+  RasterCacheMetrics trimmed_picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_;
 
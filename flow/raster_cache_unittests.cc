@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_test_utils.h"
@@ -432,6 +434,100 @@ TEST(RasterCache, EvitUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, TrimEvictsLeastRecentlyDrawnEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  auto display_list_3 = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1.get(),
+                                                 SkPoint(), true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2.get(),
+                                                 SkPoint(), true, false);
+  DisplayListRasterCacheItem display_list_item_3(display_list_3.get(),
+                                                 SkPoint(), true, false);
+  auto preroll_all = [&]() {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_3, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+  };
+
+  preroll_all();
+  cache.EndFrame();
+
+  // Every item is cached and drawn in the second frame, the first and third
+  // in the third frame, and only the first in the last frame.
+  preroll_all();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_3, paint_context));
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_3.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  preroll_all();
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_3.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  preroll_all();
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 76800u);
+
+  // Only the least recently drawn entry is needed to free a single byte.
+  ASSERT_EQ(cache.Trim(1), 25600u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51200u);
+  ASSERT_FALSE(
+      cache.Draw(display_list_item_2.GetId().value(), dummy_canvas, &paint));
+
+  // The entry drawn in the current frame is kept however much is asked for.
+  ASSERT_EQ(cache.Trim(std::numeric_limits<size_t>::max()), 25600u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+  ASSERT_FALSE(
+      cache.Draw(display_list_item_3.GetId().value(), dummy_canvas, &paint));
+  ASSERT_TRUE(
+      cache.Draw(display_list_item_1.GetId().value(), dummy_canvas, &paint));
+
+  // The evictions are reported with the next frame, as trimming happened
+  // after the last one ended.
+  preroll_all();
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 2u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 51200u);
+
+  preroll_all();
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
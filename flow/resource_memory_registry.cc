@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/resource_memory_registry.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ResourceMemoryRegistry::ResourceMemoryRegistry() = default;
+
+ResourceMemoryRegistry::~ResourceMemoryRegistry() = default;
+
+void ResourceMemoryRegistry::AddSource(std::string name,
+                                       GetBytesCallback get_bytes,
+                                       TrimCallback trim) {
+  FML_DCHECK(get_bytes);
+  sources_.push_back({
+      .name = std::move(name),
+      .get_bytes = std::move(get_bytes),
+      .trim = std::move(trim),
+  });
+}
+
+std::vector<ResourceMemoryRegistry::Usage> ResourceMemoryRegistry::GetUsage()
+    const {
+  std::vector<Usage> usage;
+  usage.reserve(sources_.size());
+  for (const auto& source : sources_) {
+    usage.push_back({.name = source.name, .bytes = source.get_bytes()});
+  }
+  return usage;
+}
+
+size_t ResourceMemoryRegistry::GetTotalBytes() const {
+  size_t total = 0;
+  for (const auto& source : sources_) {
+    total += source.get_bytes();
+  }
+  return total;
+}
+
+size_t ResourceMemoryRegistry::EnforceBudget() {
+  if (budget_bytes_ == 0) {
+    return 0;
+  }
+  size_t total = GetTotalBytes();
+  if (total <= budget_bytes_) {
+    return 0;
+  }
+  TRACE_EVENT0("flutter", "ResourceMemoryRegistry::EnforceBudget");
+  size_t excess = total - budget_bytes_;
+  size_t released = 0;
+  for (const auto& source : sources_) {
+    if (!source.trim) {
+      continue;
+    }
+    size_t source_released = source.trim(excess);
+    released += source_released;
+    if (source_released >= excess) {
+      break;
+    }
+    excess -= source_released;
+  }
+  return released;
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RESOURCE_MEMORY_REGISTRY_H_
+#define FLUTTER_FLOW_RESOURCE_MEMORY_REGISTRY_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Accounts for the memory that the caches of an engine retain
+///             across frames, and keeps their total within a budget.
+///
+///             Each cache registers as a source that reports its size and,
+///             optionally, can release memory on request. When the total
+///             exceeds the budget, sources are trimmed in the order in which
+///             they were added until the total fits again, so the caches
+///             that are cheapest to rebuild should be added first.
+///
+///             The registry is not thread safe. It, and the callbacks of its
+///             sources, are used on the raster thread.
+///
+class ResourceMemoryRegistry {
+ public:
+  /// Returns the number of bytes a source currently retains.
+  using GetBytesCallback = std::function<size_t()>;
+
+  /// Asks a source to release at least the given number of bytes if it can,
+  /// and returns the number of bytes it actually released.
+  using TrimCallback = std::function<size_t(size_t bytes_to_free)>;
+
+  struct Usage {
+    std::string name;
+    size_t bytes;
+  };
+
+  ResourceMemoryRegistry();
+
+  ~ResourceMemoryRegistry();
+
+  /// Adds a source. Sources without a trim callback are only reported.
+  void AddSource(std::string name,
+                 GetBytesCallback get_bytes,
+                 TrimCallback trim = nullptr);
+
+  /// The current size of every source, in the order they were added.
+  std::vector<Usage> GetUsage() const;
+
+  size_t GetTotalBytes() const;
+
+  /// The budget for the total size of all sources, or 0 for no budget.
+  size_t GetBudgetBytes() const { return budget_bytes_; }
+
+  void SetBudgetBytes(size_t budget_bytes) { budget_bytes_ = budget_bytes; }
+
+  /// Trims sources until their total size is within the budget, or until
+  /// every source has been asked to trim.
+  ///
+  /// @return     The number of bytes released.
+  size_t EnforceBudget();
+
+ private:
+  struct Source {
+    std::string name;
+    GetBytesCallback get_bytes;
+    TrimCallback trim;
+  };
+
+  std::vector<Source> sources_;
+  size_t budget_bytes_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceMemoryRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RESOURCE_MEMORY_REGISTRY_H_
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/resource_memory_registry.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A cache whose size can be trimmed in steps of |granularity| bytes.
+struct FakeCache {
+  size_t bytes;
+  size_t granularity;
+  int trim_count = 0;
+
+  void AddTo(ResourceMemoryRegistry& registry, std::string name) {
+    registry.AddSource(
+        std::move(name), [this]() { return bytes; },
+        [this](size_t bytes_to_free) {
+          trim_count++;
+          size_t steps = (bytes_to_free + granularity - 1) / granularity;
+          size_t released = std::min(bytes, steps * granularity);
+          bytes -= released;
+          return released;
+        });
+  }
+};
+
+}  // namespace
+
+TEST(ResourceMemoryRegistryTest, ReportsUsageInOrder) {
+  ResourceMemoryRegistry registry;
+  FakeCache first{.bytes = 100, .granularity = 1};
+  first.AddTo(registry, "first");
+  registry.AddSource("second", []() -> size_t { return 20; });
+
+  auto usage = registry.GetUsage();
+  ASSERT_EQ(usage.size(), 2u);
+  EXPECT_EQ(usage[0].name, "first");
+  EXPECT_EQ(usage[0].bytes, 100u);
+  EXPECT_EQ(usage[1].name, "second");
+  EXPECT_EQ(usage[1].bytes, 20u);
+  EXPECT_EQ(registry.GetTotalBytes(), 120u);
+}
+
+TEST(ResourceMemoryRegistryTest, DoesNothingWithoutBudget) {
+  ResourceMemoryRegistry registry;
+  FakeCache cache{.bytes = 100, .granularity = 1};
+  cache.AddTo(registry, "cache");
+
+  EXPECT_EQ(registry.EnforceBudget(), 0u);
+  EXPECT_EQ(cache.trim_count, 0);
+
+  registry.SetBudgetBytes(100);
+  EXPECT_EQ(registry.EnforceBudget(), 0u);
+  EXPECT_EQ(cache.trim_count, 0);
+}
+
+TEST(ResourceMemoryRegistryTest, TrimsSourcesInOrderUntilWithinBudget) {
+  ResourceMemoryRegistry registry;
+  FakeCache first{.bytes = 30, .granularity = 1};
+  FakeCache second{.bytes = 100, .granularity = 40};
+  FakeCache third{.bytes = 100, .granularity = 1};
+  first.AddTo(registry, "first");
+  registry.AddSource("untrimmable", []() -> size_t { return 50; });
+  second.AddTo(registry, "second");
+  third.AddTo(registry, "third");
+
+  // 280 bytes against a budget of 200.
+  registry.SetBudgetBytes(200);
+  EXPECT_EQ(registry.EnforceBudget(), 110u);
+  EXPECT_EQ(first.bytes, 0u);
+  EXPECT_EQ(second.bytes, 20u);
+  EXPECT_EQ(third.bytes, 100u);
+  EXPECT_EQ(third.trim_count, 0);
+  EXPECT_EQ(registry.GetTotalBytes(), 170u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -214,6 +214,50 @@ class SymbolMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(SymbolMapping);
 };
 
+//------------------------------------------------------------------------------
+/// @return     The size of the pages the address ranges below are made up of.
+///
+size_t GetMappingPageSize();
+
+//------------------------------------------------------------------------------
+/// @brief      Asks the OS to start reading the pages of an address range into
+///             memory ahead of their first access, so that the access does
+///             not fault on storage. The range is widened to page boundaries.
+///
+/// @return     Whether the OS accepted the advice.
+///
+bool PrefetchMappingRange(const uint8_t* start, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Asks the OS to back the whole huge pages within an address
+///             range with transparent huge pages. This is only supported on
+///             Linux and Android. File backed ranges are only collapsed into
+///             huge pages by kernels built with READ_ONLY_THP_FOR_FS.
+///
+/// @return     Whether the OS accepted the advice.
+///
+bool AdviseHugePages(const uint8_t* start, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Reports which pages of an address range are resident. The range
+///             is widened to page boundaries.
+///
+/// @return     One entry per page, or an empty vector if residency can not be
+///             queried on this platform.
+///
+std::vector<bool> GetResidentPages(const uint8_t* start, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Finds the loaded segment of the executable or a shared library
+///             that contains an address. This gives an upper bound for the
+///             size of a symbol resolved by a |SymbolMapping|, which is not
+///             known otherwise. This is only supported on Linux and Android.
+///
+/// @return     The number of bytes from the address to the end of its
+///             segment, or zero if it can not be determined.
+///
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address);
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_MAPPING_H_
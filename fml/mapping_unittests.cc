@@ -67,4 +67,34 @@ TEST(MallocMapping, CopySizeZero) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(MappingPages, ResidencyIsReportedPerPage) {
+  const size_t page_size = GetMappingPageSize();
+  std::vector<uint8_t> buffer(page_size * 5, 1);
+  const auto* page = reinterpret_cast<const uint8_t*>(
+      (reinterpret_cast<uintptr_t>(buffer.data()) + page_size - 1) &
+      ~(page_size - 1));
+  // Starting one byte into a page, the range touches three pages.
+  auto pages = GetResidentPages(page + 1, page_size * 2);
+#if defined(FML_OS_WIN) || defined(OS_FUCHSIA)
+  ASSERT_TRUE(pages.empty());
+#else
+  ASSERT_EQ(pages.size(), 3u);
+  for (bool resident : pages) {
+    // All pages of the buffer were written to.
+    ASSERT_TRUE(resident);
+  }
+#endif  // defined(FML_OS_WIN) || defined(OS_FUCHSIA)
+  ASSERT_TRUE(GetResidentPages(nullptr, 0).empty());
+}
+
+TEST(MappingPages, LoadedSegmentsContainTheirSymbols) {
+  static const uint8_t kSymbol[64] = {1};
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID) || defined(FML_OS_OHOS)
+  ASSERT_GE(GetLoadedSegmentSizeFrom(kSymbol), sizeof(kSymbol));
+#else
+  ASSERT_EQ(GetLoadedSegmentSizeFrom(kSymbol), 0u);
+#endif
+  ASSERT_EQ(GetLoadedSegmentSizeFrom(nullptr), 0u);
+}
+
 }  // namespace fml
@@ -10,11 +10,17 @@
 #include <unistd.h>
 
 #include <type_traits>
+#include <utility>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/unique_fd.h"
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID) || defined(FML_OS_OHOS)
+#include <link.h>
+#define FML_HAS_DL_ITERATE_PHDR 1
+#endif
+
 namespace fml {
 
 static int ToPosixProtectionFlags(
@@ -107,4 +113,105 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+size_t GetMappingPageSize() {
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+// Widens a range to the page boundaries madvise and mincore require.
+static std::pair<uint8_t*, size_t> AlignToPages(const uint8_t* start,
+                                                size_t size) {
+  const auto page_size = GetMappingPageSize();
+  const auto begin = reinterpret_cast<uintptr_t>(start) & ~(page_size - 1);
+  const auto end = (reinterpret_cast<uintptr_t>(start) + size + page_size - 1) &
+                   ~(page_size - 1);
+  return {reinterpret_cast<uint8_t*>(begin), end - begin};
+}
+
+bool PrefetchMappingRange(const uint8_t* start, size_t size) {
+#if defined(OS_FUCHSIA)
+  return false;
+#else
+  if (start == nullptr || size == 0) {
+    return false;
+  }
+  auto [aligned_start, aligned_size] = AlignToPages(start, size);
+  return ::madvise(aligned_start, aligned_size, MADV_WILLNEED) == 0;
+#endif  // defined(OS_FUCHSIA)
+}
+
+bool AdviseHugePages(const uint8_t* start, size_t size) {
+#if defined(MADV_HUGEPAGE) && !defined(OS_FUCHSIA)
+  // Only whole huge pages can be collapsed, so the range is narrowed rather
+  // than widened.
+  constexpr uintptr_t kHugePageSize = 2 * 1024 * 1024;
+  const auto begin = (reinterpret_cast<uintptr_t>(start) + kHugePageSize - 1) &
+                     ~(kHugePageSize - 1);
+  const auto end =
+      (reinterpret_cast<uintptr_t>(start) + size) & ~(kHugePageSize - 1);
+  if (start == nullptr || end <= begin) {
+    return false;
+  }
+  return ::madvise(reinterpret_cast<void*>(begin), end - begin,
+                   MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif  // defined(MADV_HUGEPAGE) && !defined(OS_FUCHSIA)
+}
+
+std::vector<bool> GetResidentPages(const uint8_t* start, size_t size) {
+#if defined(OS_FUCHSIA)
+  return {};
+#else
+  if (start == nullptr || size == 0) {
+    return {};
+  }
+  auto [aligned_start, aligned_size] = AlignToPages(start, size);
+#if defined(FML_OS_MACOSX)
+  using ResidencyEntry = char;
+#else
+  using ResidencyEntry = unsigned char;
+#endif  // defined(FML_OS_MACOSX)
+  std::vector<ResidencyEntry> residency(aligned_size / GetMappingPageSize());
+  if (::mincore(aligned_start, aligned_size, residency.data()) != 0) {
+    return {};
+  }
+  std::vector<bool> resident_pages(residency.size());
+  for (size_t i = 0; i < residency.size(); i++) {
+    resident_pages[i] = residency[i] & 1;
+  }
+  return resident_pages;
+#endif  // defined(OS_FUCHSIA)
+}
+
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address) {
+#if defined(FML_HAS_DL_ITERATE_PHDR)
+  struct Search {
+    uintptr_t address;
+    size_t size;
+  } search = {reinterpret_cast<uintptr_t>(address), 0};
+  ::dl_iterate_phdr(
+      [](struct dl_phdr_info* info, size_t, void* data) -> int {
+        auto* search = static_cast<Search*>(data);
+        for (size_t i = 0; i < info->dlpi_phnum; i++) {
+          const auto& header = info->dlpi_phdr[i];
+          if (header.p_type != PT_LOAD) {
+            continue;
+          }
+          const uintptr_t begin = info->dlpi_addr + header.p_vaddr;
+          const uintptr_t end = begin + header.p_memsz;
+          if (search->address >= begin && search->address < end) {
+            search->size = end - search->address;
+            return 1;
+          }
+        }
+        return 0;
+      },
+      &search);
+  return search.size;
+#else
+  return 0;
+#endif  // defined(FML_HAS_DL_ITERATE_PHDR)
+}
+
 }  // namespace fml
@@ -123,4 +123,27 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+size_t GetMappingPageSize() {
+  SYSTEM_INFO system_info = {};
+  ::GetSystemInfo(&system_info);
+  return system_info.dwPageSize;
+}
+
+bool PrefetchMappingRange(const uint8_t* start, size_t size) {
+  // PrefetchVirtualMemory is not available on all supported versions.
+  return false;
+}
+
+bool AdviseHugePages(const uint8_t* start, size_t size) {
+  return false;
+}
+
+std::vector<bool> GetResidentPages(const uint8_t* start, size_t size) {
+  return {};
+}
+
+size_t GetLoadedSegmentSizeFrom(const uint8_t* address) {
+  return 0;
+}
+
 }  // namespace fml
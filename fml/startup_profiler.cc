@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/startup_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace fml {
+
+static void WriteJSONString(std::ostringstream& stream, std::string_view str) {
+  stream << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          stream << escaped;
+        } else {
+          stream << c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+StartupProfiler::ScopedSpan::ScopedSpan(const char* name,
+                                        std::string_view detail)
+    : name_(name) {
+  if (StartupProfiler::GetInstance().IsRecording()) {
+    detail_ = detail;
+    start_ = TimePoint::Now();
+  }
+}
+
+StartupProfiler::ScopedSpan::~ScopedSpan() {
+  if (start_ == TimePoint()) {
+    return;
+  }
+  StartupProfiler::GetInstance().AddSpan(name_, detail_, start_,
+                                         TimePoint::Now());
+}
+
+StartupProfiler& StartupProfiler::GetInstance() {
+  static StartupProfiler* instance = new StartupProfiler();
+  return *instance;
+}
+
+StartupProfiler::StartupProfiler() : recording_(true) {}
+
+StartupProfiler::~StartupProfiler() = default;
+
+bool StartupProfiler::IsRecording() const {
+  return recording_.load(std::memory_order_relaxed);
+}
+
+void StartupProfiler::AddSpan(const char* name,
+                              std::string_view detail,
+                              TimePoint start,
+                              TimePoint end) {
+  if (!IsRecording()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  const bool merge = ++span_counts_[name] > kMaxSpansPerName;
+  if (merge) {
+    auto merged = merged_span_indices_.find(name);
+    if (merged != merged_span_indices_.end()) {
+      Span& span = spans_[merged->second];
+      span.start = std::min(span.start, start);
+      span.end = std::max(span.end, end);
+      span.merged_spans++;
+      return;
+    }
+  }
+  if (spans_.size() >= kMaxSpans) {
+    return;
+  }
+  auto thread_index = thread_indices_
+                          .emplace(std::this_thread::get_id(),
+                                   thread_indices_.size())
+                          .first->second;
+  if (merge) {
+    merged_span_indices_[name] = spans_.size();
+  }
+  spans_.push_back(Span{
+      .name = name,
+      .detail = merge ? std::string() : std::string(detail),
+      .start = start,
+      .end = end,
+      .thread_index = thread_index,
+      .merged_spans = merge ? 1u : 0u,
+  });
+}
+
+void StartupProfiler::Finish() {
+  recording_ = false;
+}
+
+void StartupProfiler::Reset() {
+  std::scoped_lock lock(mutex_);
+  spans_.clear();
+  thread_indices_.clear();
+  span_counts_.clear();
+  merged_span_indices_.clear();
+  recording_ = true;
+}
+
+std::vector<StartupProfiler::Span> StartupProfiler::GetSpans() const {
+  std::scoped_lock lock(mutex_);
+  return spans_;
+}
+
+std::string StartupProfiler::ToChromeTraceJSON() const {
+  auto spans = GetSpans();
+  std::ostringstream stream;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i = 0; i < spans.size(); i++) {
+    const auto& span = spans[i];
+    if (i > 0) {
+      stream << ',';
+    }
+    stream << "{\"name\":";
+    WriteJSONString(stream, span.name);
+    stream << ",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+           << span.thread_index
+           << ",\"ts\":" << span.start.ToEpochDelta().ToMicroseconds()
+           << ",\"dur\":" << (span.end - span.start).ToMicroseconds();
+    if (!span.detail.empty()) {
+      stream << ",\"args\":{\"detail\":";
+      WriteJSONString(stream, span.detail);
+      stream << '}';
+    } else if (span.merged_spans > 0) {
+      stream << ",\"args\":{\"mergedSpans\":" << span.merged_spans << '}';
+    }
+    stream << '}';
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+}  // namespace fml
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_STARTUP_PROFILER_H_
+#define FLUTTER_FML_STARTUP_PROFILER_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Records spans of the steps on the critical path of engine
+///             startup into a bounded in-memory buffer, so that the time to
+///             the first frame can be broken down without the timeline being
+///             enabled before the process launched.
+///
+///             Recording starts when the process launches and stops when
+///             |Finish| is called, which the rasterizer does once it has drawn
+///             its first frame. Afterwards, recording a span only costs an
+///             atomic load.
+///
+class StartupProfiler {
+ public:
+  /// The maximum number of spans that are kept. Spans recorded after the
+  /// buffer is full are dropped.
+  static constexpr size_t kMaxSpans = 256;
+
+  /// The maximum number of spans with the same name that are kept apart.
+  /// Later spans with that name are merged into a single span, so that steps
+  /// that run many times, such as loading assets, can't fill the buffer before
+  /// the first frame is drawn.
+  static constexpr size_t kMaxSpansPerName = 32;
+
+  struct Span {
+    /// The name of the step. It must have static storage duration.
+    const char* name = nullptr;
+    /// Optional details on the step, such as the name of a loaded asset.
+    std::string detail;
+    TimePoint start;
+    TimePoint end;
+    /// A small number identifying the thread the step ran on, in the order
+    /// the threads first recorded a span.
+    size_t thread_index = 0;
+    /// The number of spans merged into this one, or 0 if it was recorded as
+    /// is. A merged span has no detail, and covers the time from the
+    /// earliest start to the latest end of the spans it merges.
+    size_t merged_spans = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the span its lifetime covers.
+  ///
+  class ScopedSpan {
+   public:
+    explicit ScopedSpan(const char* name, std::string_view detail = {});
+
+    ~ScopedSpan();
+
+   private:
+    const char* name_;
+    std::string detail_;
+    TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedSpan);
+  };
+
+  static StartupProfiler& GetInstance();
+
+  StartupProfiler();
+
+  ~StartupProfiler();
+
+  bool IsRecording() const;
+
+  void AddSpan(const char* name,
+               std::string_view detail,
+               TimePoint start,
+               TimePoint end);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording. Spans recorded so far are kept.
+  ///
+  void Finish();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all spans and starts recording again.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @return     The recorded spans, in the order they ended.
+  ///
+  std::vector<Span> GetSpans() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Formats the recorded spans as complete events in the Chrome
+  ///             trace event format, which chrome://tracing and Perfetto can
+  ///             load.
+  ///
+  /// @see        https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+  ///
+  std::string ToChromeTraceJSON() const;
+
+ private:
+  std::atomic_bool recording_;
+  mutable std::mutex mutex_;
+  std::vector<Span> spans_;
+  std::map<std::thread::id, size_t> thread_indices_;
+  std::map<std::string_view, size_t> span_counts_;
+  // The index in |spans_| of the span that later spans of a name are merged
+  // into.
+  std::map<std::string_view, size_t> merged_span_indices_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupProfiler);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_STARTUP_PROFILER_H_
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/startup_profiler.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+static TimePoint Micros(int64_t micros) {
+  return TimePoint::FromEpochDelta(TimeDelta::FromMicroseconds(micros));
+}
+
+TEST(StartupProfilerTest, RecordsSpansUntilFinished) {
+  StartupProfiler profiler;
+  ASSERT_TRUE(profiler.IsRecording());
+  profiler.AddSpan("DartVM", {}, Micros(10), Micros(30));
+  profiler.Finish();
+  ASSERT_FALSE(profiler.IsRecording());
+  profiler.AddSpan("Rasterizer::Draw", {}, Micros(40), Micros(50));
+
+  auto spans = profiler.GetSpans();
+  ASSERT_EQ(spans.size(), 1u);
+  ASSERT_STREQ(spans[0].name, "DartVM");
+  ASSERT_EQ((spans[0].end - spans[0].start).ToMicroseconds(), 20);
+
+  profiler.Reset();
+  ASSERT_TRUE(profiler.IsRecording());
+  ASSERT_TRUE(profiler.GetSpans().empty());
+}
+
+TEST(StartupProfilerTest, DropsSpansBeyondTheBuffer) {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < StartupProfiler::kMaxSpans + 10; i++) {
+    names.push_back("Step" + std::to_string(i));
+  }
+  StartupProfiler profiler;
+  for (size_t i = 0; i < names.size(); i++) {
+    profiler.AddSpan(names[i].c_str(), {}, Micros(i), Micros(i + 1));
+  }
+  ASSERT_EQ(profiler.GetSpans().size(), StartupProfiler::kMaxSpans);
+}
+
+TEST(StartupProfilerTest, MergesRepeatedSpansToKeepRoomForMilestones) {
+  StartupProfiler profiler;
+  const size_t asset_count = StartupProfiler::kMaxSpans + 10;
+  for (size_t i = 0; i < asset_count; i++) {
+    profiler.AddSpan("AssetManager::GetAsMapping", "asset", Micros(i),
+                     Micros(i + 1));
+  }
+  profiler.AddSpan("Rasterizer::Draw (first frame)", {}, Micros(1000),
+                   Micros(1016));
+
+  auto spans = profiler.GetSpans();
+  ASSERT_EQ(spans.size(), StartupProfiler::kMaxSpansPerName + 2);
+  const auto& merged = spans[StartupProfiler::kMaxSpansPerName];
+  ASSERT_STREQ(merged.name, "AssetManager::GetAsMapping");
+  ASSERT_EQ(merged.merged_spans,
+            asset_count - StartupProfiler::kMaxSpansPerName);
+  ASSERT_TRUE(merged.detail.empty());
+  ASSERT_EQ(merged.start, Micros(StartupProfiler::kMaxSpansPerName));
+  ASSERT_EQ(merged.end, Micros(asset_count));
+  ASSERT_STREQ(spans.back().name, "Rasterizer::Draw (first frame)");
+}
+
+TEST(StartupProfilerTest, FormatsChromeTraceEvents) {
+  StartupProfiler profiler;
+  profiler.AddSpan("DartVM", {}, Micros(10), Micros(30));
+  profiler.AddSpan("AssetManager::GetAsMapping", "fonts/\"a\".ttf",
+                   Micros(35), Micros(36));
+  ASSERT_EQ(profiler.ToChromeTraceJSON(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+            "{\"name\":\"DartVM\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":0,"
+            "\"tid\":0,\"ts\":10,\"dur\":20},"
+            "{\"name\":\"AssetManager::GetAsMapping\",\"cat\":\"startup\","
+            "\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":35,\"dur\":1,"
+            "\"args\":{\"detail\":\"fonts/\\\"a\\\".ttf\"}}]}");
+}
+
+TEST(StartupProfilerTest, ScopedSpansRecordIntoTheProcessProfiler) {
+  auto& profiler = StartupProfiler::GetInstance();
+  profiler.Reset();
+  { StartupProfiler::ScopedSpan span("RuntimeController::LaunchRootIsolate"); }
+  profiler.Finish();
+  { StartupProfiler::ScopedSpan span("DartSnapshot"); }
+
+  auto spans = profiler.GetSpans();
+  ASSERT_EQ(spans.size(), 1u);
+  ASSERT_STREQ(spans[0].name, "RuntimeController::LaunchRootIsolate");
+  ASSERT_GE(spans[0].end, spans[0].start);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -4,7 +4,6 @@
 
 #include "impeller/blobcat/blob_library.h"
 
-#include <array>
 #include <string>
 #include <utility>
 
@@ -25,6 +24,24 @@ constexpr BlobShaderType ToShaderType(fb::Stage stage) {
   FML_UNREACHABLE();
 }
 
+constexpr fb::Stage ToStage(BlobShaderType type) {
+  switch (type) {
+    case BlobShaderType::kVertex:
+      return fb::Stage::kVertex;
+    case BlobShaderType::kFragment:
+      return fb::Stage::kFragment;
+    case BlobShaderType::kCompute:
+      return fb::Stage::kCompute;
+  }
+  FML_UNREACHABLE();
+}
+
+static std::string_view GetName(const fb::Blob* blob) {
+  const auto* name = blob->name();
+  return name ? std::string_view{name->c_str(), name->size()}
+              : std::string_view{};
+}
+
 BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     : payload_(std::move(payload)) {
   if (!payload_ || payload_->GetMapping() == nullptr) {
@@ -37,25 +54,11 @@ BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     return;
   }
 
-  auto blob_library = fb::GetBlobLibrary(payload_->GetMapping());
-  if (!blob_library) {
+  library_ = fb::GetBlobLibrary(payload_->GetMapping());
+  if (!library_) {
     return;
   }
 
-  if (auto items = blob_library->items()) {
-    for (auto i = items->begin(), end = items->end(); i != end; i++) {
-      BlobKey key;
-      key.name = i->name()->str();
-      key.type = ToShaderType(i->stage());
-      blobs_[key] = std::make_shared<fml::NonOwnedMapping>(
-          i->mapping()->Data(), i->mapping()->size(),
-          [payload = payload_](auto, auto) {
-            // The pointers are into the base payload. Instead of copying the
-            // data, just hold onto the payload.
-          });
-    }
-  }
-
   is_valid_ = true;
 }
 
@@ -68,16 +71,65 @@ bool BlobLibrary::IsValid() const {
 }
 
 size_t BlobLibrary::GetShaderCount() const {
-  return blobs_.size();
+  if (!IsValid() || !library_->items()) {
+    return 0u;
+  }
+  return library_->items()->size();
 }
 
-std::shared_ptr<fml::Mapping> BlobLibrary::GetMapping(BlobShaderType type,
-                                                      std::string name) const {
-  BlobKey key;
-  key.type = type;
-  key.name = std::move(name);
-  auto found = blobs_.find(key);
-  return found == blobs_.end() ? nullptr : found->second;
+static std::shared_ptr<fml::Mapping> CreateBlobMapping(
+    const std::shared_ptr<fml::Mapping>& payload,
+    const fb::Blob* blob) {
+  if (!blob->mapping()) {
+    return nullptr;
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      blob->mapping()->Data(), blob->mapping()->size(),
+      [payload](auto, auto) {
+        // The pointers are into the base payload. Instead of copying the
+        // data, just hold onto the payload.
+      });
+}
+
+std::shared_ptr<fml::Mapping> BlobLibrary::GetMapping(
+    BlobShaderType type,
+    std::string_view name) const {
+  if (!IsValid() || !library_->items()) {
+    return nullptr;
+  }
+  const auto* items = library_->items();
+  const auto stage = ToStage(type);
+
+  if (!library_->sorted()) {
+    for (auto i = items->begin(), end = items->end(); i != end; i++) {
+      if (i->stage() == stage && GetName(*i) == name) {
+        return CreateBlobMapping(payload_, *i);
+      }
+    }
+    return nullptr;
+  }
+
+  // Binary search the sorted blobs in place.
+  size_t low = 0u;
+  size_t high = items->size();
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const auto* blob = items->Get(middle);
+    const auto blob_stage = blob->stage();
+    if (blob_stage < stage || (blob_stage == stage && GetName(blob) < name)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == items->size()) {
+    return nullptr;
+  }
+  const auto* found = items->Get(low);
+  if (found->stage() != stage || GetName(found) != name) {
+    return nullptr;
+  }
+  return CreateBlobMapping(payload_, found);
 }
 
 size_t BlobLibrary::IterateAllBlobs(
@@ -85,13 +137,15 @@ size_t BlobLibrary::IterateAllBlobs(
                              const std::string& name,
                              const std::shared_ptr<fml::Mapping>& mapping)>&
         callback) const {
-  if (!IsValid() || !callback) {
+  if (!IsValid() || !callback || !library_->items()) {
     return 0u;
   }
   size_t count = 0u;
-  for (const auto& blob : blobs_) {
+  const auto* items = library_->items();
+  for (auto i = items->begin(), end = items->end(); i != end; i++) {
     count++;
-    if (!callback(blob.first.type, blob.first.name, blob.second)) {
+    if (!callback(ToShaderType(i->stage()), std::string{GetName(*i)},
+                  CreateBlobMapping(payload_, *i))) {
       break;
     }
   }
@@ -4,9 +4,11 @@
 
 #include "impeller/blobcat/blob_writer.h"
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <optional>
+#include <tuple>
 
 #include "impeller/blobcat/blob_flatbuffers.h"
 
@@ -96,8 +98,20 @@ constexpr fb::Stage ToStage(BlobShaderType type) {
 }
 
 std::shared_ptr<fml::Mapping> BlobWriter::CreateMapping() const {
+  // Sort the blobs so that libraries can look them up without building an
+  // index first.
+  auto blob_descriptions = blob_descriptions_;
+  std::stable_sort(blob_descriptions.begin(), blob_descriptions.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     const auto lhs_stage = ToStage(lhs.type);
+                     const auto rhs_stage = ToStage(rhs.type);
+                     return std::tie(lhs_stage, lhs.name) <
+                            std::tie(rhs_stage, rhs.name);
+                   });
+
   fb::BlobLibraryT blobs;
-  for (const auto& blob_description : blob_descriptions_) {
+  blobs.sorted = true;
+  for (const auto& blob_description : blob_descriptions) {
     auto mapping = blob_description.mapping;
     if (!mapping) {
       return nullptr;
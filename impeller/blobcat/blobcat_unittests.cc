@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
@@ -53,5 +55,44 @@ TEST(BlobTest, CanReadAndWriteBlobs) {
   ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "World");
 }
 
+TEST(BlobTest, BlobsAreSortedForLookupsInPlace) {
+  BlobWriter writer;
+  const std::vector<std::string> names = {"Zeta", "Alpha", "Mu", "Beta",
+                                          "Omega", "Kappa", "Delta"};
+  for (const auto& name : names) {
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, name,
+                               CreateMappingFromString(name + " frag")));
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, name,
+                               CreateMappingFromString(name + " vert")));
+  }
+
+  BlobLibrary library(writer.CreateMapping());
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), names.size() * 2);
+
+  for (const auto& name : names) {
+    auto frag = library.GetMapping(BlobShaderType::kFragment, name);
+    ASSERT_NE(frag, nullptr);
+    ASSERT_EQ(CreateStringFromMapping(*frag), name + " frag");
+    auto vert = library.GetMapping(BlobShaderType::kVertex, name);
+    ASSERT_NE(vert, nullptr);
+    ASSERT_EQ(CreateStringFromMapping(*vert), name + " vert");
+  }
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kCompute, "Alpha"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Aleph"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Zz"), nullptr);
+
+  // Iteration visits the blobs in lookup order.
+  std::vector<std::string> iterated;
+  library.IterateAllBlobs([&](auto type, const auto& name, const auto&) {
+    if (type == BlobShaderType::kVertex) {
+      iterated.push_back(name);
+    }
+    return true;
+  });
+  ASSERT_TRUE(std::is_sorted(iterated.begin(), iterated.end()));
+  ASSERT_EQ(iterated.size(), names.size());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,409 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/compilation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "impeller/compiler/compiler.h"
+#include "impeller/compiler/source_options.h"
+#include "impeller/compiler/types.h"
+#include "impeller/compiler/utilities.h"
+
+namespace impeller {
+namespace compiler {
+
+static constexpr const char* kSPIRVOutput = "spirv";
+static constexpr const char* kSLOutput = "sl";
+static constexpr const char* kReflectionJSONOutput = "reflection-json";
+static constexpr const char* kReflectionHeaderOutput = "reflection-header";
+static constexpr const char* kReflectionCCOutput = "reflection-cc";
+
+// Sets the file access mode of the file at path 'p' to 0644.
+static bool SetPermissiveAccess(const std::filesystem::path& p,
+                                std::ostream& errors) {
+  auto permissions =
+      std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
+      std::filesystem::perms::group_read | std::filesystem::perms::others_read;
+  std::error_code error;
+  std::filesystem::permissions(p, permissions, error);
+  if (error) {
+    errors << "Failed to set access on file '" << p
+           << "': " << error.message() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static SourceOptions CreateSourceOptions(const Switches& switches) {
+  SourceOptions options;
+  options.target_platform = switches.target_platform;
+  options.source_language = switches.source_language;
+  if (switches.input_type == SourceType::kUnknown) {
+    options.type = SourceTypeFromFileName(switches.source_file_name);
+  } else {
+    options.type = switches.input_type;
+  }
+  options.working_directory = switches.working_directory;
+  options.file_name = switches.source_file_name;
+  options.include_dirs = switches.include_directories;
+  options.defines = switches.defines;
+  options.entry_point_name = EntryPointFunctionNameFromSourceName(
+      switches.source_file_name, options.type, options.source_language,
+      switches.entry_point);
+  options.json_format = switches.json_format;
+  options.remap_samplers = switches.remap_samplers;
+  options.gles_language_version = switches.gles_language_version;
+  return options;
+}
+
+static Reflector::Options CreateReflectorOptions(
+    const Switches& switches,
+    const SourceOptions& options) {
+  Reflector::Options reflector_options;
+  reflector_options.target_platform = switches.target_platform;
+  reflector_options.entry_point_name = options.entry_point_name;
+  reflector_options.shader_name =
+      InferShaderNameFromPath(switches.source_file_name);
+  reflector_options.header_file_name = Utf8FromPath(
+      std::filesystem::path{switches.reflection_header_name}.filename());
+  return reflector_options;
+}
+
+/// Describes every option of an invocation that affects the contents of its
+/// outputs. Output paths only matter where they are embedded in the outputs.
+static std::string DescribeInvocation(
+    const Switches& switches,
+    const SourceOptions& options,
+    const Reflector::Options& reflector_options) {
+  std::stringstream stream;
+  stream << "target_platform=" << static_cast<int>(options.target_platform)
+         << "\ntype=" << static_cast<int>(options.type)
+         << "\nsource_language=" << static_cast<int>(options.source_language)
+         << "\nentry_point=" << options.entry_point_name
+         << "\niplr=" << switches.iplr
+         << "\njson=" << options.json_format
+         << "\nremap_samplers=" << options.remap_samplers
+         << "\ngles_language_version=" << options.gles_language_version
+         << "\nshader_name=" << reflector_options.shader_name
+         << "\nheader_file_name=" << reflector_options.header_file_name;
+  for (const auto& include_dir : options.include_dirs) {
+    stream << "\ninclude=" << include_dir.name;
+  }
+  for (const auto& define : options.defines) {
+    stream << "\ndefine=" << define;
+  }
+  return stream.str();
+}
+
+static std::map<std::string, std::string> GetRequestedOutputs(
+    const Switches& switches) {
+  std::map<std::string, std::string> outputs;
+  outputs[kSPIRVOutput] = switches.spirv_file_name;
+  if (TargetPlatformNeedsSL(switches.target_platform)) {
+    outputs[kSLOutput] = switches.sl_file_name;
+  }
+  if (TargetPlatformNeedsReflection(switches.target_platform)) {
+    if (!switches.reflection_json_name.empty()) {
+      outputs[kReflectionJSONOutput] = switches.reflection_json_name;
+    }
+    if (!switches.reflection_header_name.empty()) {
+      outputs[kReflectionHeaderOutput] = switches.reflection_header_name;
+    }
+    if (!switches.reflection_cc_name.empty()) {
+      outputs[kReflectionCCOutput] = switches.reflection_cc_name;
+    }
+  }
+  return outputs;
+}
+
+static std::optional<ShaderCache::Artifacts> Compile(
+    const Switches& switches,
+    const fml::Mapping& source_mapping,
+    const SourceOptions& options,
+    const Reflector::Options& reflector_options,
+    const SPIRVArtifact* spirv,
+    std::ostream& errors) {
+  // Generate SkSL if needed.
+  std::shared_ptr<fml::Mapping> sksl_mapping;
+  if (switches.iplr && TargetPlatformBundlesSkSL(switches.target_platform)) {
+    SourceOptions sksl_options = options;
+    sksl_options.target_platform = TargetPlatform::kSkSL;
+
+    Reflector::Options sksl_reflector_options = reflector_options;
+    sksl_reflector_options.target_platform = TargetPlatform::kSkSL;
+
+    Compiler sksl_compiler =
+        Compiler(source_mapping, sksl_options, sksl_reflector_options);
+    if (!sksl_compiler.IsValid()) {
+      errors << "Compilation to SkSL failed." << std::endl;
+      errors << sksl_compiler.GetErrorMessages() << std::endl;
+      return std::nullopt;
+    }
+    sksl_mapping = sksl_compiler.GetSLShaderSource();
+  }
+
+  auto compiler =
+      spirv ? std::make_unique<Compiler>(spirv->spirv,
+                                         spirv->included_file_names, options,
+                                         reflector_options)
+            : std::make_unique<Compiler>(source_mapping, options,
+                                         reflector_options);
+  if (!compiler->IsValid()) {
+    errors << "Compilation failed." << std::endl;
+    errors << compiler->GetErrorMessages() << std::endl;
+    return std::nullopt;
+  }
+
+  ShaderCache::Artifacts artifacts;
+  artifacts.included_file_names = compiler->GetIncludedFileNames();
+  artifacts.outputs[kSPIRVOutput] = compiler->GetSPIRVAssembly();
+
+  if (TargetPlatformNeedsSL(options.target_platform)) {
+    const bool is_runtime_stage_data = switches.iplr;
+    if (is_runtime_stage_data) {
+      auto reflector = compiler->GetReflector();
+      if (reflector == nullptr) {
+        errors << "Could not create reflector." << std::endl;
+        return std::nullopt;
+      }
+      auto stage_data = reflector->GetRuntimeStageData();
+      if (!stage_data) {
+        errors << "Runtime stage information was nil." << std::endl;
+        return std::nullopt;
+      }
+      if (sksl_mapping) {
+        stage_data->SetSkSLData(sksl_mapping);
+      }
+      auto stage_data_mapping = options.json_format
+                                    ? stage_data->CreateJsonMapping()
+                                    : stage_data->CreateMapping();
+      if (!stage_data_mapping) {
+        errors << "Runtime stage data could not be created." << std::endl;
+        return std::nullopt;
+      }
+      artifacts.outputs[kSLOutput] = std::move(stage_data_mapping);
+    } else {
+      artifacts.outputs[kSLOutput] = compiler->GetSLShaderSource();
+    }
+  }
+
+  if (TargetPlatformNeedsReflection(options.target_platform)) {
+    const auto* reflector = compiler->GetReflector();
+    if (!switches.reflection_json_name.empty()) {
+      artifacts.outputs[kReflectionJSONOutput] =
+          reflector->GetReflectionJSON();
+    }
+    if (!switches.reflection_header_name.empty()) {
+      artifacts.outputs[kReflectionHeaderOutput] =
+          reflector->GetReflectionHeader();
+    }
+    if (!switches.reflection_cc_name.empty()) {
+      artifacts.outputs[kReflectionCCOutput] = reflector->GetReflectionCC();
+    }
+  }
+
+  return artifacts;
+}
+
+static bool WriteOutputs(const Switches& switches,
+                         const ShaderCache::Artifacts& artifacts,
+                         std::ostream& errors) {
+  for (const auto& [output, file_name] : GetRequestedOutputs(switches)) {
+    auto found = artifacts.outputs.find(output);
+    if (found == artifacts.outputs.end() || !found->second) {
+      errors << "Could not generate " << output << " output." << std::endl;
+      return false;
+    }
+    auto path = std::filesystem::absolute(std::filesystem::current_path() /
+                                          file_name.c_str());
+    if (!fml::WriteAtomically(*switches.working_directory,
+                              Utf8FromPath(path).c_str(), *found->second)) {
+      errors << "Could not write " << output << " to " << file_name
+             << std::endl;
+      return false;
+    }
+    // Tools that consume the runtime stage data expect the access mode to be
+    // 0644.
+    if (output == kSLOutput && switches.iplr &&
+        !SetPermissiveAccess(path, errors)) {
+      return false;
+    }
+  }
+
+  if (!switches.depfile_path.empty()) {
+    std::string result_file;
+    switch (switches.target_platform) {
+      case TargetPlatform::kMetalDesktop:
+      case TargetPlatform::kMetalIOS:
+      case TargetPlatform::kOpenGLES:
+      case TargetPlatform::kOpenGLDesktop:
+      case TargetPlatform::kRuntimeStageMetal:
+      case TargetPlatform::kRuntimeStageGLES:
+      case TargetPlatform::kSkSL:
+      case TargetPlatform::kVulkan:
+        result_file = switches.sl_file_name;
+        break;
+      case TargetPlatform::kUnknown:
+        result_file = switches.spirv_file_name;
+        break;
+    }
+    auto depfile_path = std::filesystem::absolute(
+        std::filesystem::current_path() / switches.depfile_path.c_str());
+    if (!fml::WriteAtomically(
+            *switches.working_directory, Utf8FromPath(depfile_path).c_str(),
+            *Compiler::CreateDepfileContents({result_file},
+                                             artifacts.included_file_names,
+                                             switches.source_file_name))) {
+      errors << "Could not write depfile to " << switches.depfile_path
+             << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CompileShader(const Switches& switches,
+                   std::ostream& errors,
+                   const ShaderCache* cache,
+                   const SPIRVArtifact* spirv,
+                   SPIRVArtifact* out_spirv) {
+  auto source_file_mapping =
+      fml::FileMapping::CreateReadOnly(switches.source_file_name);
+  if (!source_file_mapping) {
+    errors << "Could not open input file." << std::endl;
+    return false;
+  }
+
+  const auto options = CreateSourceOptions(switches);
+  const auto reflector_options = CreateReflectorOptions(switches, options);
+  const auto description =
+      DescribeInvocation(switches, options, reflector_options);
+
+  std::optional<ShaderCache::Artifacts> artifacts;
+  if (cache) {
+    std::vector<std::string> output_names;
+    for (const auto& output : GetRequestedOutputs(switches)) {
+      output_names.push_back(output.first);
+    }
+    artifacts =
+        cache->Load(switches.source_file_name, description, output_names);
+  }
+
+  const bool cache_hit = artifacts.has_value();
+  if (!cache_hit) {
+    artifacts = Compile(switches, *source_file_mapping, options,
+                        reflector_options, spirv, errors);
+    if (!artifacts.has_value()) {
+      return false;
+    }
+  }
+
+  if (!WriteOutputs(switches, *artifacts, errors)) {
+    return false;
+  }
+
+  // A cache that can't be written to only costs time on the next build.
+  if (cache && !cache_hit) {
+    cache->Store(switches.source_file_name, description, *artifacts);
+  }
+
+  if (out_spirv) {
+    out_spirv->spirv = artifacts->outputs[kSPIRVOutput];
+    out_spirv->included_file_names = artifacts->included_file_names;
+  }
+  return true;
+}
+
+/// Whether two invocations compile the same source to the same SPIRV.
+static bool InvocationsShareSPIRV(const Switches& a, const Switches& b) {
+  if (a.source_file_name != b.source_file_name ||
+      a.input_type != b.input_type ||
+      a.source_language != b.source_language ||
+      a.entry_point != b.entry_point || a.defines != b.defines ||
+      a.include_directories.size() != b.include_directories.size() ||
+      !TargetPlatformsShareSPIRV(a.target_platform, b.target_platform)) {
+    return false;
+  }
+  for (size_t i = 0; i < a.include_directories.size(); i++) {
+    if (a.include_directories[i].name != b.include_directories[i].name) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompileShaders(const std::vector<Switches>& jobs,
+                    std::ostream& errors,
+                    const ShaderCache* cache,
+                    size_t concurrency) {
+  // Group invocations that can share SPIRV. Each group is compiled in order
+  // on a single worker.
+  std::vector<std::vector<const Switches*>> groups;
+  for (const auto& job : jobs) {
+    auto group = std::find_if(
+        groups.begin(), groups.end(), [&job](const auto& candidate) {
+          return InvocationsShareSPIRV(*candidate.front(), job);
+        });
+    if (group == groups.end()) {
+      groups.push_back({&job});
+    } else {
+      group->push_back(&job);
+    }
+  }
+
+  std::mutex errors_mutex;
+  std::atomic_bool success = true;
+  auto compile_group = [&](const std::vector<const Switches*>& group) {
+    std::optional<SPIRVArtifact> spirv;
+    for (const auto* job : group) {
+      std::stringstream job_errors;
+      SPIRVArtifact out_spirv;
+      if (!CompileShader(*job, job_errors, cache,
+                         spirv.has_value() ? &spirv.value() : nullptr,
+                         &out_spirv)) {
+        success = false;
+        std::scoped_lock lock(errors_mutex);
+        errors << job->source_file_name << ": " << job_errors.str();
+        continue;
+      }
+      if (!spirv.has_value()) {
+        spirv = std::move(out_spirv);
+      }
+    }
+  };
+
+  concurrency = std::min(concurrency, groups.size());
+  if (concurrency <= 1) {
+    for (const auto& group : groups) {
+      compile_group(group);
+    }
+    return success;
+  }
+
+  auto loop = fml::ConcurrentMessageLoop::Create(concurrency);
+  auto runner = loop->GetTaskRunner();
+  fml::CountDownLatch latch(groups.size());
+  for (const auto& group : groups) {
+    runner->PostTask([&compile_group, &group, &latch]() {
+      compile_group(group);
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  return success;
+}
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/compiler/shader_cache.h"
+#include "impeller/compiler/switches.h"
+
+namespace impeller {
+namespace compiler {
+
+/// The SPIRV of a compiled shader and the files its source included.
+struct SPIRVArtifact {
+  std::shared_ptr<const fml::Mapping> spirv;
+  std::vector<std::string> included_file_names;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Compiles the shader described by the switches of a single
+///             impellerc invocation and writes every output they ask for.
+///
+/// @param[in]  switches   The switches. These must be valid.
+/// @param[out] errors     Where diagnostics are written.
+/// @param[in]  cache      An optional cache of the outputs of earlier
+///                        compilations.
+/// @param[in]  spirv      Optional SPIRV of the same source compiled for a
+///                        target platform that shares it. Compilation to SPIRV
+///                        is skipped if present.
+/// @param[out] out_spirv  Optional. Receives the SPIRV of this compilation.
+///
+/// @return     Whether the shader was compiled and all outputs were written.
+///
+bool CompileShader(const Switches& switches,
+                   std::ostream& errors,
+                   const ShaderCache* cache = nullptr,
+                   const SPIRVArtifact* spirv = nullptr,
+                   SPIRVArtifact* out_spirv = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      Compiles the shaders of several impellerc invocations in
+///             parallel.
+///
+///             Invocations that compile the same source for target platforms
+///             that share SPIRV run in order on the same worker, and all but
+///             the first reuse the SPIRV of the first.
+///
+/// @param[in]  jobs         The switches of the invocations. These must be
+///                          valid.
+/// @param[out] errors       Where diagnostics are written. The diagnostics of
+///                          an invocation are never interleaved with others.
+/// @param[in]  cache        An optional cache of the outputs of earlier
+///                          compilations.
+/// @param[in]  concurrency  The maximum number of shaders compiled at once.
+///
+/// @return     Whether every shader was compiled.
+///
+bool CompileShaders(const std::vector<Switches>& jobs,
+                    std::ostream& errors,
+                    const ShaderCache* cache,
+                    size_t concurrency);
+
+}  // namespace compiler
+}  // namespace impeller
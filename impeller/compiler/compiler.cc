@@ -435,14 +435,45 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
     included_file_names_ = std::move(included_file_names);
   }
 
-  if (!TargetPlatformNeedsSL(source_options.target_platform)) {
+  spirv_ = std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(spv_result_->cbegin()),
+      (spv_result_->cend() - spv_result_->cbegin()) * sizeof(uint32_t),
+      [result = spv_result_](auto, auto) {});
+
+  CompileSPIRVToSL(std::move(reflector_options));
+}
+
+Compiler::Compiler(std::shared_ptr<const fml::Mapping> spirv,
+                   std::vector<std::string> included_file_names,
+                   const SourceOptions& source_options,
+                   Reflector::Options reflector_options)
+    : options_(source_options),
+      spirv_(std::move(spirv)),
+      included_file_names_(std::move(included_file_names)) {
+  if (!spirv_ || spirv_->GetMapping() == nullptr ||
+      spirv_->GetSize() % sizeof(uint32_t) != 0) {
+    COMPILER_ERROR << "SPIRV was absent or malformed.";
+    return;
+  }
+
+  if (source_options.target_platform == TargetPlatform::kUnknown) {
+    COMPILER_ERROR << "Target platform not specified.";
+    return;
+  }
+
+  CompileSPIRVToSL(std::move(reflector_options));
+}
+
+void Compiler::CompileSPIRVToSL(Reflector::Options reflector_options) {
+  if (!TargetPlatformNeedsSL(options_.target_platform)) {
     is_valid_ = true;
     return;
   }
 
   // SL Generation.
-  spirv_cross::Parser parser(spv_result_->cbegin(),
-                             spv_result_->cend() - spv_result_->cbegin());
+  spirv_cross::Parser parser(
+      reinterpret_cast<const uint32_t*>(spirv_->GetMapping()),
+      spirv_->GetSize() / sizeof(uint32_t));
   // The parser and compiler must be run separately because the parser contains
   // meta information (like type member names) that are useful for reflection.
   parser.parse();
@@ -466,7 +497,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
   // If the target is Vulkan, our shading language is SPIRV which we already
   // have. If it isn't, we need to invoke the appropriate compiler to compile
   // the SPIRV to the target SL.
-  sl_mapping_ = source_options.target_platform == TargetPlatform::kVulkan
+  sl_mapping_ = options_.target_platform == TargetPlatform::kVulkan
                     ? GetSPIRVAssembly()
                     : sl_compilation_result;
 
@@ -492,16 +523,12 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
 Compiler::~Compiler() = default;
 
 std::unique_ptr<fml::Mapping> Compiler::GetSPIRVAssembly() const {
-  if (!spv_result_) {
+  if (!spirv_) {
     return nullptr;
   }
-  const auto data_length =
-      (spv_result_->cend() - spv_result_->cbegin()) *
-      sizeof(decltype(spv_result_)::element_type::element_type);
-
   return std::make_unique<fml::NonOwnedMapping>(
-      reinterpret_cast<const uint8_t*>(spv_result_->cbegin()), data_length,
-      [result = spv_result_](auto, auto) mutable { result.reset(); });
+      spirv_->GetMapping(), spirv_->GetSize(),
+      [spirv = spirv_](auto, auto) mutable { spirv.reset(); });
 }
 
 std::shared_ptr<fml::Mapping> Compiler::GetSLShaderSource() const {
@@ -540,17 +567,21 @@ static std::string JoinStrings(std::vector<std::string> items,
   return stream.str();
 }
 
-std::string Compiler::GetDependencyNames(const std::string& separator) const {
-  std::vector<std::string> dependencies = included_file_names_;
-  dependencies.push_back(options_.file_name);
-  return JoinStrings(dependencies, separator);
+std::unique_ptr<fml::Mapping> Compiler::CreateDepfileContents(
+    std::initializer_list<std::string> targets_names) const {
+  return CreateDepfileContents(targets_names, included_file_names_,
+                               options_.file_name);
 }
 
 std::unique_ptr<fml::Mapping> Compiler::CreateDepfileContents(
-    std::initializer_list<std::string> targets_names) const {
+    const std::vector<std::string>& targets_names,
+    const std::vector<std::string>& included_file_names,
+    const std::string& source_file_name) {
   // https://github.com/ninja-build/ninja/blob/master/src/depfile_parser.cc#L28
+  std::vector<std::string> dependency_names = included_file_names;
+  dependency_names.push_back(source_file_name);
   const auto targets = JoinStrings(targets_names, " ");
-  const auto dependencies = GetDependencyNames(" ");
+  const auto dependencies = JoinStrings(dependency_names, " ");
 
   std::stringstream stream;
   stream << targets << ": " << dependencies << "\n";
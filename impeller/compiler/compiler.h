@@ -27,6 +27,18 @@ class Compiler {
            const SourceOptions& options,
            Reflector::Options reflector_options);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a compiler that skips compilation to SPIRV and
+  ///             instead reuses the SPIRV of the same source compiled for a
+  ///             target platform that shares it.
+  ///
+  /// @see        `TargetPlatformsShareSPIRV`
+  ///
+  Compiler(std::shared_ptr<const fml::Mapping> spirv,
+           std::vector<std::string> included_file_names,
+           const SourceOptions& options,
+           Reflector::Options reflector_options);
+
   ~Compiler();
 
   bool IsValid() const;
@@ -42,11 +54,17 @@ class Compiler {
   std::unique_ptr<fml::Mapping> CreateDepfileContents(
       std::initializer_list<std::string> targets) const;
 
+  static std::unique_ptr<fml::Mapping> CreateDepfileContents(
+      const std::vector<std::string>& targets,
+      const std::vector<std::string>& included_file_names,
+      const std::string& source_file_name);
+
   const Reflector* GetReflector() const;
 
  private:
   SourceOptions options_;
   std::shared_ptr<shaderc::SpvCompilationResult> spv_result_;
+  std::shared_ptr<const fml::Mapping> spirv_;
   std::shared_ptr<fml::Mapping> sl_mapping_;
   std::stringstream error_stream_;
   std::unique_ptr<Reflector> reflector_;
@@ -55,7 +73,7 @@ class Compiler {
 
   std::string GetSourcePrefix() const;
 
-  std::string GetDependencyNames(const std::string& separator) const;
+  void CompileSPIRVToSL(Reflector::Options reflector_options);
 
   void SetBindingBase(shaderc::CompileOptions& compiler_opts) const;
 
@@ -2,244 +2,108 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
-#include <system_error>
+#include <thread>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
-#include "impeller/base/strings.h"
-#include "impeller/compiler/compiler.h"
-#include "impeller/compiler/source_options.h"
+#include "flutter/fml/paths.h"
+#include "impeller/compiler/compilation.h"
+#include "impeller/compiler/shader_cache.h"
 #include "impeller/compiler/switches.h"
-#include "impeller/compiler/types.h"
-#include "impeller/compiler/utilities.h"
-#include "third_party/shaderc/libshaderc/include/shaderc/shaderc.hpp"
 
 namespace impeller {
 namespace compiler {
 
-// Sets the file access mode of the file at path 'p' to 0644.
-static bool SetPermissiveAccess(const std::filesystem::path& p) {
-  auto permissions =
-      std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
-      std::filesystem::perms::group_read | std::filesystem::perms::others_read;
-  std::error_code error;
-  std::filesystem::permissions(p, permissions, error);
-  if (error) {
-    std::cerr << "Failed to set access on file '" << p
-              << "': " << error.message() << std::endl;
-    return false;
+// Entries are keyed by the contents of this executable so that rebuilding the
+// compiler never reuses outputs of the previous build.
+static std::unique_ptr<ShaderCache> CreateShaderCache(
+    const std::string& directory) {
+  auto executable_path = fml::paths::GetExecutablePath();
+  if (!executable_path.first) {
+    std::cerr << "Could not find the compiler executable." << std::endl;
+    return nullptr;
   }
-  return true;
-}
-
-bool Main(const fml::CommandLine& command_line) {
-  fml::InstallCrashHandler();
-  if (command_line.HasOption("help")) {
-    Switches::PrintHelp(std::cout);
-    return true;
+  auto executable = fml::FileMapping::CreateReadOnly(executable_path.second);
+  if (!executable) {
+    std::cerr << "Could not read the compiler executable." << std::endl;
+    return nullptr;
   }
-
-  Switches switches(command_line);
-  if (!switches.AreValid(std::cerr)) {
-    std::cerr << "Invalid flags specified." << std::endl;
-    Switches::PrintHelp(std::cerr);
-    return false;
+  auto cache = std::make_unique<ShaderCache>(
+      directory, ShaderCache::ComputeDigest(*executable));
+  if (!cache->IsValid()) {
+    std::cerr << "Could not open cache directory " << directory << std::endl;
+    return nullptr;
   }
+  return cache;
+}
 
-  auto source_file_mapping =
-      fml::FileMapping::CreateReadOnly(switches.source_file_name);
-  if (!source_file_mapping) {
-    std::cerr << "Could not open input file." << std::endl;
+static bool RunBatch(const std::string& batch_file_name,
+                     const fml::CommandLine& command_line,
+                     const ShaderCache* cache) {
+  auto batch = fml::FileMapping::CreateReadOnly(batch_file_name);
+  if (!batch) {
+    std::cerr << "Could not open batch file." << std::endl;
     return false;
   }
 
-  SourceOptions options;
-  options.target_platform = switches.target_platform;
-  options.source_language = switches.source_language;
-  if (switches.input_type == SourceType::kUnknown) {
-    options.type = SourceTypeFromFileName(switches.source_file_name);
-  } else {
-    options.type = switches.input_type;
+  auto jobs = Switches::ParseBatch(*batch, std::cerr);
+  if (!jobs.has_value()) {
+    Switches::PrintHelp(std::cerr);
+    return false;
   }
-  options.working_directory = switches.working_directory;
-  options.file_name = switches.source_file_name;
-  options.include_dirs = switches.include_directories;
-  options.defines = switches.defines;
-  options.entry_point_name = EntryPointFunctionNameFromSourceName(
-      switches.source_file_name, options.type, options.source_language,
-      switches.entry_point);
-  options.json_format = switches.json_format;
-  options.remap_samplers = switches.remap_samplers;
-  options.gles_language_version = switches.gles_language_version;
-
-  Reflector::Options reflector_options;
-  reflector_options.target_platform = switches.target_platform;
-  reflector_options.entry_point_name = options.entry_point_name;
-  reflector_options.shader_name =
-      InferShaderNameFromPath(switches.source_file_name);
-  reflector_options.header_file_name = Utf8FromPath(
-      std::filesystem::path{switches.reflection_header_name}.filename());
 
-  // Generate SkSL if needed.
-  std::shared_ptr<fml::Mapping> sksl_mapping;
-  if (switches.iplr && TargetPlatformBundlesSkSL(switches.target_platform)) {
-    SourceOptions sksl_options = options;
-    sksl_options.target_platform = TargetPlatform::kSkSL;
-
-    Reflector::Options sksl_reflector_options = reflector_options;
-    sksl_reflector_options.target_platform = TargetPlatform::kSkSL;
-
-    Compiler sksl_compiler =
-        Compiler(*source_file_mapping, sksl_options, sksl_reflector_options);
-    if (!sksl_compiler.IsValid()) {
-      std::cerr << "Compilation to SkSL failed." << std::endl;
-      std::cerr << sksl_compiler.GetErrorMessages() << std::endl;
+  size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+  std::string jobs_option;
+  if (command_line.GetOptionValue("jobs", &jobs_option)) {
+    const char* jobs_end = jobs_option.data() + jobs_option.size();
+    auto [parsed_end, error] =
+        std::from_chars(jobs_option.data(), jobs_end, concurrency);
+    if (error != std::errc() || parsed_end != jobs_end || concurrency == 0) {
+      std::cerr << "The number of jobs must be a positive integer."
+                << std::endl;
+      Switches::PrintHelp(std::cerr);
       return false;
     }
-    sksl_mapping = sksl_compiler.GetSLShaderSource();
   }
 
-  Compiler compiler(*source_file_mapping, options, reflector_options);
-  if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
-    return false;
-  }
+  return CompileShaders(jobs.value(), std::cerr, cache, concurrency);
+}
 
-  auto spriv_file_name = std::filesystem::absolute(
-      std::filesystem::current_path() / switches.spirv_file_name);
-  if (!fml::WriteAtomically(*switches.working_directory,
-                            Utf8FromPath(spriv_file_name).c_str(),
-                            *compiler.GetSPIRVAssembly())) {
-    std::cerr << "Could not write file to " << switches.spirv_file_name
-              << std::endl;
-    return false;
+bool Main(const fml::CommandLine& command_line) {
+  fml::InstallCrashHandler();
+  if (command_line.HasOption("help")) {
+    Switches::PrintHelp(std::cout);
+    return true;
   }
 
-  if (TargetPlatformNeedsSL(options.target_platform)) {
-    auto sl_file_name = std::filesystem::absolute(
-        std::filesystem::current_path() / switches.sl_file_name);
-    const bool is_runtime_stage_data = switches.iplr;
-    if (is_runtime_stage_data) {
-      auto reflector = compiler.GetReflector();
-      if (reflector == nullptr) {
-        std::cerr << "Could not create reflector." << std::endl;
-        return false;
-      }
-      auto stage_data = reflector->GetRuntimeStageData();
-      if (!stage_data) {
-        std::cerr << "Runtime stage information was nil." << std::endl;
-        return false;
-      }
-      if (sksl_mapping) {
-        stage_data->SetSkSLData(sksl_mapping);
-      }
-      auto stage_data_mapping = options.json_format
-                                    ? stage_data->CreateJsonMapping()
-                                    : stage_data->CreateMapping();
-      if (!stage_data_mapping) {
-        std::cerr << "Runtime stage data could not be created." << std::endl;
-        return false;
-      }
-      if (!fml::WriteAtomically(*switches.working_directory,         //
-                                Utf8FromPath(sl_file_name).c_str(),  //
-                                *stage_data_mapping                  //
-                                )) {
-        std::cerr << "Could not write file to " << switches.sl_file_name
-                  << std::endl;
-        return false;
-      }
-      // Tools that consume the runtime stage data expect the access mode to
-      // be 0644.
-      if (!SetPermissiveAccess(sl_file_name)) {
-        return false;
-      }
-    } else {
-      if (!fml::WriteAtomically(*switches.working_directory,
-                                Utf8FromPath(sl_file_name).c_str(),
-                                *compiler.GetSLShaderSource())) {
-        std::cerr << "Could not write file to " << switches.sl_file_name
-                  << std::endl;
-        return false;
-      }
+  std::unique_ptr<ShaderCache> cache;
+  std::string cache_directory;
+  if (command_line.GetOptionValue("cache-dir", &cache_directory)) {
+    cache = CreateShaderCache(cache_directory);
+    if (!cache) {
+      return false;
     }
   }
 
-  if (TargetPlatformNeedsReflection(options.target_platform)) {
-    if (!switches.reflection_json_name.empty()) {
-      auto reflection_json_name = std::filesystem::absolute(
-          std::filesystem::current_path() / switches.reflection_json_name);
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_json_name).c_str(),
-              *compiler.GetReflector()->GetReflectionJSON())) {
-        std::cerr << "Could not write reflection json to "
-                  << switches.reflection_json_name << std::endl;
-        return false;
-      }
-    }
-
-    if (!switches.reflection_header_name.empty()) {
-      auto reflection_header_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_header_name.c_str());
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_header_name).c_str(),
-              *compiler.GetReflector()->GetReflectionHeader())) {
-        std::cerr << "Could not write reflection header to "
-                  << switches.reflection_header_name << std::endl;
-        return false;
-      }
-    }
-
-    if (!switches.reflection_cc_name.empty()) {
-      auto reflection_cc_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_cc_name.c_str());
-      if (!fml::WriteAtomically(*switches.working_directory,
-                                Utf8FromPath(reflection_cc_name).c_str(),
-                                *compiler.GetReflector()->GetReflectionCC())) {
-        std::cerr << "Could not write reflection CC to "
-                  << switches.reflection_cc_name << std::endl;
-        return false;
-      }
-    }
+  std::string batch_file_name;
+  if (command_line.GetOptionValue("batch", &batch_file_name)) {
+    return RunBatch(batch_file_name, command_line, cache.get());
   }
 
-  if (!switches.depfile_path.empty()) {
-    std::string result_file;
-    switch (switches.target_platform) {
-      case TargetPlatform::kMetalDesktop:
-      case TargetPlatform::kMetalIOS:
-      case TargetPlatform::kOpenGLES:
-      case TargetPlatform::kOpenGLDesktop:
-      case TargetPlatform::kRuntimeStageMetal:
-      case TargetPlatform::kRuntimeStageGLES:
-      case TargetPlatform::kSkSL:
-      case TargetPlatform::kVulkan:
-        result_file = switches.sl_file_name;
-        break;
-      case TargetPlatform::kUnknown:
-        result_file = switches.spirv_file_name;
-        break;
-    }
-    auto depfile_path = std::filesystem::absolute(
-        std::filesystem::current_path() / switches.depfile_path.c_str());
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(depfile_path).c_str(),
-                              *compiler.CreateDepfileContents({result_file}))) {
-      std::cerr << "Could not write depfile to " << switches.depfile_path
-                << std::endl;
-      return false;
-    }
+  Switches switches(command_line);
+  if (!switches.AreValid(std::cerr)) {
+    std::cerr << "Invalid flags specified." << std::endl;
+    Switches::PrintHelp(std::cerr);
+    return false;
   }
 
-  return true;
+  return CompileShader(switches, std::cerr, cache.get());
 }
 
 }  // namespace compiler
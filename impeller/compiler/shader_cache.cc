@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/shader_cache.h"
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+
+#include "flutter/fml/file.h"
+#include "impeller/base/allocation.h"
+#include "openssl/sha.h"
+
+namespace impeller {
+namespace compiler {
+
+static constexpr std::string_view kManifestHeader = "impellerc-manifest\n";
+
+namespace {
+
+// Accumulates a SHA-256 digest.
+class Hasher {
+ public:
+  Hasher() { SHA256_Init(&context_); }
+
+  void Update(const uint8_t* data, size_t size) {
+    SHA256_Update(&context_, data, size);
+  }
+
+  // Strings are length prefixed so that adjacent strings can't be confused
+  // for one another.
+  void Update(std::string_view string) {
+    uint64_t size = string.size();
+    Update(reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+    Update(reinterpret_cast<const uint8_t*>(string.data()), string.size());
+  }
+
+  std::string GetHexDigest() const {
+    SHA256_CTX context = context_;
+    std::array<uint8_t, SHA256_DIGEST_LENGTH> digest;
+    SHA256_Final(digest.data(), &context);
+
+    std::stringstream stream;
+    stream << std::hex << std::setfill('0');
+    for (auto byte : digest) {
+      stream << std::setw(2) << static_cast<int>(byte);
+    }
+    return stream.str();
+  }
+
+ private:
+  SHA256_CTX context_;
+};
+
+}  // namespace
+
+static void UpdateWithMapping(Hasher& hasher, const fml::Mapping& mapping) {
+  hasher.Update(std::string_view(
+      reinterpret_cast<const char*>(mapping.GetMapping()), mapping.GetSize()));
+}
+
+ShaderCache::ShaderCache(const std::string& directory, std::string tool_key)
+    : directory_(fml::OpenDirectory(directory.c_str(),
+                                    true,  // create if necessary
+                                    fml::FilePermission::kReadWrite)),
+      tool_key_(std::move(tool_key)) {}
+
+ShaderCache::~ShaderCache() = default;
+
+bool ShaderCache::IsValid() const {
+  return directory_.is_valid();
+}
+
+std::string ShaderCache::ComputeDigest(const fml::Mapping& mapping) {
+  Hasher hasher;
+  hasher.Update(mapping.GetMapping(), mapping.GetSize());
+  return hasher.GetHexDigest();
+}
+
+std::optional<std::string> ShaderCache::GetManifestKey(
+    const std::string& source_file_name,
+    const std::string& description) const {
+  auto source = fml::FileMapping::CreateReadOnly(source_file_name);
+  if (!source) {
+    return std::nullopt;
+  }
+  Hasher hasher;
+  hasher.Update(tool_key_);
+  hasher.Update(description);
+  UpdateWithMapping(hasher, *source);
+  return hasher.GetHexDigest();
+}
+
+std::optional<std::string> ShaderCache::GetEntryKey(
+    const std::string& manifest_key,
+    const std::vector<std::string>& included_file_names) const {
+  Hasher hasher;
+  hasher.Update(manifest_key);
+  for (const auto& included_file_name : included_file_names) {
+    auto included = fml::FileMapping::CreateReadOnly(included_file_name);
+    if (!included) {
+      return std::nullopt;
+    }
+    hasher.Update(included_file_name);
+    UpdateWithMapping(hasher, *included);
+  }
+  return hasher.GetHexDigest();
+}
+
+std::optional<ShaderCache::Artifacts> ShaderCache::Load(
+    const std::string& source_file_name,
+    const std::string& description,
+    const std::vector<std::string>& output_names) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+
+  auto manifest_key = GetManifestKey(source_file_name, description);
+  if (!manifest_key.has_value()) {
+    return std::nullopt;
+  }
+
+  auto manifest =
+      fml::FileMapping::CreateReadOnly(directory_, *manifest_key + ".manifest");
+  if (!manifest) {
+    return std::nullopt;
+  }
+  std::string_view manifest_contents(
+      reinterpret_cast<const char*>(manifest->GetMapping()),
+      manifest->GetSize());
+  if (manifest_contents.substr(0, kManifestHeader.size()) != kManifestHeader) {
+    return std::nullopt;
+  }
+  manifest_contents.remove_prefix(kManifestHeader.size());
+
+  Artifacts artifacts;
+  while (!manifest_contents.empty()) {
+    auto end = manifest_contents.find('\n');
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    artifacts.included_file_names.emplace_back(
+        manifest_contents.substr(0, end));
+    manifest_contents.remove_prefix(end + 1);
+  }
+
+  auto entry_key = GetEntryKey(*manifest_key, artifacts.included_file_names);
+  if (!entry_key.has_value()) {
+    return std::nullopt;
+  }
+
+  for (const auto& output_name : output_names) {
+    auto output = fml::FileMapping::CreateReadOnly(
+        directory_, *entry_key + "." + output_name);
+    if (!output) {
+      return std::nullopt;
+    }
+    artifacts.outputs[output_name] = std::move(output);
+  }
+  return artifacts;
+}
+
+bool ShaderCache::Store(const std::string& source_file_name,
+                        const std::string& description,
+                        const Artifacts& artifacts) const {
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto manifest_key = GetManifestKey(source_file_name, description);
+  if (!manifest_key.has_value()) {
+    return false;
+  }
+
+  auto entry_key = GetEntryKey(*manifest_key, artifacts.included_file_names);
+  if (!entry_key.has_value()) {
+    return false;
+  }
+
+  // Outputs are written before the manifest that leads to them so that
+  // readers never find a partial entry.
+  for (const auto& output : artifacts.outputs) {
+    if (!output.second ||
+        !fml::WriteAtomically(directory_,
+                              (*entry_key + "." + output.first).c_str(),
+                              *output.second)) {
+      return false;
+    }
+  }
+
+  std::string manifest(kManifestHeader);
+  for (const auto& included_file_name : artifacts.included_file_names) {
+    manifest += included_file_name + "\n";
+  }
+  return fml::WriteAtomically(directory_,
+                              (*manifest_key + ".manifest").c_str(),
+                              *CreateMappingWithString(std::move(manifest)));
+}
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      A content addressed, on-disk cache of the outputs of shader
+///             compilations.
+///
+///             Entries are found in two steps. The contents of the source
+///             file and a description of the invocation identify a manifest
+///             that lists the files the source included when it was last
+///             compiled. The outputs are then keyed by the contents of those
+///             includes, so editing any of them misses the cache without the
+///             need to preprocess the source again.
+///
+///             Entries are written atomically and are never modified, so
+///             several compilers may share a cache directory concurrently.
+///
+class ShaderCache {
+ public:
+  struct Artifacts {
+    /// The files included by the source, as reported by
+    /// `Compiler::GetIncludedFileNames`.
+    std::vector<std::string> included_file_names;
+    /// The outputs of the compilation, keyed by an identifier of their kind.
+    std::map<std::string, std::shared_ptr<const fml::Mapping>> outputs;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  directory  Where the entries are stored. Created if
+  ///                        necessary.
+  /// @param[in]  tool_key   Identifies the build of the compiler so that
+  ///                        entries written by a different build are never
+  ///                        used.
+  ///
+  ShaderCache(const std::string& directory, std::string tool_key);
+
+  ~ShaderCache();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finds the outputs of an earlier compilation of the source
+  ///             with the same description, source and include contents.
+  ///
+  /// @param[in]  source_file_name  The path to the source file.
+  /// @param[in]  description       Every option that affects the outputs.
+  /// @param[in]  output_names      The outputs that must all be present.
+  ///
+  std::optional<Artifacts> Load(
+      const std::string& source_file_name,
+      const std::string& description,
+      const std::vector<std::string>& output_names) const;
+
+  bool Store(const std::string& source_file_name,
+             const std::string& description,
+             const Artifacts& artifacts) const;
+
+  /// Returns the hex encoded SHA-256 digest of the contents of a mapping.
+  static std::string ComputeDigest(const fml::Mapping& mapping);
+
+ private:
+  fml::UniqueFD directory_;
+  const std::string tool_key_;
+
+  std::optional<std::string> GetManifestKey(
+      const std::string& source_file_name,
+      const std::string& description) const;
+
+  std::optional<std::string> GetEntryKey(
+      const std::string& manifest_key,
+      const std::vector<std::string>& included_file_names) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderCache);
+};
+
+}  // namespace compiler
+}  // namespace impeller
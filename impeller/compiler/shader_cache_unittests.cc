@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/shader_cache.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+class ShaderCacheTest : public ::testing::Test {
+ public:
+  ShaderCacheTest()
+      : cache_(fml::paths::JoinPaths({directory_.path(), "cache"}), "tool") {}
+
+  std::string WriteFile(const std::string& name, const std::string& contents) {
+    FML_CHECK(fml::WriteAtomically(directory_.fd(), name.c_str(),
+                                   fml::DataMapping(contents)));
+    return fml::paths::JoinPaths({directory_.path(), name});
+  }
+
+  const ShaderCache& GetCache() const { return cache_; }
+
+ private:
+  fml::ScopedTemporaryDirectory directory_;
+  ShaderCache cache_;
+};
+
+static std::string ToString(const std::shared_ptr<const fml::Mapping>& m) {
+  return std::string(reinterpret_cast<const char*>(m->GetMapping()),
+                     m->GetSize());
+}
+
+TEST_F(ShaderCacheTest, ReusesOutputsOfIdenticalCompilations) {
+  ASSERT_TRUE(GetCache().IsValid());
+  auto source = WriteFile("shader.frag", "void main() {}");
+  auto include = WriteFile("include.glsl", "// Included.");
+
+  ASSERT_FALSE(GetCache().Load(source, "options", {"sl"}).has_value());
+
+  ShaderCache::Artifacts artifacts;
+  artifacts.included_file_names = {include};
+  artifacts.outputs["sl"] = std::make_shared<fml::DataMapping>("compiled");
+  ASSERT_TRUE(GetCache().Store(source, "options", artifacts));
+
+  auto loaded = GetCache().Load(source, "options", {"sl"});
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded->included_file_names, artifacts.included_file_names);
+  ASSERT_EQ(ToString(loaded->outputs["sl"]), "compiled");
+
+  // Different options and outputs that weren't stored miss.
+  ASSERT_FALSE(GetCache().Load(source, "other", {"sl"}).has_value());
+  ASSERT_FALSE(GetCache().Load(source, "options", {"spirv"}).has_value());
+}
+
+TEST_F(ShaderCacheTest, ChangedSourcesAndIncludesMiss) {
+  auto source = WriteFile("shader.frag", "void main() {}");
+  auto include = WriteFile("include.glsl", "// Included.");
+
+  ShaderCache::Artifacts artifacts;
+  artifacts.included_file_names = {include};
+  artifacts.outputs["sl"] = std::make_shared<fml::DataMapping>("compiled");
+  ASSERT_TRUE(GetCache().Store(source, "options", artifacts));
+  ASSERT_TRUE(GetCache().Load(source, "options", {"sl"}).has_value());
+
+  WriteFile("include.glsl", "// Edited.");
+  ASSERT_FALSE(GetCache().Load(source, "options", {"sl"}).has_value());
+
+  WriteFile("include.glsl", "// Included.");
+  ASSERT_TRUE(GetCache().Load(source, "options", {"sl"}).has_value());
+
+  WriteFile("shader.frag", "void main() { }");
+  ASSERT_FALSE(GetCache().Load(source, "options", {"sl"}).has_value());
+}
+
+TEST(ShaderCacheDigestTest, DigestsDependOnContents) {
+  auto a = ShaderCache::ComputeDigest(fml::DataMapping("a"));
+  ASSERT_EQ(a.size(), 64u);
+  ASSERT_EQ(a, ShaderCache::ComputeDigest(fml::DataMapping("a")));
+  ASSERT_NE(a, ShaderCache::ComputeDigest(fml::DataMapping("b")));
+}
+
+TEST(ShaderCacheDigestTest, DigestsAreSHA256) {
+  ASSERT_EQ(
+      ShaderCache::ComputeDigest(fml::DataMapping("abc")),
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
@@ -8,6 +8,7 @@
 #include <cctype>
 #include <filesystem>
 #include <map>
+#include <sstream>
 
 #include "flutter/fml/file.h"
 #include "impeller/compiler/types.h"
@@ -74,6 +75,15 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --remap-samplers (force metal sampler index to match "
             "declared order)"
          << std::endl;
+  stream << "[optional] --cache-dir=<directory> (reuse outputs of identical "
+            "earlier compilations)"
+         << std::endl;
+  stream << "[optional] --batch=<batch_file> (compile one invocation per "
+            "line of the file in parallel instead)"
+         << std::endl;
+  stream << "[optional] --jobs=<number> (maximum number of shaders compiled "
+            "at once in batch mode)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -221,5 +231,32 @@ bool Switches::AreValid(std::ostream& explain) const {
   return valid;
 }
 
+std::optional<std::vector<Switches>> Switches::ParseBatch(
+    const fml::Mapping& batch,
+    std::ostream& explain) {
+  std::vector<Switches> result;
+  std::istringstream lines(std::string(
+      reinterpret_cast<const char*>(batch.GetMapping()), batch.GetSize()));
+  std::string line;
+  for (size_t line_number = 1; std::getline(lines, line); line_number++) {
+    std::istringstream words(line);
+    std::vector<std::string> args = {"impellerc"};
+    for (std::string word; words >> word;) {
+      args.emplace_back(std::move(word));
+    }
+    if (args.size() == 1 || args[1].front() == '#') {
+      continue;
+    }
+    Switches switches(fml::CommandLineFromIterators(args.begin(), args.end()));
+    if (!switches.AreValid(explain)) {
+      explain << "Invalid flags on line " << line_number << " of the batch."
+              << std::endl;
+      return std::nullopt;
+    }
+    result.emplace_back(std::move(switches));
+  }
+  return result;
+}
+
 }  // namespace compiler
 }  // namespace impeller
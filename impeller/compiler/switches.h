@@ -6,9 +6,12 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/unique_fd.h"
 #include "impeller/compiler/compiler.h"
 #include "impeller/compiler/include_dir.h"
@@ -46,6 +49,18 @@ struct Switches {
   bool AreValid(std::ostream& explain) const;
 
   static void PrintHelp(std::ostream& stream);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses the switches of the invocations in a batch file. Every
+  ///             line holds the whitespace separated flags of one invocation.
+  ///             Empty lines and lines that start with `#` are ignored.
+  ///
+  /// @return     The switches of every invocation, or nothing if any of them
+  ///             are invalid.
+  ///
+  static std::optional<std::vector<Switches>> ParseBatch(
+      const fml::Mapping& batch,
+      std::ostream& explain);
 };
 
 }  // namespace compiler
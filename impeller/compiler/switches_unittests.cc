@@ -69,6 +69,24 @@ TEST(SwitchesTest, EntryPointCanBeSetForHLSL) {
   ASSERT_EQ(switches.entry_point, "CustomEntryPoint");
 }
 
+TEST(SwitchesTest, CanParseBatches) {
+  fml::DataMapping batch(std::string(
+      "# Comments and empty lines are ignored.\n"
+      "\n"
+      "--opengl-desktop --input=a.vert --sl=a.glsl --spirv=a.spirv\n"
+      "  --metal-ios   --input=b.frag --sl=b.metal --spirv=b.spirv\n"));
+  auto jobs = Switches::ParseBatch(batch, std::cout);
+  ASSERT_TRUE(jobs.has_value());
+  ASSERT_EQ(jobs->size(), 2u);
+  ASSERT_EQ(jobs->at(0).target_platform, TargetPlatform::kOpenGLDesktop);
+  ASSERT_EQ(jobs->at(0).source_file_name, "a.vert");
+  ASSERT_EQ(jobs->at(1).target_platform, TargetPlatform::kMetalIOS);
+  ASSERT_EQ(jobs->at(1).sl_file_name, "b.metal");
+
+  fml::DataMapping invalid(std::string("--input=a.vert --spirv=a.spirv\n"));
+  ASSERT_FALSE(Switches::ParseBatch(invalid, std::cout).has_value());
+}
+
 }  // namespace testing
 }  // namespace compiler
 }  // namespace impeller
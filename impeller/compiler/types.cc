@@ -323,5 +323,32 @@ bool TargetPlatformBundlesSkSL(TargetPlatform platform) {
   FML_UNREACHABLE();
 }
 
+// Target platforms are grouped by the SPIRV target environment, version and
+// optimization level they compile with.
+static int TargetPlatformSPIRVGroup(TargetPlatform platform) {
+  switch (platform) {
+    case TargetPlatform::kUnknown:
+      return 0;
+    case TargetPlatform::kMetalDesktop:
+    case TargetPlatform::kMetalIOS:
+    case TargetPlatform::kOpenGLES:
+    case TargetPlatform::kOpenGLDesktop:
+      return 1;
+    case TargetPlatform::kVulkan:
+      return 2;
+    case TargetPlatform::kRuntimeStageMetal:
+    case TargetPlatform::kRuntimeStageGLES:
+      return 3;
+    case TargetPlatform::kSkSL:
+      return 4;
+  }
+  FML_UNREACHABLE();
+}
+
+bool TargetPlatformsShareSPIRV(TargetPlatform a, TargetPlatform b) {
+  return a != TargetPlatform::kUnknown &&
+         TargetPlatformSPIRVGroup(a) == TargetPlatformSPIRVGroup(b);
+}
+
 }  // namespace compiler
 }  // namespace impeller
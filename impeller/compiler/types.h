@@ -69,6 +69,11 @@ bool TargetPlatformNeedsReflection(TargetPlatform platform);
 
 bool TargetPlatformBundlesSkSL(TargetPlatform platform);
 
+/// Whether a shader compiled to SPIRV for one of the platforms can be reused
+/// for the other. This must be kept in sync with the SPIRV options used by
+/// the compiler.
+bool TargetPlatformsShareSPIRV(TargetPlatform a, TargetPlatform b);
+
 std::string ShaderCErrorToString(shaderc_compilation_status status);
 
 shaderc_shader_kind ToShaderCShaderKind(SourceType type);
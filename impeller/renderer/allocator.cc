@@ -14,6 +14,10 @@ Allocator::Allocator() = default;
 
 Allocator::~Allocator() = default;
 
+const UniqueID& Allocator::GetUniqueID() const {
+  return id_;
+}
+
 std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
     const uint8_t* buffer,
     size_t length) {
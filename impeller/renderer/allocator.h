@@ -8,6 +8,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "impeller/base/comparable.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
 #include "impeller/renderer/texture_descriptor.h"
 
@@ -45,6 +46,13 @@ class Allocator {
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
+  //------------------------------------------------------------------------------
+  /// @brief      Identifies this allocator. Unlike its address, the ID is never
+  ///             reused by another allocator, so it can be used to key device
+  ///             buffers that were created by this allocator.
+  ///
+  const UniqueID& GetUniqueID() const;
+
  protected:
   Allocator();
 
@@ -55,6 +63,8 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  const UniqueID id_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
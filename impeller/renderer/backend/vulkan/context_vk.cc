@@ -479,6 +479,16 @@ ContextVK::ContextVK(
     return;
   }
 
+  auto descriptor_pool_recycler =
+      std::make_shared<DescriptorPoolRecyclerVK>(device.value.get());
+
+  auto fence_waiter = std::make_shared<FenceWaiterVK>(device.value.get());
+
+  if (!fence_waiter->IsValid()) {
+    VALIDATION_LOG << "Could not create fence waiter.";
+    return;
+  }
+
   instance_ = std::move(instance.value);
   debug_messenger_ = std::move(debug_messenger);
   device_ = std::move(device.value);
@@ -487,6 +497,8 @@ ContextVK::ContextVK(
   sampler_library_ = std::move(sampler_library);
   pipeline_library_ = std::move(pipeline_library);
   work_queue_ = std::move(work_queue);
+  descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
+  fence_waiter_ = std::move(fence_waiter);
   graphics_queue_ =
       device_->getQueue(graphics_queue->family, graphics_queue->index);
   compute_queue_ =
@@ -589,7 +601,8 @@ bool ContextVK::SupportsOffscreenMSAA() const {
 }
 
 std::unique_ptr<DescriptorPoolVK> ContextVK::CreateDescriptorPool() const {
-  return std::make_unique<DescriptorPoolVK>(*device_);
+  return std::make_unique<DescriptorPoolVK>(*device_,
+                                            descriptor_pool_recycler_);
 }
 
 PixelFormat ContextVK::GetColorAttachmentPixelFormat() const {
@@ -608,4 +621,8 @@ std::unique_ptr<CommandPoolVK> ContextVK::CreateGraphicsCommandPool() const {
   return CommandPoolVK::Create(*device_, graphics_queue_idx_);
 }
 
+std::shared_ptr<FenceWaiterVK> ContextVK::GetFenceWaiter() const {
+  return fence_waiter_;
+}
+
 }  // namespace impeller
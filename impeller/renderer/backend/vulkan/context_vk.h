@@ -13,6 +13,7 @@
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/deletion_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_library_vk.h"
@@ -96,6 +97,8 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   std::unique_ptr<CommandPoolVK> CreateGraphicsCommandPool() const;
 
+  std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
+
  private:
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   vk::UniqueInstance instance_;
@@ -116,6 +119,9 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   std::unique_ptr<SwapchainVK> swapchain_;
   std::unique_ptr<SurfaceProducerVK> surface_producer_;
   std::shared_ptr<WorkQueue> work_queue_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  // Declared after the device so that it drains pending fences first.
+  std::shared_ptr<FenceWaiterVK> fence_waiter_;
   bool is_valid_ = false;
 
   ContextVK(
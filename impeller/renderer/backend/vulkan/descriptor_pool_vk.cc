@@ -4,50 +4,225 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
 #include "impeller/base/validation.h"
 #include "vulkan/vulkan_enums.hpp"
 
 namespace impeller {
 
-DescriptorPoolVK::DescriptorPoolVK(vk::Device device) {
-  constexpr size_t kPoolSize = 1024;
+// Each pool has room for this many descriptor sets, each of which may hold a
+// few uniform buffers and samplers.
+static constexpr uint32_t kDescriptorSetsPerPool = 256u;
+static constexpr uint32_t kDescriptorsPerSet = 4u;
+
+// Reclaimed pools beyond this count are destroyed instead of kept.
+static constexpr size_t kMaxRecycledPools = 16u;
+
+size_t DescriptorSetContentsVK::GetHash() const {
+  size_t hash = fml::HashCombine();
+  for (const auto& buffer : buffers) {
+    fml::HashCombineSeed(hash, buffer.binding,
+                         static_cast<VkBuffer>(buffer.info.buffer),
+                         buffer.info.offset, buffer.info.range);
+  }
+  for (const auto& image : images) {
+    fml::HashCombineSeed(hash, image.binding,
+                         static_cast<VkSampler>(image.info.sampler),
+                         static_cast<VkImageView>(image.info.imageView),
+                         static_cast<int>(image.info.imageLayout));
+  }
+  return hash;
+}
+
+bool DescriptorSetContentsVK::operator==(
+    const DescriptorSetContentsVK& other) const {
+  if (buffers.size() != other.buffers.size() ||
+      images.size() != other.images.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < buffers.size(); i++) {
+    if (buffers[i].binding != other.buffers[i].binding ||
+        buffers[i].info != other.buffers[i].info) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < images.size(); i++) {
+    if (images[i].binding != other.images[i].binding ||
+        images[i].info != other.images[i].info) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(vk::Device device)
+    : device_(device) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get() {
+  {
+    std::scoped_lock lock(recycled_mutex_);
+    if (!recycled_.empty()) {
+      auto pool = std::move(recycled_.back());
+      recycled_.pop_back();
+      return pool;
+    }
+  }
+  return Create();
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool pool) {
+  if (!pool) {
+    return;
+  }
+  // Resetting frees every set allocated from the pool at once.
+  device_.resetDescriptorPool(*pool);
+  std::scoped_lock lock(recycled_mutex_);
+  if (recycled_.size() < kMaxRecycledPools) {
+    recycled_.push_back(std::move(pool));
+  }
+}
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() const {
+  TRACE_EVENT0("impeller", "DescriptorPoolRecyclerVK::Create");
+  constexpr uint32_t kPoolSize = kDescriptorSetsPerPool * kDescriptorsPerSet;
 
   std::vector<vk::DescriptorPoolSize> pool_sizes = {
-      {vk::DescriptorType::eSampler, kPoolSize},
       {vk::DescriptorType::eCombinedImageSampler, kPoolSize},
-      {vk::DescriptorType::eSampledImage, kPoolSize},
-      {vk::DescriptorType::eStorageImage, kPoolSize},
-      {vk::DescriptorType::eUniformTexelBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageTexelBuffer, kPoolSize},
       {vk::DescriptorType::eUniformBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageBuffer, kPoolSize},
-      {vk::DescriptorType::eUniformBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eStorageBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eInputAttachment, kPoolSize},
   };
 
-  vk::DescriptorPoolCreateInfo pool_info = {
-      vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,  // flags
-      static_cast<uint32_t>(pool_sizes.size() * kPoolSize),  // max sets
-      static_cast<uint32_t>(pool_sizes.size()),              // pool sizes count
-      pool_sizes.data()                                      // pool sizes
-  };
+  // Sets are never freed individually, the whole pool is reset instead.
+  vk::DescriptorPoolCreateInfo pool_info;
+  pool_info.setMaxSets(kDescriptorSetsPerPool);
+  pool_info.setPoolSizes(pool_sizes);
 
-  auto res = device.createDescriptorPool(pool_info);
+  auto res = device_.createDescriptorPoolUnique(pool_info);
   if (res.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Unable to create a descriptor pool";
+    VALIDATION_LOG << "Unable to create a descriptor pool: "
+                   << vk::to_string(res.result);
+    return {};
+  }
+  return std::move(res.value);
+}
+
+size_t DescriptorPoolVK::CacheKey::Hash::operator()(
+    const CacheKey& key) const {
+  return fml::HashCombine(static_cast<VkDescriptorSetLayout>(key.layout),
+                          key.contents.GetHash());
+}
+
+bool DescriptorPoolVK::CacheKey::Equal::operator()(const CacheKey& lhs,
+                                                   const CacheKey& rhs) const {
+  return lhs.layout == rhs.layout && lhs.contents == rhs.contents;
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    vk::Device device,
+    std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_(device), recycler_(std::move(recycler)) {}
+
+DescriptorPoolVK::~DescriptorPoolVK() {
+  auto recycler = recycler_.lock();
+  if (!recycler) {
     return;
   }
+  for (auto& pool : pools_) {
+    recycler->Reclaim(std::move(pool));
+  }
+}
+
+std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
+    vk::DescriptorSetLayout layout,
+    const DescriptorSetContentsVK& contents) {
+  CacheKey key{layout, contents};
+  auto found = cache_.find(key);
+  if (found != cache_.end()) {
+    return found->second;
+  }
 
-  pool_ = res.value;
-  is_valid_ = true;
+  auto set = Allocate(layout);
+  if (!set.has_value()) {
+    return std::nullopt;
+  }
+  Write(set.value(), contents);
+  cache_.emplace(std::move(key), set.value());
+  return set;
 }
 
-vk::DescriptorPool DescriptorPoolVK::GetPool() {
-  return pool_;
+std::optional<vk::DescriptorSet> DescriptorPoolVK::Allocate(
+    vk::DescriptorSetLayout layout) {
+  vk::DescriptorSetAllocateInfo alloc_info;
+  alloc_info.setDescriptorSetCount(1u);
+  alloc_info.setPSetLayouts(&layout);
+
+  if (!pools_.empty()) {
+    alloc_info.setDescriptorPool(*pools_.back());
+    vk::DescriptorSet set;
+    auto res = device_.allocateDescriptorSets(&alloc_info, &set);
+    if (res == vk::Result::eSuccess) {
+      return set;
+    }
+    if (res != vk::Result::eErrorOutOfPoolMemory &&
+        res != vk::Result::eErrorFragmentedPool) {
+      VALIDATION_LOG << "Failed to allocate descriptor set: "
+                     << vk::to_string(res);
+      return std::nullopt;
+    }
+  }
+
+  // The current pool is full, chain a new one.
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return std::nullopt;
+  }
+  auto pool = recycler->Get();
+  if (!pool) {
+    return std::nullopt;
+  }
+  pools_.push_back(std::move(pool));
+
+  alloc_info.setDescriptorPool(*pools_.back());
+  vk::DescriptorSet set;
+  auto res = device_.allocateDescriptorSets(&alloc_info, &set);
+  if (res != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to allocate descriptor set: "
+                   << vk::to_string(res);
+    return std::nullopt;
+  }
+  return set;
 }
 
-DescriptorPoolVK::~DescriptorPoolVK() = default;
+void DescriptorPoolVK::Write(vk::DescriptorSet set,
+                             const DescriptorSetContentsVK& contents) const {
+  std::vector<vk::WriteDescriptorSet> writes;
+  writes.reserve(contents.buffers.size() + contents.images.size());
+  for (const auto& buffer : contents.buffers) {
+    vk::WriteDescriptorSet write;
+    write.setDstSet(set);
+    write.setDstBinding(buffer.binding);
+    write.setDescriptorCount(1);
+    write.setDescriptorType(vk::DescriptorType::eUniformBuffer);
+    write.setPBufferInfo(&buffer.info);
+    writes.push_back(write);
+  }
+  for (const auto& image : contents.images) {
+    vk::WriteDescriptorSet write;
+    write.setDstSet(set);
+    write.setDstBinding(image.binding);
+    write.setDescriptorCount(1);
+    write.setDescriptorType(vk::DescriptorType::eCombinedImageSampler);
+    write.setPImageInfo(&image.info);
+    writes.push_back(write);
+  }
+  if (!writes.empty()) {
+    device_.updateDescriptorSets(writes, nullptr);
+  }
+}
 
 }  // namespace impeller
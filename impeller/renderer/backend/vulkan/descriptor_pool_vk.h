@@ -5,6 +5,10 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -13,17 +17,114 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The resources written into a descriptor set. Draws that use the
+///             same layout and bind equal resources share a descriptor set.
+///
+struct DescriptorSetContentsVK {
+  struct BufferBinding {
+    uint32_t binding;
+    vk::DescriptorBufferInfo info;
+  };
+
+  struct ImageBinding {
+    uint32_t binding;
+    vk::DescriptorImageInfo info;
+  };
+
+  // Uniform buffers.
+  std::vector<BufferBinding> buffers;
+  // Combined image samplers.
+  std::vector<ImageBinding> images;
+
+  size_t GetHash() const;
+
+  bool operator==(const DescriptorSetContentsVK& other) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps descriptor pools that are no longer used by any command
+///             buffer so that later command buffers do not have to create
+///             their own. It is safe to reclaim pools from any thread.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  explicit DescriptorPoolRecyclerVK(vk::Device device);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return a previously reclaimed pool, or create a new one.
+  ///
+  vk::UniqueDescriptorPool Get();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reset a pool whose descriptor sets are no longer referenced by
+  ///             pending work and keep it for reuse.
+  ///
+  void Reclaim(vk::UniqueDescriptorPool pool);
+
+ private:
+  const vk::Device device_;
+  std::mutex recycled_mutex_;
+  std::vector<vk::UniqueDescriptorPool> recycled_;
+
+  vk::UniqueDescriptorPool Create() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Allocates the descriptor sets of a single command buffer.
+///
+///             Pools are chained as they fill up. Since the descriptor sets are
+///             only referenced by that command buffer, all of its pools are
+///             reset and handed back to the recycler at once when this object
+///             is destroyed after the command buffer's fence is signaled.
+///
 class DescriptorPoolVK {
  public:
-  explicit DescriptorPoolVK(vk::Device device);
+  DescriptorPoolVK(vk::Device device,
+                   std::weak_ptr<DescriptorPoolRecyclerVK> recycler);
 
   ~DescriptorPoolVK();
 
-  vk::DescriptorPool GetPool();
+  //----------------------------------------------------------------------------
+  /// @brief      Return a descriptor set with the given layout and contents.
+  ///             The set is written when it is first allocated and reused for
+  ///             later requests with the same layout and contents.
+  ///
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      vk::DescriptorSetLayout layout,
+      const DescriptorSetContentsVK& contents);
 
  private:
-  vk::DescriptorPool pool_;
-  bool is_valid_ = false;
+  struct CacheKey {
+    vk::DescriptorSetLayout layout;
+    DescriptorSetContentsVK contents;
+
+    struct Hash {
+      size_t operator()(const CacheKey& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const CacheKey& lhs, const CacheKey& rhs) const;
+    };
+  };
+
+  const vk::Device device_;
+  std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
+  std::vector<vk::UniqueDescriptorPool> pools_;
+  std::unordered_map<CacheKey,
+                     vk::DescriptorSet,
+                     CacheKey::Hash,
+                     CacheKey::Equal>
+      cache_;
+
+  std::optional<vk::DescriptorSet> Allocate(vk::DescriptorSetLayout layout);
+
+  void Write(vk::DescriptorSet set,
+             const DescriptorSetContentsVK& contents) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolVK);
 };
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+
+#include <chrono>
+#include <utility>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+// Fences added while the waiter is blocked are only picked up once a pending
+// fence is signaled or this much time passes.
+static constexpr std::chrono::nanoseconds kWaitTimeout =
+    std::chrono::milliseconds(100);
+
+FenceWaiterVK::FenceWaiterVK(vk::Device device) : device_(device) {
+  waiter_thread_ = std::make_unique<std::thread>([this]() { Main(); });
+  is_valid_ = true;
+}
+
+FenceWaiterVK::~FenceWaiterVK() {
+  Terminate();
+}
+
+void FenceWaiterVK::Terminate() {
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    terminate_ = true;
+  }
+  wait_set_cv_.notify_one();
+  if (waiter_thread_->joinable()) {
+    waiter_thread_->join();
+  }
+}
+
+bool FenceWaiterVK::IsValid() const {
+  return is_valid_;
+}
+
+bool FenceWaiterVK::AddFence(vk::UniqueFence& fence, FenceCallback callback) {
+  if (!IsValid() || !fence || !callback) {
+    return false;
+  }
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (terminate_) {
+      return false;
+    }
+    wait_set_.push_back(WaitEntry{std::move(fence), std::move(callback)});
+  }
+  wait_set_cv_.notify_one();
+  return true;
+}
+
+void FenceWaiterVK::Main() {
+  fml::Thread::SetCurrentThreadName(
+      fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
+
+  std::vector<vk::Fence> fences;
+  while (true) {
+    fences.clear();
+    {
+      std::unique_lock lock(wait_set_mutex_);
+      wait_set_cv_.wait(lock,
+                        [&]() { return !wait_set_.empty() || terminate_; });
+      // Pending fences are drained before the thread exits.
+      if (wait_set_.empty()) {
+        return;
+      }
+      for (const auto& entry : wait_set_) {
+        fences.push_back(*entry.fence);
+      }
+    }
+
+    vk::Result wait_result;
+    {
+      TRACE_EVENT0("impeller", "FenceWaiterVK::Wait");
+      wait_result = device_.waitForFences(fences, /*waitAll=*/false,
+                                          kWaitTimeout.count());
+    }
+    if (wait_result == vk::Result::eTimeout) {
+      continue;
+    }
+    if (wait_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to wait for fences: "
+                     << vk::to_string(wait_result);
+    }
+
+    std::vector<std::pair<WaitEntry, bool>> completed;
+    {
+      std::scoped_lock lock(wait_set_mutex_);
+      auto it = wait_set_.begin();
+      while (it != wait_set_.end()) {
+        // If the device failed, no fence will ever be signaled.
+        auto status = wait_result == vk::Result::eSuccess
+                          ? device_.getFenceStatus(*it->fence)
+                          : wait_result;
+        if (status == vk::Result::eNotReady) {
+          ++it;
+          continue;
+        }
+        completed.emplace_back(std::move(*it), status == vk::Result::eSuccess);
+        it = wait_set_.erase(it);
+      }
+    }
+
+    // Callbacks may release the last references to resources, so they are
+    // invoked without holding the lock.
+    for (auto& [entry, signaled] : completed) {
+      entry.callback(signaled);
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Waits for the fences of in-flight submissions on a dedicated
+///             thread and invokes their callbacks once they are signaled. This
+///             lets the thread that submitted the work continue without
+///             stalling on the GPU.
+///
+///             Callbacks are invoked on the waiter thread. When the waiter is
+///             terminated or destroyed, it waits for every fence that is
+///             still pending so that no callback is dropped.
+///
+class FenceWaiterVK {
+ public:
+  using FenceCallback = std::function<void(bool signaled)>;
+
+  explicit FenceWaiterVK(vk::Device device);
+
+  ~FenceWaiterVK();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Take ownership of a fence that has been submitted to a queue
+  ///             and invoke the callback once it is signaled. If the device
+  ///             fails while waiting, the callback is invoked with `false`.
+  ///
+  /// @return     Whether the fence was added. Only then is it moved out of
+  ///             `fence`. Otherwise, for example because the waiter is
+  ///             terminating, the caller must wait for the fence itself.
+  ///
+  bool AddFence(vk::UniqueFence& fence, FenceCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops accepting fences and waits for the pending ones.
+  ///
+  void Terminate();
+
+ private:
+  struct WaitEntry {
+    vk::UniqueFence fence;
+    FenceCallback callback;
+  };
+
+  const vk::Device device_;
+  std::unique_ptr<std::thread> waiter_thread_;
+  std::mutex wait_set_mutex_;
+  std::condition_variable wait_set_cv_;
+  std::vector<WaitEntry> wait_set_;
+  bool terminate_ = false;
+  bool is_valid_ = false;
+
+  void Main();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
+};
+
+}  // namespace impeller
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <chrono>
+#include <thread>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(FenceWaiterVKTest, InvokesCallbackOnceTheFenceIsSignaled) {
+  MockVulkanDevice device;
+  FenceWaiterVK waiter(device.GetDevice());
+  ASSERT_TRUE(waiter.IsValid());
+
+  auto fence = device.CreateFence();
+  auto raw_fence = *fence;
+  fml::AutoResetEvent latch;
+  bool result = false;
+  ASSERT_TRUE(waiter.AddFence(fence, [&](bool signaled) {
+    result = signaled;
+    latch.Signal();
+  }));
+  ASSERT_FALSE(fence);
+
+  device.SignalFence(raw_fence);
+  latch.Wait();
+  ASSERT_TRUE(result);
+}
+
+TEST(FenceWaiterVKTest, InvokesCallbackWithFalseWhenTheDeviceIsLost) {
+  MockVulkanDevice device;
+  FenceWaiterVK waiter(device.GetDevice());
+
+  fml::AutoResetEvent latch;
+  bool result = true;
+  auto fence = device.CreateFence();
+  ASSERT_TRUE(waiter.AddFence(fence, [&](bool signaled) {
+    result = signaled;
+    latch.Signal();
+  }));
+
+  device.LoseDevice();
+  latch.Wait();
+  ASSERT_FALSE(result);
+}
+
+TEST(FenceWaiterVKTest, TerminationWaitsForPendingFences) {
+  MockVulkanDevice device;
+  FenceWaiterVK waiter(device.GetDevice());
+
+  auto fence = device.CreateFence();
+  auto raw_fence = *fence;
+  bool invoked = false;
+  ASSERT_TRUE(
+      waiter.AddFence(fence, [&](bool signaled) { invoked = signaled; }));
+
+  std::thread signaler([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    device.SignalFence(raw_fence);
+  });
+  waiter.Terminate();
+  signaler.join();
+  ASSERT_TRUE(invoked);
+  ASSERT_EQ(device.GetLiveFenceCount(), 0u);
+}
+
+TEST(FenceWaiterVKTest, RejectedFencesAreLeftWithTheCaller) {
+  MockVulkanDevice device;
+  FenceWaiterVK waiter(device.GetDevice());
+
+  auto fence = device.CreateFence();
+  ASSERT_FALSE(waiter.AddFence(fence, nullptr));
+  ASSERT_TRUE(fence);
+
+  waiter.Terminate();
+  bool invoked = false;
+  ASSERT_FALSE(waiter.AddFence(fence, [&](bool) { invoked = true; }));
+  // The caller is still responsible for waiting on and destroying the fence.
+  ASSERT_TRUE(fence);
+  ASSERT_EQ(device.GetLiveFenceCount(), 1u);
+  fence.reset();
+  ASSERT_EQ(device.GetLiveFenceCount(), 0u);
+  ASSERT_FALSE(invoked);
+}
+
+}  // namespace testing
+}  // namespace impeller
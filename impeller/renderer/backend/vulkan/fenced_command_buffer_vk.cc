@@ -4,7 +4,9 @@
 
 #include "impeller/renderer/backend/vulkan/fenced_command_buffer_vk.h"
 
+#include <limits>
 #include <memory>
+#include <utility>
 
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/deletion_queue_vk.h"
@@ -28,14 +30,19 @@ static vk::CommandBuffer CreateCommandBuffer(vk::Device device,
   return res.value[0];
 }
 
-FencedCommandBufferVK::FencedCommandBufferVK(vk::Device device,
-                                             vk::Queue queue,
-                                             vk::CommandPool command_pool)
+FencedCommandBufferVK::FencedCommandBufferVK(
+    vk::Device device,
+    vk::Queue queue,
+    std::unique_ptr<CommandPoolVK> command_pool,
+    std::unique_ptr<DescriptorPoolVK> descriptor_pool,
+    std::weak_ptr<FenceWaiterVK> fence_waiter)
     : device_(device),
       queue_(queue),
-      command_pool_(command_pool),
+      command_pool_(std::move(command_pool)),
+      descriptor_pool_(std::move(descriptor_pool)),
+      fence_waiter_(std::move(fence_waiter)),
       deletion_queue_(std::make_unique<DeletionQueueVK>()) {
-  command_buffer_ = CreateCommandBuffer(device_, command_pool_);
+  command_buffer_ = CreateCommandBuffer(device_, command_pool_->Get());
 }
 
 vk::CommandBuffer FencedCommandBufferVK::Get() const {
@@ -43,7 +50,7 @@ vk::CommandBuffer FencedCommandBufferVK::Get() const {
 }
 
 vk::CommandBuffer FencedCommandBufferVK::GetSingleUseChild() {
-  auto child = CreateCommandBuffer(device_, command_pool_);
+  auto child = CreateCommandBuffer(device_, command_pool_->Get());
   children_.push_back(child);
   return child;
 }
@@ -54,15 +61,21 @@ FencedCommandBufferVK::~FencedCommandBufferVK() {
         << "FencedCommandBufferVK is being destroyed without being submitted.";
     children_.push_back(command_buffer_);
   }
-  device_.freeCommandBuffers(command_pool_, children_);
+  device_.freeCommandBuffers(command_pool_->Get(), children_);
 }
 
-bool FencedCommandBufferVK::Submit() {
+bool FencedCommandBufferVK::Submit(FenceWaiterVK::FenceCallback callback) {
   if (submitted_) {
     VALIDATION_LOG << "Command buffer already submitted.";
     return false;
   }
 
+  auto fence_waiter = fence_waiter_.lock();
+  if (!fence_waiter || !fence_waiter->IsValid()) {
+    VALIDATION_LOG << "Command buffer has no fence waiter.";
+    return false;
+  }
+
   children_.push_back(command_buffer_);
 
   auto fence_res = device_.createFenceUnique(vk::FenceCreateInfo());
@@ -81,21 +94,60 @@ bool FencedCommandBufferVK::Submit() {
     return false;
   }
 
-  auto wait = device_.waitForFences(fence.get(), true, UINT64_MAX);
-  if (wait != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to wait for fence: " << vk::to_string(wait);
-    return false;
+  submitted_ = true;
+
+  // The waiter holds a strong reference, so the command buffers and the pool
+  // they were allocated from outlive their execution.
+  FenceWaiterVK::FenceCallback on_completed =
+      [self = shared_from_this(),
+       callback = std::move(callback)](bool signaled) {
+        self->OnCompleted();
+        if (callback) {
+          callback(signaled);
+        }
+      };
+  if (fence_waiter->AddFence(fence, on_completed)) {
+    return true;
   }
 
+  // The waiter is terminating. The fence must not be destroyed, nor the
+  // command buffers freed, while the GPU may still be executing them.
+  auto wait_result = device_.waitForFences(
+      *fence, /*waitAll=*/true, std::numeric_limits<uint64_t>::max());
+  if (wait_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to wait for fence: "
+                   << vk::to_string(wait_result);
+  }
+  on_completed(wait_result == vk::Result::eSuccess);
+  return true;
+}
+
+void FencedCommandBufferVK::OnCompleted() {
   // cleanup all the resources held by the command buffer and its children.
   deletion_queue_->Flush();
-
-  submitted_ = true;
-  return true;
+  descriptor_pool_.reset();
+  tracked_buffers_.clear();
+  tracked_textures_.clear();
 }
 
 DeletionQueueVK* FencedCommandBufferVK::GetDeletionQueue() const {
   return deletion_queue_.get();
 }
 
+DescriptorPoolVK* FencedCommandBufferVK::GetDescriptorPool() const {
+  return descriptor_pool_.get();
+}
+
+void FencedCommandBufferVK::Track(std::shared_ptr<const DeviceBuffer> buffer) {
+  if (buffer) {
+    tracked_buffers_.push_back(std::move(buffer));
+  }
+}
+
+void FencedCommandBufferVK::Track(std::shared_ptr<const Texture> texture) {
+  if (texture) {
+    tracked_textures_.push_back(std::move(texture));
+  }
+}
+
 }  // namespace impeller
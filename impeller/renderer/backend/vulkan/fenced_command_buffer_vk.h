@@ -5,18 +5,27 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/deletion_queue_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/texture.h"
 
 namespace impeller {
 
-class FencedCommandBufferVK {
+class FencedCommandBufferVK
+    : public std::enable_shared_from_this<FencedCommandBufferVK> {
  public:
   FencedCommandBufferVK(vk::Device device,
                         vk::Queue queue,
-                        vk::CommandPool command_pool);
+                        std::unique_ptr<CommandPoolVK> command_pool,
+                        std::unique_ptr<DescriptorPoolVK> descriptor_pool,
+                        std::weak_ptr<FenceWaiterVK> fence_waiter);
 
   ~FencedCommandBufferVK();
 
@@ -24,20 +33,41 @@ class FencedCommandBufferVK {
 
   vk::CommandBuffer GetSingleUseChild();
 
-  // this is a blocking call that waits for the fence to be signaled.
-  bool Submit();
+  // Submits the command buffer and its children without waiting for them to
+  // complete. Once the fence is signaled, the deletion queue is flushed, the
+  // tracked resources are released and the callback is invoked, all on the
+  // thread of the fence waiter.
+  bool Submit(FenceWaiterVK::FenceCallback callback = nullptr);
 
   DeletionQueueVK* GetDeletionQueue() const;
 
+  // The descriptor sets allocated from this pool stay valid until the command
+  // buffer completes, at which point the pool is recycled.
+  DescriptorPoolVK* GetDescriptorPool() const;
+
+  // Keeps a resource referenced by the recorded commands alive until the GPU
+  // is done with them.
+  void Track(std::shared_ptr<const DeviceBuffer> buffer);
+
+  void Track(std::shared_ptr<const Texture> texture);
+
  private:
   vk::Device device_;
   vk::Queue queue_;
-  vk::CommandPool command_pool_;
+  std::unique_ptr<CommandPoolVK> command_pool_;
+  std::unique_ptr<DescriptorPoolVK> descriptor_pool_;
+  // Weak so that the waiter is never destroyed on its own thread by a
+  // command buffer it just completed.
+  std::weak_ptr<FenceWaiterVK> fence_waiter_;
   std::unique_ptr<DeletionQueueVK> deletion_queue_;
   vk::CommandBuffer command_buffer_;
   std::vector<vk::CommandBuffer> children_;
+  std::vector<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
+  std::vector<std::shared_ptr<const Texture>> tracked_textures_;
   bool submitted_ = false;
 
+  void OnCompleted();
+
   FML_DISALLOW_COPY_AND_ASSIGN(FencedCommandBufferVK);
 };
 
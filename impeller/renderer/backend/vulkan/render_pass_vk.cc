@@ -74,6 +74,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   auto& texture = TextureVK::Cast(*color0.texture);
   vk::Framebuffer framebuffer = CreateFrameBuffer(texture);
+  command_buffer_->Track(color0.texture);
 
   command_buffer_->GetDeletionQueue()->Push(
       [device = device_, fbo = framebuffer]() {
@@ -186,6 +187,8 @@ bool RenderPassVK::EncodeCommand(const Context& context,
                    << " for vertex and index buffer views";
     return false;
   }
+  command_buffer_->Track(vertex_buffer);
+  command_buffer_->Track(index_buffer);
 
   // bind vertex buffer
   auto vertex_buffer_handle =
@@ -217,53 +220,37 @@ bool RenderPassVK::AllocateAndBindDescriptorSets(
   vk::PipelineLayout pipeline_layout =
       pipeline_create_info->GetPipelineLayout();
 
-  const auto& context_vk = GetContextVK();
-  const auto& pool = context_vk.CreateDescriptorPool();
-
-  command_buffer_->GetDeletionQueue()->Push(
-      [pool = pool->GetPool(), device = device_]() {
-        device.destroyDescriptorPool(pool);
-      });
-
-  vk::DescriptorSetAllocateInfo alloc_info;
-  std::array<vk::DescriptorSetLayout, 1> dsls = {
-      pipeline_create_info->GetDescriptorSetLayout(),
-  };
-
-  alloc_info.setDescriptorPool(pool->GetPool());
-  alloc_info.setSetLayouts(dsls);
-
-  auto desc_sets_res = device_.allocateDescriptorSets(alloc_info);
-  if (desc_sets_res.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to allocate descriptor sets: "
-                   << vk::to_string(desc_sets_res.result);
-    return false;
-  }
-
-  auto desc_sets = desc_sets_res.value;
-  bool update_vertex_descriptors = UpdateDescriptorSets(
-      "vertex_bindings", command.vertex_bindings, allocator, desc_sets[0]);
+  DescriptorSetContentsVK contents;
+  bool update_vertex_descriptors = CollectDescriptorSetContents(
+      "vertex_bindings", command.vertex_bindings, allocator, &contents);
   if (!update_vertex_descriptors) {
     return false;
   }
-  bool update_frag_descriptors = UpdateDescriptorSets(
-      "fragment_bindings", command.fragment_bindings, allocator, desc_sets[0]);
+  bool update_frag_descriptors = CollectDescriptorSetContents(
+      "fragment_bindings", command.fragment_bindings, allocator, &contents);
   if (!update_frag_descriptors) {
     return false;
   }
 
-  command_buffer_->Get().bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, desc_sets, nullptr);
+  // Draws that bind the same resources share a descriptor set.
+  auto desc_set = command_buffer_->GetDescriptorPool()->AllocateDescriptorSet(
+      pipeline_create_info->GetDescriptorSetLayout(), contents);
+  if (!desc_set.has_value()) {
+    VALIDATION_LOG << "Failed to allocate descriptor sets.";
+    return false;
+  }
+
+  command_buffer_->Get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                                            pipeline_layout, 0,
+                                            desc_set.value(), nullptr);
   return true;
 }
 
-bool RenderPassVK::UpdateDescriptorSets(const char* label,
-                                        const Bindings& bindings,
-                                        Allocator& allocator,
-                                        vk::DescriptorSet desc_set) const {
-  std::vector<vk::WriteDescriptorSet> writes;
-  std::vector<vk::DescriptorBufferInfo> buffer_infos;
-  std::vector<vk::DescriptorImageInfo> image_infos;
+bool RenderPassVK::CollectDescriptorSetContents(
+    const char* label,
+    const Bindings& bindings,
+    Allocator& allocator,
+    DescriptorSetContentsVK* contents) const {
 
   for (const auto& [buffer_index, view] : bindings.buffers) {
     const auto& buffer_view = view.resource.buffer;
@@ -283,6 +270,7 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
     if (buffer_index == VertexDescriptor::kReservedVertexBufferIndex) {
       continue;
     }
+    command_buffer_->Track(device_buffer);
 
     uint32_t offset = view.resource.range.offset;
 
@@ -290,18 +278,9 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
     desc_buffer_info.setBuffer(buffer);
     desc_buffer_info.setOffset(offset);
     desc_buffer_info.setRange(view.resource.range.length);
-    buffer_infos.push_back(desc_buffer_info);
 
     const ShaderUniformSlot& uniform = bindings.uniforms.at(buffer_index);
-
-    vk::WriteDescriptorSet setWrite;
-    setWrite.setDstSet(desc_set);
-    setWrite.setDstBinding(uniform.binding);
-    setWrite.setDescriptorCount(1);
-    setWrite.setDescriptorType(vk::DescriptorType::eUniformBuffer);
-    setWrite.setPBufferInfo(&buffer_infos.back());
-
-    writes.push_back(setWrite);
+    contents->buffers.push_back({uniform.binding, desc_buffer_info});
   }
 
   for (const auto& [index, sampler_handle] : bindings.samplers) {
@@ -310,8 +289,9 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
       return false;
     }
 
-    const auto& texture_vk =
-        TextureVK::Cast(*bindings.textures.at(index).resource);
+    const auto& texture = bindings.textures.at(index).resource;
+    const auto& texture_vk = TextureVK::Cast(*texture);
+    command_buffer_->Track(texture);
 
     const Sampler& sampler = *sampler_handle.resource;
     const SamplerVK& sampler_vk = SamplerVK::Cast(sampler);
@@ -336,21 +316,7 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
     desc_image_info.setImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
     desc_image_info.setSampler(sampler_vk.GetSamplerVK());
     desc_image_info.setImageView(texture_vk.GetImageView());
-    image_infos.push_back(desc_image_info);
-
-    vk::WriteDescriptorSet setWrite;
-    setWrite.setDstSet(desc_set);
-    setWrite.setDstBinding(slot.binding);
-    setWrite.setDescriptorCount(1);
-    setWrite.setDescriptorType(vk::DescriptorType::eCombinedImageSampler);
-    setWrite.setPImageInfo(&image_infos.back());
-
-    writes.push_back(setWrite);
-  }
-
-  std::array<vk::CopyDescriptorSet, 0> copies;
-  if (!writes.empty()) {
-    device_.updateDescriptorSets(writes, copies);
+    contents->images.push_back({slot.binding, desc_image_info});
   }
 
   return true;
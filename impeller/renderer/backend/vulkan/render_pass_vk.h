@@ -54,10 +54,10 @@ class RenderPassVK final : public RenderPass {
 
   bool EndCommandBuffer();
 
-  bool UpdateDescriptorSets(const char* label,
-                            const Bindings& bindings,
-                            Allocator& allocator,
-                            vk::DescriptorSet desc_set) const;
+  bool CollectDescriptorSetContents(const char* label,
+                                   const Bindings& bindings,
+                                   Allocator& allocator,
+                                   DescriptorSetContentsVK* contents) const;
 
   void SetViewportAndScissor(const Command& command) const;
 
@@ -4,26 +4,15 @@
 
 #include "impeller/renderer/backend/vulkan/shader_library_vk.h"
 
+#include <optional>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
-#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_function_vk.h"
 
 namespace impeller {
 
-static ShaderStage ToShaderStage(BlobShaderType type) {
-  switch (type) {
-    case BlobShaderType::kVertex:
-      return ShaderStage::kVertex;
-    case BlobShaderType::kFragment:
-      return ShaderStage::kFragment;
-    case BlobShaderType::kCompute:
-      return ShaderStage::kCompute;
-  }
-  FML_UNREACHABLE();
-}
-
 static std::string VKShaderNameToShaderKeyName(const std::string& name,
                                                ShaderStage stage) {
   std::stringstream stream;
@@ -52,62 +41,91 @@ static std::string VKShaderNameToShaderKeyName(const std::string& name,
   return stream.str();
 }
 
+static std::optional<BlobShaderType> ToBlobShaderType(ShaderStage stage) {
+  switch (stage) {
+    case ShaderStage::kVertex:
+      return BlobShaderType::kVertex;
+    case ShaderStage::kFragment:
+      return BlobShaderType::kFragment;
+    case ShaderStage::kCompute:
+      return BlobShaderType::kCompute;
+    case ShaderStage::kUnknown:
+    case ShaderStage::kTessellationControl:
+    case ShaderStage::kTessellationEvaluation:
+      return std::nullopt;
+  }
+  FML_UNREACHABLE();
+}
+
 ShaderLibraryVK::ShaderLibraryVK(
     const vk::Device& device,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data) {
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data)
+    : device_(device) {
   TRACE_EVENT0("impeller", "ShaderLibraryCreate");
-  ShaderFunctionMap functions;
-  bool success = true;
-  auto iterator = [&success, &device, &functions, library_id = library_id_](
-                      auto type,           //
-                      const auto& name,    //
-                      const auto& mapping  //
-                      ) -> bool {
+  // Shader modules are only created for the functions that are looked up, so
+  // that startup doesn't pay for every shader in the libraries.
+  for (const auto& library_data : shader_libraries_data) {
+    auto blob_library = BlobLibrary{library_data};
+    if (!blob_library.IsValid()) {
+      VALIDATION_LOG << "Could not construct shader blob library.";
+      return;
+    }
+    blob_libraries_.emplace_back(std::move(blob_library));
+  }
+
+  is_valid_ = true;
+}
+
+std::shared_ptr<const ShaderFunction> ShaderLibraryVK::CreateFunctionFromBlobs(
+    std::string_view name,
+    ShaderStage stage) const {
+  const auto type = ToBlobShaderType(stage);
+  if (!type.has_value()) {
+    return nullptr;
+  }
+
+  // Function names are derived from the blob names.
+  const auto suffix = VKShaderNameToShaderKeyName("", stage);
+  if (name.size() <= suffix.size() ||
+      name.substr(name.size() - suffix.size()) != suffix) {
+    return nullptr;
+  }
+  const auto blob_name = name.substr(0, name.size() - suffix.size());
+
+  for (const auto& blob_library : blob_libraries_) {
+    auto mapping = blob_library.GetMapping(type.value(), blob_name);
+    if (!mapping) {
+      continue;
+    }
+
+    TRACE_EVENT0("impeller", "CreateShaderModule");
     vk::ShaderModuleCreateInfo shader_module_info;
 
     shader_module_info.setPCode(
         reinterpret_cast<const uint32_t*>(mapping->GetMapping()));
     shader_module_info.setCodeSize(mapping->GetSize());
 
-    auto module = device.createShaderModuleUnique(shader_module_info);
+    auto module = device_.createShaderModuleUnique(shader_module_info);
 
     if (module.result != vk::Result::eSuccess) {
       VALIDATION_LOG << "Could not create shader module: "
                      << vk::to_string(module.result);
-      success = false;
-      return false;
+      return nullptr;
     }
 
-    const auto stage = ToShaderStage(type);
-    const auto key_name = VKShaderNameToShaderKeyName(name, stage);
-
+    const auto key_name = std::string{name};
     vk::UniqueShaderModule shader_module = std::move(module.value);
-    ContextVK::SetDebugName(device, *shader_module,
+    ContextVK::SetDebugName(device_, *shader_module,
                             "shader_module_" + key_name);
 
-    functions[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionVK>(
-        new ShaderFunctionVK(library_id,               //
+    return std::shared_ptr<ShaderFunctionVK>(
+        new ShaderFunctionVK(library_id_,              //
                              key_name,                 //
                              stage,                    //
                              std::move(shader_module)  //
                              ));
-
-    return true;
-  };
-  for (const auto& library_data : shader_libraries_data) {
-    auto blob_library = BlobLibrary{library_data};
-    if (!blob_library.IsValid()) {
-      VALIDATION_LOG << "Could not construct shader blob library.";
-      return;
-    }
-    blob_library.IterateAllBlobs(iterator);
-  }
-
-  if (!success) {
-    return;
   }
-  functions_ = std::move(functions);
-  is_valid_ = true;
+  return nullptr;
 }
 
 ShaderLibraryVK::~ShaderLibraryVK() = default;
@@ -119,32 +137,50 @@ bool ShaderLibraryVK::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryVK::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
-
   const auto key = ShaderKey{{name.data(), name.size()}, stage};
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
-    return found->second;
+  {
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    if (found != functions_.end()) {
+      return found->second;
+    }
+    if (unregistered_functions_.count(key) != 0) {
+      return nullptr;
+    }
   }
-  return nullptr;
+
+  auto function = CreateFunctionFromBlobs(name, stage);
+  if (!function) {
+    return nullptr;
+  }
+
+  // Another thread may have created or unregistered the same function in the
+  // meantime.
+  WriterLock lock(functions_mutex_);
+  if (unregistered_functions_.count(key) != 0) {
+    return nullptr;
+  }
+  return functions_.try_emplace(key, std::move(function)).first->second;
 }
 
 // |ShaderLibrary|
 void ShaderLibraryVK::UnregisterFunction(std::string name, ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
+  WriterLock lock(functions_mutex_);
 
   const auto key = ShaderKey{name, stage};
 
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
+  // Functions are created lazily, so one that was never looked up can be
+  // unregistered too. Remember it so that it isn't created later.
+  if (!unregistered_functions_.insert(key).second) {
     VALIDATION_LOG << "Library function named " << name
-                   << " was not found, so it couldn't be unregistered.";
+                   << " was already unregistered.";
     return;
   }
 
-  functions_.erase(found);
-
-  return;
+  auto found = functions_.find(key);
+  if (found != functions_.end()) {
+    functions_.erase(found);
+  }
 }
 
 }  // namespace impeller
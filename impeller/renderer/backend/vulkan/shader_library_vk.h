@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/base/thread.h"
+#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/shader_key.h"
 #include "impeller/renderer/shader_library.h"
@@ -24,8 +29,12 @@ class ShaderLibraryVK final : public ShaderLibrary {
  private:
   friend class ContextVK;
   const UniqueID library_id_;
+  const vk::Device device_;
+  std::vector<BlobLibrary> blob_libraries_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_;
+  std::unordered_set<ShaderKey, ShaderKey::Hash, ShaderKey::Equal>
+      unregistered_functions_;
   bool is_valid_ = false;
 
   ShaderLibraryVK(
@@ -39,6 +48,10 @@ class ShaderLibraryVK final : public ShaderLibrary {
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
+  std::shared_ptr<const ShaderFunction> CreateFunctionFromBlobs(
+      std::string_view name,
+      ShaderStage stage) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ShaderLibraryVK);
 };
 
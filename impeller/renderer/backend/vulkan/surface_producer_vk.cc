@@ -156,13 +156,9 @@ bool SurfaceProducerVK::Submit(uint32_t frame_num) {
     return false;
   }
 
-  auto idle_wait_res = create_info_.graphics_queue.waitIdle();
-  if (idle_wait_res != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to wait for graphics queue idle: "
-                   << vk::to_string(idle_wait_res);
-    return false;
-  }
-
+  // Frames are paced by the in-flight fence waited on in |AcquireSurface|, and
+  // the resources of earlier submissions are released by the fence waiter, so
+  // there is no need to wait for the queue to drain here.
   return true;
 }
 
@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+static constexpr std::chrono::nanoseconds kMaxTimeout = std::chrono::hours(24);
+
+struct MockFence {
+  bool signaled = false;
+};
+
+struct MockDeviceState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::unordered_set<MockFence*> fences;
+  bool lost = false;
+};
+
+MockDeviceState* gDevice = nullptr;
+
+MockFence* ToMockFence(VkFence fence) {
+  return reinterpret_cast<MockFence*>(fence);
+}
+
+VkResult MockCreateFence(VkDevice device,
+                         const VkFenceCreateInfo* create_info,
+                         const VkAllocationCallbacks* allocator,
+                         VkFence* fence) {
+  auto mock_fence = new MockFence();
+  mock_fence->signaled =
+      (create_info->flags & VK_FENCE_CREATE_SIGNALED_BIT) != 0;
+  std::scoped_lock lock(gDevice->mutex);
+  gDevice->fences.insert(mock_fence);
+  *fence = reinterpret_cast<VkFence>(mock_fence);
+  return VK_SUCCESS;
+}
+
+void MockDestroyFence(VkDevice device,
+                      VkFence fence,
+                      const VkAllocationCallbacks* allocator) {
+  if (fence == VK_NULL_HANDLE) {
+    return;
+  }
+  std::scoped_lock lock(gDevice->mutex);
+  FML_CHECK(gDevice->fences.erase(ToMockFence(fence)) == 1u);
+  delete ToMockFence(fence);
+}
+
+VkResult MockGetFenceStatus(VkDevice device, VkFence fence) {
+  std::scoped_lock lock(gDevice->mutex);
+  if (gDevice->lost) {
+    return VK_ERROR_DEVICE_LOST;
+  }
+  return ToMockFence(fence)->signaled ? VK_SUCCESS : VK_NOT_READY;
+}
+
+VkResult MockWaitForFences(VkDevice device,
+                           uint32_t fence_count,
+                           const VkFence* fences,
+                           VkBool32 wait_all,
+                           uint64_t timeout) {
+  auto is_done = [&]() {
+    size_t signaled_count = 0;
+    for (uint32_t i = 0; i < fence_count; i++) {
+      if (ToMockFence(fences[i])->signaled) {
+        signaled_count++;
+      }
+    }
+    return wait_all ? signaled_count == fence_count : signaled_count > 0;
+  };
+  // Clamped so that infinite timeouts don't overflow the clock.
+  auto timeout_ns = std::chrono::nanoseconds(
+      std::min<uint64_t>(timeout, kMaxTimeout.count()));
+  std::unique_lock lock(gDevice->mutex);
+  if (!gDevice->cv.wait_for(lock, timeout_ns,
+                            [&]() { return gDevice->lost || is_done(); })) {
+    return VK_TIMEOUT;
+  }
+  return gDevice->lost ? VK_ERROR_DEVICE_LOST : VK_SUCCESS;
+}
+
+}  // namespace
+
+MockVulkanDevice::MockVulkanDevice() {
+  FML_CHECK(gDevice == nullptr) << "Only one mock device may exist at a time.";
+  gDevice = new MockDeviceState();
+
+  auto& dispatcher = VULKAN_HPP_DEFAULT_DISPATCHER;
+  previous_create_fence_ = dispatcher.vkCreateFence;
+  previous_destroy_fence_ = dispatcher.vkDestroyFence;
+  previous_get_fence_status_ = dispatcher.vkGetFenceStatus;
+  previous_wait_for_fences_ = dispatcher.vkWaitForFences;
+  dispatcher.vkCreateFence = MockCreateFence;
+  dispatcher.vkDestroyFence = MockDestroyFence;
+  dispatcher.vkGetFenceStatus = MockGetFenceStatus;
+  dispatcher.vkWaitForFences = MockWaitForFences;
+}
+
+MockVulkanDevice::~MockVulkanDevice() {
+  auto& dispatcher = VULKAN_HPP_DEFAULT_DISPATCHER;
+  dispatcher.vkCreateFence = previous_create_fence_;
+  dispatcher.vkDestroyFence = previous_destroy_fence_;
+  dispatcher.vkGetFenceStatus = previous_get_fence_status_;
+  dispatcher.vkWaitForFences = previous_wait_for_fences_;
+
+  FML_CHECK(gDevice->fences.empty()) << "Fences outlived the mock device.";
+  delete gDevice;
+  gDevice = nullptr;
+}
+
+vk::Device MockVulkanDevice::GetDevice() const {
+  // The handle is never dereferenced by the mock entry points.
+  return vk::Device(reinterpret_cast<VkDevice>(gDevice));
+}
+
+vk::UniqueFence MockVulkanDevice::CreateFence() {
+  auto fence = GetDevice().createFenceUnique(vk::FenceCreateInfo());
+  FML_CHECK(fence.result == vk::Result::eSuccess);
+  return std::move(fence.value);
+}
+
+void MockVulkanDevice::SignalFence(vk::Fence fence) {
+  {
+    std::scoped_lock lock(gDevice->mutex);
+    ToMockFence(static_cast<VkFence>(fence))->signaled = true;
+  }
+  gDevice->cv.notify_all();
+}
+
+void MockVulkanDevice::LoseDevice() {
+  {
+    std::scoped_lock lock(gDevice->mutex);
+    gDevice->lost = true;
+  }
+  gDevice->cv.notify_all();
+}
+
+size_t MockVulkanDevice::GetLiveFenceCount() const {
+  std::scoped_lock lock(gDevice->mutex);
+  return gDevice->fences.size();
+}
+
+}  // namespace testing
+}  // namespace impeller
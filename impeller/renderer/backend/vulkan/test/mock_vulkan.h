@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+namespace testing {
+
+//------------------------------------------------------------------------------
+/// @brief      A fake device that implements the fence entry points of the
+///             default dispatcher for as long as it is alive. Fences are
+///             created unsignaled and are signaled by the test.
+///
+///             Only one mock device may exist at a time.
+///
+class MockVulkanDevice {
+ public:
+  MockVulkanDevice();
+
+  ~MockVulkanDevice();
+
+  vk::Device GetDevice() const;
+
+  vk::UniqueFence CreateFence();
+
+  void SignalFence(vk::Fence fence);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes all subsequent waits and status queries report that
+  ///             the device was lost.
+  ///
+  void LoseDevice();
+
+  size_t GetLiveFenceCount() const;
+
+ private:
+  PFN_vkCreateFence previous_create_fence_;
+  PFN_vkDestroyFence previous_destroy_fence_;
+  PFN_vkGetFenceStatus previous_get_fence_status_;
+  PFN_vkWaitForFences previous_wait_for_fences_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MockVulkanDevice);
+};
+
+}  // namespace testing
+}  // namespace impeller
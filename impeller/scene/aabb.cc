@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/aabb.h"
+
+#include <algorithm>
+
+namespace impeller {
+namespace scene {
+
+std::array<Vector3, 8> AABB::GetCorners() const {
+  return {
+      Vector3(min.x, min.y, min.z), Vector3(max.x, min.y, min.z),
+      Vector3(min.x, max.y, min.z), Vector3(max.x, max.y, min.z),
+      Vector3(min.x, min.y, max.z), Vector3(max.x, min.y, max.z),
+      Vector3(min.x, max.y, max.z), Vector3(max.x, max.y, max.z),
+  };
+}
+
+Vector3 AABB::GetCenter() const {
+  return (min + max) / 2;
+}
+
+AABB AABB::Union(const AABB& other) const {
+  return {
+      .min = Vector3(std::min(min.x, other.min.x), std::min(min.y, other.min.y),
+                     std::min(min.z, other.min.z)),
+      .max = Vector3(std::max(max.x, other.max.x), std::max(max.y, other.max.y),
+                     std::max(max.z, other.max.z)),
+  };
+}
+
+AABB AABB::TransformBounds(const Matrix& transform) const {
+  auto corners = GetCorners();
+  Vector3 first = transform * corners[0];
+  AABB result = {.min = first, .max = first};
+  for (size_t i = 1; i < corners.size(); i++) {
+    Vector3 corner = transform * corners[i];
+    result = result.Union({.min = corner, .max = corner});
+  }
+  return result;
+}
+
+bool AABB::IsOutsideClipVolume(const Matrix& mvp) const {
+  // Each bit is set if a corner lies outside of one of the clip planes
+  // -w <= x <= w, -w <= y <= w and 0 <= z <= w. The box is outside if all of
+  // its corners are outside of the same plane.
+  uint32_t outside_all = 0b111111;
+  for (const auto& corner : GetCorners()) {
+    Vector4 clip = mvp * Vector4(corner);
+    uint32_t outside = 0;
+    outside |= (clip.x < -clip.w) << 0;
+    outside |= (clip.x > clip.w) << 1;
+    outside |= (clip.y < -clip.w) << 2;
+    outside |= (clip.y > clip.w) << 3;
+    outside |= (clip.z < 0) << 4;
+    outside |= (clip.z > clip.w) << 5;
+    outside_all &= outside;
+    if (outside_all == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace scene
+}  // namespace impeller
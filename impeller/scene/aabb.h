@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/vector.h"
+
+namespace impeller {
+namespace scene {
+
+//------------------------------------------------------------------------------
+/// @brief      An axis aligned bounding box.
+///
+struct AABB {
+  Vector3 min;
+  Vector3 max;
+
+  std::array<Vector3, 8> GetCorners() const;
+
+  Vector3 GetCenter() const;
+
+  AABB Union(const AABB& other) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the box that contains all corners of this box after
+  ///             they are transformed by the given affine transform.
+  ///
+  AABB TransformBounds(const Matrix& transform) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the box lies entirely outside the view volume once it
+  ///             is transformed into clip space by the given model view
+  ///             projection. The test is conservative: a box that straddles
+  ///             an edge of the view volume may be considered visible even
+  ///             though none of it is.
+  ///
+  bool IsOutsideClipVolume(const Matrix& mvp) const;
+};
+
+}  // namespace scene
+}  // namespace impeller
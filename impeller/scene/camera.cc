@@ -26,9 +26,12 @@ Matrix Camera::GetTransform(ISize target_size) const {
     return transform_.value();
   }
 
+  // The look-at matrix already maps from world space into a view space that
+  // faces +Z, whereas the projection expects the view to face -Z.
   transform_ =
       Matrix::MakePerspective(Radians(fov_y_), target_size, z_near_, z_far_) *
-      Matrix::MakeLookAt(position_, target_, up_).Invert();
+      Matrix::MakeScale(Vector3(1, 1, -1)) *
+      Matrix::MakeLookAt(position_, target_, up_);
 
   return transform_.value();
 }
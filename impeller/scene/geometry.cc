@@ -4,12 +4,16 @@
 
 #include "impeller/scene/geometry.h"
 
+#include <array>
 #include <memory>
 
+#include "impeller/base/validation.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/vector.h"
+#include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/geometry.vert.h"
 
 namespace impeller {
@@ -25,6 +29,42 @@ std::shared_ptr<CuboidGeometry> Geometry::MakeCuboid(Vector3 size) {
   return result;
 }
 
+std::shared_ptr<ImportedGeometry> Geometry::MakeFromFlatbuffer(
+    std::shared_ptr<fml::Mapping> mapping,
+    size_t mesh_index) {
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    VALIDATION_LOG << "Scene mapping was absent.";
+    return nullptr;
+  }
+  if (!fb::SceneBufferHasIdentifier(mapping->GetMapping())) {
+    VALIDATION_LOG << "Invalid scene magic.";
+    return nullptr;
+  }
+  auto meshes = fb::GetScene(mapping->GetMapping())->meshes();
+  if (!meshes || mesh_index >= meshes->size()) {
+    VALIDATION_LOG << "Scene doesn't contain mesh " << mesh_index << ".";
+    return nullptr;
+  }
+  const auto* mesh = meshes->Get(mesh_index);
+  if (!mesh->vertices() || !mesh->indices() || !mesh->indices()->data()) {
+    VALIDATION_LOG << "Mesh " << mesh_index << " has no vertices or indices.";
+    return nullptr;
+  }
+  return std::make_shared<ImportedGeometry>(std::move(mapping), mesh);
+}
+
+std::shared_ptr<ImportedGeometry> Geometry::MakeFromPath(
+    const std::string& path,
+    size_t mesh_index) {
+  std::shared_ptr<fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    VALIDATION_LOG << "Could not map scene file at path: " << path;
+    return nullptr;
+  }
+  return MakeFromFlatbuffer(std::move(mapping), mesh_index);
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -33,10 +73,9 @@ void CuboidGeometry::SetSize(Vector3 size) {
   size_ = size;
 }
 
-VertexBuffer CuboidGeometry::GetVertexBuffer(Allocator& allocator) const {
-  VertexBufferBuilder<GeometryVertexShader::PerVertexData, uint16_t> builder;
+static std::array<GeometryVertexShader::PerVertexData, 6> GetCuboidVertices() {
   // Layout: position, normal, tangent, uv
-  builder.AddVertices({
+  return {{
       // Front.
       {Vector3(0, 0, 0), Vector3(0, 0, -1), Vector3(1, 0, 0), Point(0, 0)},
       {Vector3(1, 0, 0), Vector3(0, 0, -1), Vector3(1, 0, 0), Point(1, 0)},
@@ -44,9 +83,84 @@ VertexBuffer CuboidGeometry::GetVertexBuffer(Allocator& allocator) const {
       {Vector3(1, 1, 0), Vector3(0, 0, -1), Vector3(1, 0, 0), Point(1, 1)},
       {Vector3(0, 1, 0), Vector3(0, 0, -1), Vector3(1, 0, 0), Point(0, 1)},
       {Vector3(0, 0, 0), Vector3(0, 0, -1), Vector3(1, 0, 0), Point(0, 0)},
-  });
+  }};
+}
+
+VertexBuffer CuboidGeometry::GetVertexBuffer(Allocator& allocator) const {
+  VertexBufferBuilder<GeometryVertexShader::PerVertexData, uint16_t> builder;
+  for (const auto& vertex : GetCuboidVertices()) {
+    builder.AppendVertex(vertex);
+  }
   return builder.CreateVertexBuffer(allocator);
 }
 
+AABB CuboidGeometry::GetBounds() const {
+  auto vertices = GetCuboidVertices();
+  AABB bounds = {.min = vertices[0].position, .max = vertices[0].position};
+  for (const auto& vertex : vertices) {
+    bounds = bounds.Union({.min = vertex.position, .max = vertex.position});
+  }
+  return bounds;
+}
+
+//------------------------------------------------------------------------------
+/// ImportedGeometry
+///
+
+// The importer writes vertices in the exact layout the vertex shader consumes.
+static_assert(sizeof(fb::Vertex) ==
+              sizeof(GeometryVertexShader::PerVertexData));
+
+static Vector3 ToVector3(const fb::Vec3& vec) {
+  return Vector3(vec.x(), vec.y(), vec.z());
+}
+
+ImportedGeometry::ImportedGeometry(std::shared_ptr<fml::Mapping> mapping,
+                                   const fb::Mesh* mesh)
+    : mapping_(std::move(mapping)), mesh_(mesh) {
+  if (const auto* bounds = mesh_->bounds()) {
+    bounds_ = {.min = ToVector3(bounds->min()),
+               .max = ToVector3(bounds->max())};
+  }
+}
+
+VertexBuffer ImportedGeometry::GetVertexBuffer(Allocator& allocator) const {
+  if (uploaded_allocator_id_ == allocator.GetUniqueID()) {
+    return vertex_buffer_;
+  }
+
+  const auto* vertices = mesh_->vertices();
+  const auto* indices = mesh_->indices();
+  const size_t index_size =
+      indices->type() == fb::IndexType::k16Bit ? sizeof(uint16_t)
+                                               : sizeof(uint32_t);
+  if (indices->data()->size() < indices->count() * index_size) {
+    VALIDATION_LOG << "Mesh indices are truncated.";
+    return {};
+  }
+
+  auto vertex_buffer = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(vertices->data()),
+      vertices->size() * sizeof(fb::Vertex));
+  auto index_buffer = allocator.CreateBufferWithCopy(
+      indices->data()->data(), indices->count() * index_size);
+  if (!vertex_buffer || !index_buffer) {
+    return {};
+  }
+
+  vertex_buffer_.vertex_buffer = vertex_buffer->AsBufferView();
+  vertex_buffer_.index_buffer = index_buffer->AsBufferView();
+  vertex_buffer_.index_count = indices->count();
+  vertex_buffer_.index_type = indices->type() == fb::IndexType::k16Bit
+                                  ? IndexType::k16bit
+                                  : IndexType::k32bit;
+  uploaded_allocator_id_ = allocator.GetUniqueID();
+  return vertex_buffer_;
+}
+
+AABB ImportedGeometry::GetBounds() const {
+  return bounds_;
+}
+
 }  // namespace scene
 }  // namespace impeller
@@ -5,21 +5,59 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
 
+#include "flutter/fml/mapping.h"
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/vertex_buffer.h"
+#include "impeller/scene/aabb.h"
 
 namespace impeller {
+
+namespace fb {
+struct Mesh;
+}  // namespace fb
+
 namespace scene {
 
 class CuboidGeometry;
+class ImportedGeometry;
 
 class Geometry {
  public:
   static std::shared_ptr<CuboidGeometry> MakeCuboid(Vector3 size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a geometry from a mesh in a file produced by the scene
+  ///             importer. The mesh is read in place, so the mapping is kept
+  ///             alive by the geometry.
+  ///
+  /// @param[in]  mapping     The contents of the imported scene file.
+  /// @param[in]  mesh_index  The index of the mesh in the scene.
+  ///
+  /// @return     The geometry, or null if the mapping isn't a valid scene or
+  ///             doesn't contain the mesh.
+  ///
+  static std::shared_ptr<ImportedGeometry> MakeFromFlatbuffer(
+      std::shared_ptr<fml::Mapping> mapping,
+      size_t mesh_index = 0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Memory maps a file produced by the scene importer and creates
+  ///             a geometry from one of its meshes.
+  ///
+  /// @see        `MakeFromFlatbuffer`
+  ///
+  static std::shared_ptr<ImportedGeometry> MakeFromPath(
+      const std::string& path,
+      size_t mesh_index = 0);
+
   virtual VertexBuffer GetVertexBuffer(Allocator& allocator) const = 0;
+
+  /// The bounds of the vertices in the geometry's coordinate space.
+  virtual AABB GetBounds() const = 0;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -28,9 +66,30 @@ class CuboidGeometry final : public Geometry {
 
   VertexBuffer GetVertexBuffer(Allocator& allocator) const override;
 
+  AABB GetBounds() const override;
+
  private:
   Vector3 size_;
 };
 
+class ImportedGeometry final : public Geometry {
+ public:
+  ImportedGeometry(std::shared_ptr<fml::Mapping> mapping, const fb::Mesh* mesh);
+
+  /// Uploads the vertices and indices straight from the mapping the first time
+  /// the geometry is drawn with an allocator, and reuses the device buffers
+  /// afterwards.
+  VertexBuffer GetVertexBuffer(Allocator& allocator) const override;
+
+  AABB GetBounds() const override;
+
+ private:
+  std::shared_ptr<fml::Mapping> mapping_;
+  const fb::Mesh* mesh_;
+  AABB bounds_;
+  mutable std::optional<UniqueID> uploaded_allocator_id_;
+  mutable VertexBuffer vertex_buffer_;
+};
+
 }  // namespace scene
 }  // namespace impeller
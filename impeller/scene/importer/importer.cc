@@ -0,0 +1,22 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/importer/importer.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+std::shared_ptr<fml::Mapping> CreateSceneMapping(const fb::SceneT& scene) {
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  builder->Finish(fb::Scene::Pack(*builder.get(), &scene),
+                  fb::SceneIdentifier());
+  return std::make_shared<fml::NonOwnedMapping>(builder->GetBufferPointer(),
+                                                builder->GetSize(),
+                                                [builder](auto, auto) {});
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
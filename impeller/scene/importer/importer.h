@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/scene/importer/scene_flatbuffers.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// @brief      Converts every triangle list primitive of a glTF (.gltf or
+///             .glb) into a mesh whose vertices and indices are laid out the
+///             way the scene renderer uploads them.
+///
+/// @param[in]  source_mapping  The contents of the glTF file.
+/// @param[in]  base_dir        The directory of the glTF file, which the URIs
+///                             of external buffers are relative to.
+/// @param[out] out_scene       The scene the meshes are added to.
+///
+/// @return     Whether the glTF could be parsed.
+///
+bool ParseGLTF(const fml::Mapping& source_mapping,
+               const std::string& base_dir,
+               fb::SceneT& out_scene);
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes a scene into the format loaded by
+///             `Geometry::MakeFromFlatbuffer`.
+///
+std::shared_ptr<fml::Mapping> CreateSceneMapping(const fb::SceneT& scene);
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
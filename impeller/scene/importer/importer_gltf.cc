@@ -0,0 +1,350 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/scene/importer/importer.h"
+#include "third_party/tinygltf/tiny_gltf.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+static bool IsGLB(const fml::Mapping& mapping) {
+  return mapping.GetSize() >= 4 &&
+         std::memcmp(mapping.GetMapping(), "glTF", 4) == 0;
+}
+
+static Scalar ReadComponent(const uint8_t* data,
+                            int component_type,
+                            bool normalized) {
+  // Normalized integers are mapped to [0, 1] or [-1, 1] as described in
+  // section 3.11 of the glTF 2.0 specification.
+  switch (component_type) {
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: {
+      float value;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
+      uint8_t value = *data;
+      return normalized ? value / 255.0f : value;
+    }
+    case TINYGLTF_COMPONENT_TYPE_BYTE: {
+      int8_t value;
+      std::memcpy(&value, data, sizeof(value));
+      return normalized ? std::max(value / 127.0f, -1.0f) : value;
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+      uint16_t value;
+      std::memcpy(&value, data, sizeof(value));
+      return normalized ? value / 65535.0f : value;
+    }
+    case TINYGLTF_COMPONENT_TYPE_SHORT: {
+      int16_t value;
+      std::memcpy(&value, data, sizeof(value));
+      return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+      uint32_t value;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+    }
+  }
+  return 0;
+}
+
+/// Resolves where the elements of an accessor are stored. Returns null if the
+/// accessor isn't backed by a buffer view or doesn't fit in its buffer.
+static const uint8_t* GetAccessorData(const tinygltf::Model& model,
+                                      const tinygltf::Accessor& accessor,
+                                      size_t* out_stride) {
+  if (accessor.sparse.isSparse) {
+    FML_LOG(ERROR) << "Sparse accessors are not supported.";
+    return nullptr;
+  }
+  if (accessor.bufferView < 0 ||
+      static_cast<size_t>(accessor.bufferView) >= model.bufferViews.size()) {
+    return nullptr;
+  }
+  const auto& view = model.bufferViews[accessor.bufferView];
+  if (view.buffer < 0 ||
+      static_cast<size_t>(view.buffer) >= model.buffers.size()) {
+    return nullptr;
+  }
+  const auto& buffer = model.buffers[view.buffer];
+
+  auto stride = accessor.ByteStride(view);
+  auto components = tinygltf::GetNumComponentsInType(accessor.type);
+  auto component_size =
+      tinygltf::GetComponentSizeInBytes(accessor.componentType);
+  if (stride <= 0 || components <= 0 || component_size <= 0) {
+    return nullptr;
+  }
+
+  auto offset = view.byteOffset + accessor.byteOffset;
+  if (accessor.count > 0 &&
+      offset + stride * (accessor.count - 1) + components * component_size >
+          buffer.data.size()) {
+    FML_LOG(ERROR) << "Accessor " << accessor.name
+                   << " reads past the end of its buffer.";
+    return nullptr;
+  }
+
+  *out_stride = static_cast<size_t>(stride);
+  return buffer.data.data() + offset;
+}
+
+/// Reads the first `components` components of every element of an accessor
+/// into a tightly packed array of floats.
+static bool ReadFloats(const tinygltf::Model& model,
+                       int accessor_index,
+                       size_t components,
+                       std::vector<Scalar>& out_values) {
+  if (accessor_index < 0 ||
+      static_cast<size_t>(accessor_index) >= model.accessors.size()) {
+    return false;
+  }
+  const auto& accessor = model.accessors[accessor_index];
+  if (static_cast<size_t>(tinygltf::GetNumComponentsInType(accessor.type)) <
+      components) {
+    FML_LOG(ERROR) << "Accessor " << accessor.name
+                   << " has too few components.";
+    return false;
+  }
+
+  size_t stride = 0;
+  auto data = GetAccessorData(model, accessor, &stride);
+  if (!data) {
+    return false;
+  }
+
+  auto component_size =
+      tinygltf::GetComponentSizeInBytes(accessor.componentType);
+  out_values.resize(accessor.count * components);
+  for (size_t i = 0; i < accessor.count; i++) {
+    for (size_t c = 0; c < components; c++) {
+      out_values[i * components + c] =
+          ReadComponent(data + i * stride + c * component_size,
+                        accessor.componentType, accessor.normalized);
+    }
+  }
+  return true;
+}
+
+static bool ReadIndices(const tinygltf::Model& model,
+                        int accessor_index,
+                        std::vector<uint32_t>& out_indices) {
+  if (accessor_index < 0 ||
+      static_cast<size_t>(accessor_index) >= model.accessors.size()) {
+    return false;
+  }
+  const auto& accessor = model.accessors[accessor_index];
+  if (accessor.type != TINYGLTF_TYPE_SCALAR) {
+    return false;
+  }
+
+  size_t stride = 0;
+  auto data = GetAccessorData(model, accessor, &stride);
+  if (!data) {
+    return false;
+  }
+
+  out_indices.resize(accessor.count);
+  for (size_t i = 0; i < accessor.count; i++) {
+    const auto* element = data + i * stride;
+    switch (accessor.componentType) {
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        out_indices[i] = *element;
+        break;
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+        uint16_t index;
+        std::memcpy(&index, element, sizeof(index));
+        out_indices[i] = index;
+        break;
+      }
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        std::memcpy(&out_indices[i], element, sizeof(uint32_t));
+        break;
+      default:
+        FML_LOG(ERROR) << "Unsupported index component type.";
+        return false;
+    }
+  }
+  return true;
+}
+
+static fb::Vec3 ToVec3(const std::vector<Scalar>& values, size_t index) {
+  return fb::Vec3(values[index * 3], values[index * 3 + 1],
+                  values[index * 3 + 2]);
+}
+
+static bool ProcessPrimitive(const tinygltf::Model& model,
+                             const tinygltf::Primitive& primitive,
+                             fb::MeshT& out_mesh) {
+  auto attribute = [&primitive](const char* name) {
+    auto found = primitive.attributes.find(name);
+    return found == primitive.attributes.end() ? -1 : found->second;
+  };
+
+  std::vector<Scalar> positions;
+  if (!ReadFloats(model, attribute("POSITION"), 3, positions)) {
+    FML_LOG(ERROR) << "Primitive of mesh " << out_mesh.name
+                   << " has no readable positions.";
+    return false;
+  }
+  const size_t vertex_count = positions.size() / 3;
+
+  // Missing attributes are left at their defaults. Tangents are vec4s in glTF
+  // whose w component holds the handedness, which the vertex shader doesn't
+  // use.
+  std::vector<Scalar> normals;
+  std::vector<Scalar> tangents;
+  std::vector<Scalar> texture_coords;
+  if (attribute("NORMAL") >= 0 &&
+      (!ReadFloats(model, attribute("NORMAL"), 3, normals) ||
+       normals.size() != vertex_count * 3)) {
+    return false;
+  }
+  if (attribute("TANGENT") >= 0 &&
+      (!ReadFloats(model, attribute("TANGENT"), 3, tangents) ||
+       tangents.size() != vertex_count * 3)) {
+    return false;
+  }
+  if (attribute("TEXCOORD_0") >= 0 &&
+      (!ReadFloats(model, attribute("TEXCOORD_0"), 2, texture_coords) ||
+       texture_coords.size() != vertex_count * 2)) {
+    return false;
+  }
+
+  out_mesh.vertices.reserve(vertex_count);
+  fb::Vec3 min(std::numeric_limits<float>::max(),
+               std::numeric_limits<float>::max(),
+               std::numeric_limits<float>::max());
+  fb::Vec3 max(std::numeric_limits<float>::lowest(),
+               std::numeric_limits<float>::lowest(),
+               std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < vertex_count; i++) {
+    auto position = ToVec3(positions, i);
+    min = fb::Vec3(std::min(min.x(), position.x()),
+                   std::min(min.y(), position.y()),
+                   std::min(min.z(), position.z()));
+    max = fb::Vec3(std::max(max.x(), position.x()),
+                   std::max(max.y(), position.y()),
+                   std::max(max.z(), position.z()));
+    auto normal = normals.empty() ? fb::Vec3(0, 0, 1) : ToVec3(normals, i);
+    auto tangent = tangents.empty() ? fb::Vec3(1, 0, 0) : ToVec3(tangents, i);
+    auto uv = texture_coords.empty()
+                  ? fb::Vec2(0, 0)
+                  : fb::Vec2(texture_coords[i * 2], texture_coords[i * 2 + 1]);
+    out_mesh.vertices.emplace_back(position, normal, tangent, uv);
+  }
+  if (vertex_count > 0) {
+    out_mesh.bounds = std::make_unique<fb::BoundingBox>(min, max);
+  }
+
+  std::vector<uint32_t> indices;
+  if (primitive.indices >= 0) {
+    if (!ReadIndices(model, primitive.indices, indices)) {
+      FML_LOG(ERROR) << "Primitive of mesh " << out_mesh.name
+                     << " has unreadable indices.";
+      return false;
+    }
+    for (auto index : indices) {
+      if (index >= vertex_count) {
+        FML_LOG(ERROR) << "Primitive of mesh " << out_mesh.name
+                       << " indexes past its vertices.";
+        return false;
+      }
+    }
+  } else {
+    indices.resize(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++) {
+      indices[i] = i;
+    }
+  }
+
+  // Use the narrowest index type that the renderer supports so that the
+  // indices can be uploaded without conversion at runtime.
+  auto out_indices = std::make_unique<fb::IndicesT>();
+  out_indices->count = indices.size();
+  if (vertex_count <= std::numeric_limits<uint16_t>::max()) {
+    out_indices->type = fb::IndexType::k16Bit;
+    out_indices->data.resize(indices.size() * sizeof(uint16_t));
+    for (size_t i = 0; i < indices.size(); i++) {
+      uint16_t index = indices[i];
+      std::memcpy(out_indices->data.data() + i * sizeof(uint16_t), &index,
+                  sizeof(uint16_t));
+    }
+  } else {
+    out_indices->type = fb::IndexType::k32Bit;
+    out_indices->data.resize(indices.size() * sizeof(uint32_t));
+    std::memcpy(out_indices->data.data(), indices.data(),
+                out_indices->data.size());
+  }
+  out_mesh.indices = std::move(out_indices);
+  return true;
+}
+
+bool ParseGLTF(const fml::Mapping& source_mapping,
+               const std::string& base_dir,
+               fb::SceneT& out_scene) {
+  tinygltf::Model model;
+  tinygltf::TinyGLTF loader;
+  // Images aren't imported yet, so don't pay for decoding them.
+  loader.SetImageLoader(
+      [](tinygltf::Image*, const int, std::string*, std::string*, int, int,
+         const unsigned char*, int, void*) { return true; },
+      nullptr);
+
+  std::string error;
+  std::string warning;
+  bool success = false;
+  if (IsGLB(source_mapping)) {
+    success = loader.LoadBinaryFromMemory(
+        &model, &error, &warning, source_mapping.GetMapping(),
+        source_mapping.GetSize(), base_dir);
+  } else {
+    success = loader.LoadASCIIFromString(
+        &model, &error, &warning,
+        reinterpret_cast<const char*>(source_mapping.GetMapping()),
+        source_mapping.GetSize(), base_dir);
+  }
+
+  if (!warning.empty()) {
+    FML_LOG(WARNING) << "glTF: " << warning;
+  }
+  if (!success) {
+    FML_LOG(ERROR) << "Could not parse glTF: " << error;
+    return false;
+  }
+
+  for (const auto& mesh : model.meshes) {
+    for (const auto& primitive : mesh.primitives) {
+      if (primitive.mode != TINYGLTF_MODE_TRIANGLES) {
+        FML_LOG(WARNING) << "Skipping primitive of mesh " << mesh.name
+                         << " that isn't a triangle list.";
+        continue;
+      }
+      auto out_mesh = std::make_unique<fb::MeshT>();
+      out_mesh->name = mesh.name;
+      if (!ProcessPrimitive(model, primitive, *out_mesh)) {
+        return false;
+      }
+      out_scene.meshes.push_back(std::move(out_mesh));
+    }
+  }
+
+  return true;
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <filesystem>
+#include <iostream>
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/scene/importer/importer.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+bool Main(const fml::CommandLine& command_line) {
+  std::string input;
+  if (!command_line.GetOptionValue("input", &input)) {
+    std::cerr << "Input path not specified." << std::endl;
+    return false;
+  }
+
+  std::string output;
+  if (!command_line.GetOptionValue("output", &output)) {
+    std::cerr << "Output path not specified." << std::endl;
+    return false;
+  }
+
+  auto input_path =
+      std::filesystem::absolute(std::filesystem::current_path() / input);
+  auto source = fml::FileMapping::CreateReadOnly(input_path.string());
+  if (!source) {
+    std::cerr << "Could not read input file at path: " << input << std::endl;
+    return false;
+  }
+
+  fb::SceneT scene;
+  if (!ParseGLTF(*source, input_path.parent_path().string(), scene)) {
+    std::cerr << "Could not import glTF at path: " << input << std::endl;
+    return false;
+  }
+
+  auto mapping = CreateSceneMapping(scene);
+  if (!mapping) {
+    std::cerr << "Could not serialize the imported scene." << std::endl;
+    return false;
+  }
+
+  auto current_directory =
+      fml::OpenDirectory(std::filesystem::current_path().string().c_str(),
+                         false, fml::FilePermission::kReadWrite);
+  auto output_path =
+      std::filesystem::absolute(std::filesystem::current_path() / output);
+  if (!fml::WriteAtomically(current_directory, output_path.string().c_str(),
+                            *mapping)) {
+    std::cerr << "Could not write scene to path " << output << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
+
+int main(int argc, char const* argv[]) {
+  return impeller::scene::importer::Main(
+             fml::CommandLineFromPlatformOrArgcArgv(argc, argv))
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/scene/importer/importer.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+namespace testing {
+
+// A single triangle with positions (0, 0, 0), (1, 0, 0) and (0, 2, 0) and
+// unsigned short indices, stored in an embedded buffer.
+static const char* kTriangleGLTF = R"json({
+  "asset": {"version": "2.0"},
+  "buffers": [{
+    "byteLength": 44,
+    "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAAEAAAAAAAAABAAIAAAA="
+  }],
+  "bufferViews": [
+    {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+    {"buffer": 0, "byteOffset": 36, "byteLength": 6}
+  ],
+  "accessors": [
+    {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+     "min": [0, 0, 0], "max": [1, 2, 0]},
+    {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+  ],
+  "meshes": [{
+    "name": "triangle",
+    "primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]
+  }]
+})json";
+
+static fml::NonOwnedMapping MakeMapping(const char* source) {
+  return fml::NonOwnedMapping(reinterpret_cast<const uint8_t*>(source),
+                              std::strlen(source));
+}
+
+TEST(ImporterTest, CanParseTriangleGLTF) {
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(MakeMapping(kTriangleGLTF), "", scene));
+  ASSERT_EQ(scene.meshes.size(), 1u);
+
+  const auto& mesh = *scene.meshes[0];
+  ASSERT_EQ(mesh.name, "triangle");
+  ASSERT_EQ(mesh.vertices.size(), 3u);
+  ASSERT_EQ(mesh.vertices[2].position().y(), 2.0f);
+  // Missing attributes fall back to defaults.
+  ASSERT_EQ(mesh.vertices[0].normal().z(), 1.0f);
+
+  ASSERT_NE(mesh.bounds, nullptr);
+  ASSERT_EQ(mesh.bounds->min().x(), 0.0f);
+  ASSERT_EQ(mesh.bounds->max().x(), 1.0f);
+  ASSERT_EQ(mesh.bounds->max().y(), 2.0f);
+
+  ASSERT_NE(mesh.indices, nullptr);
+  ASSERT_EQ(mesh.indices->type, fb::IndexType::k16Bit);
+  ASSERT_EQ(mesh.indices->count, 3u);
+  ASSERT_EQ(mesh.indices->data.size(), 3 * sizeof(uint16_t));
+}
+
+TEST(ImporterTest, SerializedSceneCanBeReadInPlace) {
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(MakeMapping(kTriangleGLTF), "", scene));
+  auto mapping = CreateSceneMapping(scene);
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_TRUE(fb::SceneBufferHasIdentifier(mapping->GetMapping()));
+
+  const auto* meshes = fb::GetScene(mapping->GetMapping())->meshes();
+  ASSERT_NE(meshes, nullptr);
+  ASSERT_EQ(meshes->size(), 1u);
+  // Vertices are a contiguous array of structs that can be uploaded as-is.
+  const auto* vertices = meshes->Get(0)->vertices();
+  ASSERT_EQ(vertices->size(), 3u);
+  ASSERT_EQ(reinterpret_cast<const uint8_t*>(vertices->Get(1)) -
+                reinterpret_cast<const uint8_t*>(vertices->Get(0)),
+            static_cast<ptrdiff_t>(sizeof(fb::Vertex)));
+}
+
+TEST(ImporterTest, RejectsInvalidGLTF) {
+  fb::SceneT scene;
+  ASSERT_FALSE(ParseGLTF(MakeMapping("not a glTF"), "", scene));
+  ASSERT_TRUE(scene.meshes.empty());
+}
+
+TEST(ImporterTest, ResolvesExternalBuffersRelativeToTheBaseDirectory) {
+  fml::ScopedTemporaryDirectory base_dir;
+  // The same contents as the embedded buffer of |kTriangleGLTF|, including
+  // the padding after the indices.
+  const float positions[] = {0, 0, 0, 1, 0, 0, 0, 2, 0};
+  const uint16_t indices[] = {0, 1, 2, 0};
+  std::vector<uint8_t> buffer(sizeof(positions) + sizeof(indices));
+  std::memcpy(buffer.data(), positions, sizeof(positions));
+  std::memcpy(buffer.data() + sizeof(positions), indices, sizeof(indices));
+  ASSERT_TRUE(fml::WriteAtomically(
+      base_dir.fd(), "triangle.bin",
+      fml::NonOwnedMapping(buffer.data(), buffer.size())));
+
+  std::string gltf = kTriangleGLTF;
+  const size_t uri_begin = gltf.find("data:");
+  ASSERT_NE(uri_begin, std::string::npos);
+  gltf.replace(uri_begin, gltf.find('"', uri_begin) - uri_begin,
+               "triangle.bin");
+
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(MakeMapping(gltf.c_str()), base_dir.path(), scene));
+  ASSERT_EQ(scene.meshes.size(), 1u);
+  ASSERT_EQ(scene.meshes[0]->vertices[2].position().y(), 2.0f);
+  ASSERT_EQ(scene.meshes[0]->indices->count, 3u);
+}
+
+}  // namespace testing
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
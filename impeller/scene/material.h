@@ -45,6 +45,8 @@ class Material {
 
   void SetTranslucent(bool is_translucent);
 
+  bool IsTranslucent() const;
+
   virtual std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
       const SceneContext& scene_context,
       const RenderPass& pass) const = 0;
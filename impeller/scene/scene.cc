@@ -25,7 +25,8 @@ void Scene::Add(const std::shared_ptr<SceneEntity>& child) {
 bool Scene::Render(const RenderTarget& render_target,
                    const Camera& camera) const {
   // Collect the render commands from the scene.
-  SceneEncoder encoder;
+  SceneEncoder encoder(
+      camera.GetTransform(render_target.GetRenderTargetSize()));
   if (!root_.Render(encoder, camera)) {
     FML_LOG(ERROR) << "Failed to render frame.";
     return false;
@@ -4,6 +4,9 @@
 
 #include "flutter/fml/macros.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "flutter/fml/logging.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
@@ -14,35 +17,122 @@
 namespace impeller {
 namespace scene {
 
-SceneEncoder::SceneEncoder() = default;
+SceneEncoder::SceneEncoder(Matrix view_transform)
+    : view_transform_(view_transform) {}
 
 void SceneEncoder::Add(const SceneCommand& command) {
-  // TODO(bdero): Manage multi-pass translucency ordering.
+  if (!command.geometry || !command.material) {
+    return;
+  }
   commands_.push_back(command);
 }
 
-static void EncodeCommand(const SceneContext& scene_context,
-                          RenderPass& render_pass,
-                          const SceneCommand& scene_command) {
+bool SceneEncoder::IsCulled(const AABB& bounds, const Matrix& transform) const {
+  return bounds.IsOutsideClipVolume(view_transform_ * transform);
+}
+
+std::vector<SceneBatch> SceneEncoder::BuildBatches() const {
+  struct SortEntry {
+    const SceneCommand* command;
+    // The distance from the camera along its view direction.
+    Scalar depth;
+  };
+
+  std::vector<SortEntry> opaque;
+  std::vector<SortEntry> translucent;
+  for (const auto& command : commands_) {
+    Vector4 center = view_transform_ * command.transform *
+                     Vector4(command.geometry->GetBounds().GetCenter());
+    auto& entries = command.material->IsTranslucent() ? translucent : opaque;
+    entries.push_back({&command, center.w});
+  }
+
+  std::sort(opaque.begin(), opaque.end(),
+            [](const SortEntry& a, const SortEntry& b) {
+              const SceneCommand& lhs = *a.command;
+              const SceneCommand& rhs = *b.command;
+              if (lhs.material != rhs.material) {
+                return std::less<Material*>()(lhs.material, rhs.material);
+              }
+              if (lhs.geometry != rhs.geometry) {
+                return std::less<Geometry*>()(lhs.geometry, rhs.geometry);
+              }
+              return a.depth < b.depth;
+            });
+  std::stable_sort(translucent.begin(), translucent.end(),
+                   [](const SortEntry& a, const SortEntry& b) {
+                     return a.depth > b.depth;
+                   });
+
+  // Merges runs of entries with the same material and geometry. Returns the
+  // depth of the first entry of every batch.
+  auto append_batches = [](const std::vector<SortEntry>& entries,
+                           std::vector<SceneBatch>& batches) {
+    std::vector<Scalar> depths;
+    for (const auto& entry : entries) {
+      const SceneCommand& command = *entry.command;
+      if (batches.empty() || batches.back().material != command.material ||
+          batches.back().geometry != command.geometry) {
+        batches.push_back({
+            .label = command.label,
+            .geometry = command.geometry,
+            .material = command.material,
+        });
+        depths.push_back(entry.depth);
+      }
+      batches.back().transforms.push_back(command.transform);
+    }
+    return depths;
+  };
+
+  std::vector<SceneBatch> opaque_batches;
+  auto opaque_depths = append_batches(opaque, opaque_batches);
+
+  // Instances are sorted front to back within each batch, so the depth of
+  // the first instance is the nearest one.
+  std::vector<size_t> order(opaque_batches.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return opaque_depths[a] < opaque_depths[b];
+  });
+
+  std::vector<SceneBatch> batches;
+  batches.reserve(opaque_batches.size());
+  for (auto index : order) {
+    batches.push_back(std::move(opaque_batches[index]));
+  }
+  append_batches(translucent, batches);
+  return batches;
+}
+
+static void EncodeBatch(const SceneContext& scene_context,
+                        RenderPass& render_pass,
+                        const Matrix& view_transform,
+                        const SceneBatch& batch) {
   auto& host_buffer = render_pass.GetTransientsBuffer();
 
   Command cmd;
-  cmd.label = scene_command.label;
+  cmd.label = batch.label;
   cmd.stencil_reference =
       0;  // TODO(bdero): Configurable stencil ref per-command.
 
-  cmd.BindVertices(scene_command.geometry->GetVertexBuffer(
+  cmd.BindVertices(batch.geometry->GetVertexBuffer(
       *scene_context.GetContext()->GetResourceAllocator()));
 
-  cmd.pipeline =
-      scene_command.material->GetPipeline(scene_context, render_pass);
-  scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
-
-  GeometryVertexShader::VertInfo info;
-  info.mvp = scene_command.transform;
-  GeometryVertexShader::BindVertInfo(cmd, host_buffer.EmplaceUniform(info));
-
-  render_pass.AddCommand(std::move(cmd));
+  cmd.pipeline = batch.material->GetPipeline(scene_context, render_pass);
+  batch.material->BindToCommand(scene_context, host_buffer, cmd);
+
+  // The instances only differ in their transform.
+  for (const auto& transform : batch.transforms) {
+    Command instance = cmd;
+    GeometryVertexShader::VertInfo info;
+    info.mvp = view_transform * transform;
+    GeometryVertexShader::BindVertInfo(instance,
+                                       host_buffer.EmplaceUniform(info));
+    render_pass.AddCommand(std::move(instance));
+  }
 }
 
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
@@ -60,8 +150,8 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, *render_pass, command);
+  for (const auto& batch : BuildBatches()) {
+    EncodeBatch(scene_context, *render_pass, view_transform_, batch);
   }
 
   if (!render_pass->EncodeCommands()) {
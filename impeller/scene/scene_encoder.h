@@ -10,6 +10,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/scene/aabb.h"
 #include "impeller/scene/geometry.h"
 #include "impeller/scene/material.h"
 
@@ -25,17 +26,41 @@ struct SceneCommand {
   Material* material;
 };
 
+/// Draws of the same geometry with the same material that are encoded
+/// together, sharing their vertex buffer, pipeline and material bindings.
+struct SceneBatch {
+  std::string label;
+  Geometry* geometry;
+  Material* material;
+  std::vector<Matrix> transforms;
+};
+
 class SceneEncoder {
  public:
+  /// @param[in]  view_transform  The view projection of the camera that the
+  ///                             scene is rendered with.
+  explicit SceneEncoder(Matrix view_transform);
+
   void Add(const SceneCommand& command);
 
- private:
-  SceneEncoder();
+  /// Whether the bounds, transformed by the given model transform, lie
+  /// entirely outside of the view frustum.
+  bool IsCulled(const AABB& bounds, const Matrix& transform) const;
 
+  /// Sort the commands and group the ones that can be drawn together.
+  ///
+  /// Opaque commands are grouped by material and geometry, and the groups are
+  /// ordered front to back by their nearest instance. Translucent commands
+  /// are drawn after them back to front, and are only grouped with commands
+  /// they are adjacent to in that order.
+  std::vector<SceneBatch> BuildBatches() const;
+
+ private:
   std::shared_ptr<CommandBuffer> BuildSceneCommandBuffer(
       const SceneContext& scene_context,
       const RenderTarget& render_target) const;
 
+  Matrix view_transform_;
   std::vector<SceneCommand> commands_;
 
   friend Scene;
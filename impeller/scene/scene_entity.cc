@@ -56,16 +56,50 @@ bool SceneEntity::Add(const std::shared_ptr<SceneEntity>& child) {
   return true;
 }
 
+std::optional<AABB> SceneEntity::GetBounds() const {
+  bounds_ = GetLocalBounds();
+  for (auto& child : children_) {
+    auto child_bounds = child->GetBounds();
+    if (!child_bounds.has_value()) {
+      continue;
+    }
+    auto bounds = child_bounds->TransformBounds(child->local_transform_);
+    bounds_ = bounds_.has_value() ? bounds_->Union(bounds) : bounds;
+  }
+  return bounds_;
+}
+
 bool SceneEntity::Render(SceneEncoder& encoder, const Camera& camera) const {
+  // Compute the bounds of every subtree once up front rather than once for
+  // every level of the hierarchy they are tested at.
+  GetBounds();
+  return RenderSubtree(encoder, camera, GetGlobalTransform());
+}
+
+bool SceneEntity::RenderSubtree(SceneEncoder& encoder,
+                                const Camera& camera,
+                                const Matrix& global_transform) const {
+  if (!bounds_.has_value()) {
+    // Nothing in this subtree draws.
+    return true;
+  }
+  if (encoder.IsCulled(bounds_.value(), global_transform)) {
+    return true;
+  }
   OnRender(encoder, camera);
   for (auto& child : children_) {
-    if (!child->Render(encoder, camera)) {
+    if (!child->RenderSubtree(encoder, camera,
+                              global_transform * child->local_transform_)) {
       return false;
     }
   }
   return true;
 }
 
+std::optional<AABB> SceneEntity::GetLocalBounds() const {
+  return std::nullopt;
+}
+
 bool SceneEntity::OnRender(SceneEncoder& encoder, const Camera& camera) const {
   return true;
 }
@@ -5,12 +5,14 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 
 #include "impeller/geometry/matrix.h"
 #include "impeller/renderer/render_target.h"
+#include "impeller/scene/aabb.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/scene_encoder.h"
 
@@ -34,16 +36,38 @@ class SceneEntity {
 
   bool Add(const std::shared_ptr<SceneEntity>& child);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of everything this entity and its descendants
+  ///             draw, in the coordinate space the entity draws in (that is,
+  ///             the space its global transform applies to). Returns nullopt
+  ///             if nothing in the subtree draws.
+  ///
+  std::optional<AABB> GetBounds() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the commands of this entity and its descendants to the
+  ///             encoder, skipping every subtree whose bounds are outside of
+  ///             the view frustum of the encoder.
+  ///
   bool Render(SceneEncoder& encoder, const Camera& camera) const;
 
  protected:
   Matrix local_transform_;
 
  private:
+  /// The bounds of what this entity draws itself, excluding its children.
+  virtual std::optional<AABB> GetLocalBounds() const;
+
   virtual bool OnRender(SceneEncoder& encoder, const Camera& camera) const;
 
+  bool RenderSubtree(SceneEncoder& encoder,
+                     const Camera& camera,
+                     const Matrix& global_transform) const;
+
   SceneEntity* parent_ = nullptr;
   std::vector<std::shared_ptr<SceneEntity>> children_;
+  // The result of the last call to |GetBounds|.
+  mutable std::optional<AABB> bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SceneEntity);
 };
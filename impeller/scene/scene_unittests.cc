@@ -12,8 +12,10 @@
 
 #include "impeller/scene/camera.h"
 #include "impeller/scene/geometry.h"
+#include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/material.h"
 #include "impeller/scene/scene.h"
+#include "impeller/scene/scene_encoder.h"
 #include "impeller/scene/static_mesh_entity.h"
 
 // #include "third_party/tinygltf/tiny_gltf.h"
@@ -59,6 +61,125 @@ TEST_P(SceneTest, CuboidUnlit) {
   OpenPlaygroundHere(callback);
 }
 
+static Camera MakeTestCamera() {
+  return Camera::MakePerspective(kPiOver4, {0, 0, -10}).LookAt(Vector3());
+}
+
+static Matrix MakeTestViewTransform() {
+  return MakeTestCamera().GetTransform(ISize(100, 100));
+}
+
+static std::shared_ptr<StaticMeshEntity> MakeMesh(
+    const std::shared_ptr<Geometry>& geometry,
+    const std::shared_ptr<Material>& material,
+    Vector3 position) {
+  auto mesh = SceneEntity::MakeStaticMesh();
+  mesh->SetGeometry(geometry);
+  mesh->SetMaterial(material);
+  mesh->SetLocalTransform(Matrix::MakeTranslation(position));
+  return mesh;
+}
+
+TEST(SceneEncoderTest, CullsEntitiesOutsideOfTheViewFrustum) {
+  std::shared_ptr<Geometry> geometry = Geometry::MakeCuboid({1, 1, 1});
+  std::shared_ptr<Material> material = Material::MakeUnlit();
+
+  SceneEntity root;
+  root.Add(MakeMesh(geometry, material, {0, 0, 0}));
+  // To the side of and behind the camera.
+  root.Add(MakeMesh(geometry, material, {1000, 0, 0}));
+  root.Add(MakeMesh(geometry, material, {0, 0, -20}));
+  // A group that is culled as a whole.
+  auto group = std::make_shared<SceneEntity>();
+  group->SetLocalTransform(Matrix::MakeTranslation({0, 1000, 0}));
+  group->Add(MakeMesh(geometry, material, {0, 0, 0}));
+  group->Add(MakeMesh(geometry, material, {1, 0, 0}));
+  root.Add(group);
+
+  SceneEncoder encoder(MakeTestViewTransform());
+  ASSERT_TRUE(root.Render(encoder, MakeTestCamera()));
+
+  auto batches = encoder.BuildBatches();
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].transforms.size(), 1u);
+  ASSERT_EQ(batches[0].transforms[0], Matrix());
+}
+
+TEST(SceneEncoderTest, BatchesAndSortsCommands) {
+  std::shared_ptr<Geometry> geometry = Geometry::MakeCuboid({1, 1, 1});
+  std::shared_ptr<Material> opaque_a = Material::MakeUnlit();
+  std::shared_ptr<Material> opaque_b = Material::MakeUnlit();
+  std::shared_ptr<Material> translucent = Material::MakeUnlit();
+  translucent->SetTranslucent(true);
+
+  auto add = [&](SceneEncoder& encoder, Material* material, Scalar z) {
+    encoder.Add({
+        .label = "Mesh",
+        .transform = Matrix::MakeTranslation({0, 0, z}),
+        .geometry = geometry.get(),
+        .material = material,
+    });
+  };
+
+  SceneEncoder encoder(MakeTestViewTransform());
+  add(encoder, translucent.get(), -5);
+  add(encoder, opaque_a.get(), 5);
+  add(encoder, opaque_b.get(), -5);
+  add(encoder, translucent.get(), 5);
+  add(encoder, opaque_a.get(), -2);
+
+  auto batches = encoder.BuildBatches();
+  ASSERT_EQ(batches.size(), 3u);
+
+  // Opaque batches are ordered front to back by their nearest instance.
+  ASSERT_EQ(batches[0].material, opaque_b.get());
+  ASSERT_EQ(batches[0].transforms.size(), 1u);
+  ASSERT_EQ(batches[1].material, opaque_a.get());
+  ASSERT_EQ(batches[1].transforms.size(), 2u);
+  ASSERT_EQ(batches[1].transforms[0].m[14], -2);
+  ASSERT_EQ(batches[1].transforms[1].m[14], 5);
+
+  // Translucent instances are drawn last, back to front.
+  ASSERT_EQ(batches[2].material, translucent.get());
+  ASSERT_EQ(batches[2].transforms.size(), 2u);
+  ASSERT_EQ(batches[2].transforms[0].m[14], 5);
+  ASSERT_EQ(batches[2].transforms[1].m[14], -5);
+}
+
+TEST(GeometryTest, CanReadImportedMeshesInPlace) {
+  fb::SceneT scene;
+  auto mesh = std::make_unique<fb::MeshT>();
+  mesh->vertices = {
+      fb::Vertex(fb::Vec3(0, 0, 0), fb::Vec3(0, 0, 1), fb::Vec3(1, 0, 0),
+                 fb::Vec2(0, 0)),
+      fb::Vertex(fb::Vec3(1, 2, 3), fb::Vec3(0, 0, 1), fb::Vec3(1, 0, 0),
+                 fb::Vec2(1, 1)),
+  };
+  mesh->bounds = std::make_unique<fb::BoundingBox>(fb::Vec3(0, 0, 0),
+                                                   fb::Vec3(1, 2, 3));
+  mesh->indices = std::make_unique<fb::IndicesT>();
+  mesh->indices->count = 2;
+  mesh->indices->type = fb::IndexType::k16Bit;
+  mesh->indices->data = {0, 0, 1, 0};
+  scene.meshes.push_back(std::move(mesh));
+
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  builder->Finish(fb::Scene::Pack(*builder, &scene), fb::SceneIdentifier());
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      builder->GetBufferPointer(), builder->GetSize(),
+      [builder](auto, auto) {});
+
+  auto geometry = Geometry::MakeFromFlatbuffer(mapping);
+  ASSERT_NE(geometry, nullptr);
+  ASSERT_EQ(geometry->GetBounds().max, Vector3(1, 2, 3));
+  ASSERT_EQ(Geometry::MakeFromFlatbuffer(mapping, 1), nullptr);
+
+  std::vector<uint8_t> garbage(64, 0);
+  ASSERT_EQ(Geometry::MakeFromFlatbuffer(std::make_shared<fml::NonOwnedMapping>(
+                garbage.data(), garbage.size())),
+            nullptr);
+}
+
 }  // namespace testing
 }  // namespace scene
 }  // namespace impeller
@@ -23,6 +23,14 @@ void StaticMeshEntity::SetMaterial(std::shared_ptr<Material> material) {
   material_ = std::move(material);
 }
 
+// |SceneEntity|
+std::optional<AABB> StaticMeshEntity::GetLocalBounds() const {
+  if (!geometry_) {
+    return std::nullopt;
+  }
+  return geometry_->GetBounds();
+}
+
 // |SceneEntity|
 bool StaticMeshEntity::OnRender(SceneEncoder& encoder,
                                 const Camera& camera) const {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "flutter/fml/macros.h"
@@ -24,6 +25,9 @@ class StaticMeshEntity final : public SceneEntity {
   void SetMaterial(std::shared_ptr<Material> material);
 
  private:
+  // |SceneEntity|
+  std::optional<AABB> GetLocalBounds() const override;
+
   // |SceneEntity|
   bool OnRender(SceneEncoder& encoder, const Camera& camera) const override;
 
@@ -29,6 +29,7 @@
 #include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
+#include "flutter/lib/ui/painting/progressive_codec.h"
 #include "flutter/lib/ui/painting/vertices.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
@@ -76,6 +77,7 @@ typedef CanvasPath Path;
   V(PathMeasure::Create, 3)                                           \
   V(Path::Create, 1)                                                  \
   V(PictureRecorder::Create, 1)                                       \
+  V(ProgressiveCodec::Create, 1)                                      \
   V(SceneBuilder::Create, 1)                                          \
   V(SemanticsUpdateBuilder::Create, 1)                                \
   /* Other */                                                         \
@@ -135,6 +137,7 @@ typedef CanvasPath Path;
   V(Canvas, drawAtlas, 10)                             \
   V(Canvas, drawCircle, 6)                             \
   V(Canvas, drawColor, 3)                              \
+  V(Canvas, drawCommands, 4)                           \
   V(Canvas, drawDRRect, 5)                             \
   V(Canvas, drawImage, 7)                              \
   V(Canvas, drawImageNine, 13)                         \
@@ -264,6 +267,9 @@ typedef CanvasPath Path;
   V(Picture, dispose, 1)                               \
   V(Picture, toImage, 4)                               \
   V(Picture, toImageSync, 4)                           \
+  V(ProgressiveCodec, addChunk, 2)                     \
+  V(ProgressiveCodec, finish, 1)                       \
+  V(ProgressiveCodec, isComplete, 1)                   \
   V(SceneBuilder, addPerformanceOverlay, 6)            \
   V(SceneBuilder, addPicture, 5)                       \
   V(SceneBuilder, addPlatformView, 6)                  \
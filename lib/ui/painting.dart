@@ -1622,6 +1622,22 @@ enum ImageByteFormat {
   ///  * <https://en.wikipedia.org/wiki/Portable_Network_Graphics>, the Wikipedia page on PNG.
   ///  * <https://tools.ietf.org/rfc/rfc2083.txt>, the PNG standard.
   png,
+
+  /// QOI format.
+  ///
+  /// The "Quite OK Image" format. A loss-less compression format that encodes
+  /// several times faster than [png], at the cost of somewhat larger output.
+  /// This format is well suited for screenshots and other captures that are
+  /// written out or sent elsewhere rather than stored long term.
+  /// Transparency is supported, and pixels are encoded with straight alpha.
+  ///
+  /// This format is not supported on the web, where [Image.toByteData]
+  /// completes with an [UnsupportedError] when it is requested.
+  ///
+  /// See also:
+  ///
+  ///  * <https://qoiformat.org/>, the QOI specification.
+  qoi,
 }
 
 /// The format of pixel data given to [decodeImageFromPixels].
@@ -2063,6 +2079,47 @@ class Codec extends NativeFieldWrapperClass1 {
   external void dispose();
 }
 
+/// A [Codec] for encoded image data that arrives in chunks, such as a large
+/// image read from storage or the network.
+///
+/// The data is decoded on a background thread as the chunks are added. For
+/// formats that support it, such as interlaced PNG and progressive JPEG, the
+/// partially decoded image is available before all of the data has arrived.
+///
+/// [getNextFrame] completes with the newest frame of the image that it has
+/// not returned yet, waiting for one to be decoded if necessary. Once it has
+/// returned the fully decoded image, [isComplete] is true and every later call
+/// returns that image again.
+@pragma('vm:entry-point')
+class ProgressiveCodec extends Codec {
+  /// Creates a codec that decodes the chunks passed to [addChunk].
+  @pragma('vm:entry-point')
+  ProgressiveCodec() : super._() {
+    _constructor();
+  }
+
+  @FfiNative<Void Function(Handle)>('ProgressiveCodec::Create')
+  external void _constructor();
+
+  /// Adds the next chunk of the encoded image data.
+  ///
+  /// Chunks added after [finish] are ignored.
+  @FfiNative<Void Function(Pointer<Void>, Handle)>('ProgressiveCodec::addChunk')
+  external void addChunk(Uint8List chunk);
+
+  /// Signals that all of the encoded image data has been added.
+  ///
+  /// If the data is truncated, the final frame contains the part of the image
+  /// that could be decoded.
+  @FfiNative<Void Function(Pointer<Void>)>('ProgressiveCodec::finish')
+  external void finish();
+
+  /// Whether the last frame returned by [getNextFrame] is the fully decoded
+  /// image.
+  @FfiNative<Bool Function(Pointer<Void>)>('ProgressiveCodec::isComplete', isLeaf: true)
+  external bool get isComplete;
+}
+
 /// Instantiates an image [Codec].
 ///
 /// This method is a convenience wrapper around the [ImageDescriptor] API, and
@@ -5730,6 +5787,30 @@ class Canvas extends NativeFieldWrapperClass1 {
       int blendMode,
       Float32List? cullRect);
 
+  /// Draws the commands recorded in the given [CanvasCommandBuffer], as if
+  /// the corresponding methods of this canvas had been called in order.
+  ///
+  /// The commands are transferred to the engine in a single call, which is
+  /// much cheaper than calling a method of this canvas for each of them when
+  /// drawing many primitives.
+  void drawCommands(CanvasCommandBuffer commands) {
+    assert(commands != null);
+    if (commands.isEmpty) {
+      return;
+    }
+    final String? error = _drawCommands(
+      commands._paintObjects,
+      ByteData.sublistView(commands._paintData, 0, commands._paintCount * Paint._kDataByteCount),
+      Float32List.sublistView(commands._commands, 0, commands._length),
+    );
+    if (error != null) {
+      throw ArgumentError(error);
+    }
+  }
+
+  @FfiNative<Handle Function(Pointer<Void>, Handle, Handle, Handle)>('Canvas::drawCommands')
+  external String? _drawCommands(List<Object?> paintObjects, ByteData paintData, Float32List commands);
+
   /// Draws a shadow for a [Path] representing the given material elevation.
   ///
   /// The `transparentOccluder` argument should be true if the occluding object
@@ -5747,6 +5828,228 @@ class Canvas extends NativeFieldWrapperClass1 {
   external void _drawShadow(Path path, int color, double elevation, bool transparentOccluder);
 }
 
+/// A list of drawing commands that is recorded without calling into the
+/// engine, and later drawn into a [Canvas] with [Canvas.drawCommands].
+///
+/// Every [Canvas] method is a separate call into the engine, and every
+/// method that takes a [Paint] transfers the whole paint. When drawing tens
+/// of thousands of primitives, for example in a chart, the cost of those
+/// calls can exceed the cost of recording the primitives themselves. A
+/// [CanvasCommandBuffer] instead packs the commands into typed data that is
+/// transferred in a single call. Consecutive commands that use equal paints
+/// share a single copy of the paint.
+///
+/// The paints are copied when a command is recorded, so changing a [Paint]
+/// afterwards does not affect commands that were already recorded. A buffer
+/// can be drawn any number of times, and can be reused by calling [clear].
+class CanvasCommandBuffer {
+  /// Creates an empty command buffer.
+  CanvasCommandBuffer();
+
+  // Opcodes. Must be kept in sync with CanvasCommand in
+  // lib/ui/painting/canvas_command_buffer.h.
+  static const int _kSave = 0;
+  static const int _kRestore = 1;
+  static const int _kTranslate = 2;
+  static const int _kScale = 3;
+  static const int _kRotate = 4;
+  static const int _kClipRect = 5;
+  static const int _kSetPaint = 6;
+  static const int _kDrawLine = 7;
+  static const int _kDrawRect = 8;
+  static const int _kDrawRRect = 9;
+  static const int _kDrawOval = 10;
+  static const int _kDrawCircle = 11;
+  static const int _kDrawArc = 12;
+
+  Float32List _commands = Float32List(64);
+  int _length = 0;
+
+  // Three objects and _kDataByteCount bytes of data per recorded paint, in the
+  // same layout as [Paint].
+  final List<Object?> _paintObjects = <Object?>[];
+  ByteData _paintData = ByteData(Paint._kDataByteCount * 4);
+  int _paintCount = 0;
+
+  /// Whether no commands have been recorded since the buffer was created or
+  /// last cleared.
+  bool get isEmpty => _length == 0;
+
+  /// Removes all recorded commands.
+  void clear() {
+    _length = 0;
+    _paintObjects.clear();
+    _paintCount = 0;
+  }
+
+  void _reserve(int count) {
+    if (_length + count <= _commands.length) {
+      return;
+    }
+    int capacity = _commands.length * 2;
+    while (capacity < _length + count) {
+      capacity *= 2;
+    }
+    _commands = Float32List(capacity)..setRange(0, _length, _commands);
+  }
+
+  void _addOp(int op, int argumentCount) {
+    _reserve(argumentCount + 1);
+    _commands[_length++] = op.toDouble();
+  }
+
+  void _add(double value) {
+    _commands[_length++] = value;
+  }
+
+  void _addRect(Rect rect) {
+    _add(rect.left);
+    _add(rect.top);
+    _add(rect.right);
+    _add(rect.bottom);
+  }
+
+  bool _isCurrentPaint(Paint paint) {
+    if (_paintCount == 0) {
+      return false;
+    }
+    final int objectOffset = (_paintCount - 1) * Paint._kObjectCount;
+    final List<Object?>? objects = paint._objects;
+    for (int i = 0; i < Paint._kObjectCount; i++) {
+      if (!identical(_paintObjects[objectOffset + i], objects?[i])) {
+        return false;
+      }
+    }
+    final int dataOffset = (_paintCount - 1) * Paint._kDataByteCount;
+    for (int i = 0; i < Paint._kDataByteCount; i += 4) {
+      if (_paintData.getUint32(dataOffset + i, _kFakeHostEndian) != paint._data.getUint32(i, _kFakeHostEndian)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void _usePaint(Paint paint) {
+    assert(paint != null);
+    if (_isCurrentPaint(paint)) {
+      return;
+    }
+    final int dataOffset = _paintCount * Paint._kDataByteCount;
+    if (dataOffset + Paint._kDataByteCount > _paintData.lengthInBytes) {
+      final ByteData grown = ByteData(_paintData.lengthInBytes * 2);
+      Uint8List.sublistView(grown).setRange(0, dataOffset, Uint8List.sublistView(_paintData));
+      _paintData = grown;
+    }
+    Uint8List.sublistView(_paintData, dataOffset, dataOffset + Paint._kDataByteCount)
+        .setAll(0, Uint8List.sublistView(paint._data));
+    final List<Object?>? objects = paint._objects;
+    for (int i = 0; i < Paint._kObjectCount; i++) {
+      _paintObjects.add(objects?[i]);
+    }
+    _addOp(_kSetPaint, 1);
+    _add(_paintCount.toDouble());
+    _paintCount++;
+  }
+
+  /// Records a call to [Canvas.save].
+  void save() => _addOp(_kSave, 0);
+
+  /// Records a call to [Canvas.restore].
+  void restore() => _addOp(_kRestore, 0);
+
+  /// Records a call to [Canvas.translate].
+  void translate(double dx, double dy) {
+    _addOp(_kTranslate, 2);
+    _add(dx);
+    _add(dy);
+  }
+
+  /// Records a call to [Canvas.scale].
+  void scale(double sx, [double? sy]) {
+    _addOp(_kScale, 2);
+    _add(sx);
+    _add(sy ?? sx);
+  }
+
+  /// Records a call to [Canvas.rotate].
+  void rotate(double radians) {
+    _addOp(_kRotate, 1);
+    _add(radians);
+  }
+
+  /// Records a call to [Canvas.clipRect].
+  void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
+    assert(_rectIsValid(rect));
+    assert(clipOp != null);
+    assert(doAntiAlias != null);
+    _addOp(_kClipRect, 6);
+    _addRect(rect);
+    _add(clipOp.index.toDouble());
+    _add(doAntiAlias ? 1.0 : 0.0);
+  }
+
+  /// Records a call to [Canvas.drawLine].
+  void drawLine(Offset p1, Offset p2, Paint paint) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    _usePaint(paint);
+    _addOp(_kDrawLine, 4);
+    _add(p1.dx);
+    _add(p1.dy);
+    _add(p2.dx);
+    _add(p2.dy);
+  }
+
+  /// Records a call to [Canvas.drawRect].
+  void drawRect(Rect rect, Paint paint) {
+    assert(_rectIsValid(rect));
+    _usePaint(paint);
+    _addOp(_kDrawRect, 4);
+    _addRect(rect);
+  }
+
+  /// Records a call to [Canvas.drawRRect].
+  void drawRRect(RRect rrect, Paint paint) {
+    assert(_rrectIsValid(rrect));
+    _usePaint(paint);
+    _addOp(_kDrawRRect, 12);
+    final Float32List values = rrect._getValue32();
+    for (int i = 0; i < 12; i++) {
+      _add(values[i]);
+    }
+  }
+
+  /// Records a call to [Canvas.drawOval].
+  void drawOval(Rect rect, Paint paint) {
+    assert(_rectIsValid(rect));
+    _usePaint(paint);
+    _addOp(_kDrawOval, 4);
+    _addRect(rect);
+  }
+
+  /// Records a call to [Canvas.drawCircle].
+  void drawCircle(Offset c, double radius, Paint paint) {
+    assert(_offsetIsValid(c));
+    _usePaint(paint);
+    _addOp(_kDrawCircle, 3);
+    _add(c.dx);
+    _add(c.dy);
+    _add(radius);
+  }
+
+  /// Records a call to [Canvas.drawArc].
+  void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
+    assert(_rectIsValid(rect));
+    assert(useCenter != null);
+    _usePaint(paint);
+    _addOp(_kDrawArc, 7);
+    _addRect(rect);
+    _add(startAngle);
+    _add(sweepAngle);
+    _add(useCenter ? 1.0 : 0.0);
+  }
+}
+
 /// Signature for [Picture] lifecycle events.
 typedef PictureEventCallback = void Function(Picture picture);
 
@@ -11,6 +11,7 @@
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_canvas_dispatcher.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/lib/ui/painting/canvas_command_buffer.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
 #include "flutter/lib/ui/painting/paint.h"
@@ -24,6 +25,7 @@
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 #include "flutter/fml/logging.h"
 
@@ -598,6 +600,51 @@ Dart_Handle Canvas::drawAtlas(Dart_Handle paint_objects,
   return Dart_Null();
 }
 
+Dart_Handle Canvas::drawCommands(Dart_Handle paint_objects,
+                                 Dart_Handle paint_data,
+                                 Dart_Handle commands_handle) {
+  if (!display_list_recorder_) {
+    return Dart_Null();
+  }
+  TRACE_EVENT0("flutter", "ui.Canvas::drawCommands");
+
+  // The paint objects must be unwrapped before any typed data is acquired.
+  intptr_t object_count = 0;
+  if (Dart_IsError(Dart_ListLength(paint_objects, &object_count)) ||
+      object_count % Paint::kObjectCount != 0) {
+    return ToDart("Canvas.drawCommands called with malformed paints.");
+  }
+  std::vector<Dart_Handle> values(object_count);
+  if (object_count > 0 &&
+      Dart_IsError(Dart_ListGetRange(paint_objects, 0, object_count,
+                                     values.data()))) {
+    return ToDart("Canvas.drawCommands called with malformed paints.");
+  }
+  std::vector<Paint::Objects> objects;
+  objects.reserve(object_count / Paint::kObjectCount);
+  for (intptr_t i = 0; i < object_count; i += Paint::kObjectCount) {
+    objects.push_back(Paint::UnwrapObjects(&values[i]));
+  }
+
+  std::optional<std::string> error;
+  {
+    tonic::DartByteData data(paint_data);
+    tonic::Float32List commands(commands_handle);
+    if (data.length_in_bytes() != objects.size() * Paint::kDataByteCount) {
+      error = "Canvas.drawCommands called with malformed paints.";
+    } else {
+      error = ReplayCanvasCommands(
+          builder(), commands.data(), commands.num_elements(), objects,
+          static_cast<const uint8_t*>(data.data()));
+    }
+  }
+  // Only create the message once the typed data has been released.
+  if (error.has_value()) {
+    return ToDart(error.value());
+  }
+  return Dart_Null();
+}
+
 void Canvas::drawShadow(const CanvasPath* path,
                         SkColor color,
                         double elevation,
@@ -182,6 +182,12 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                         DlBlendMode blend_mode,
                         Dart_Handle cull_rect_handle);
 
+  // Replays the commands of a Dart CanvasCommandBuffer. Returns an error
+  // message if the commands are malformed, or null.
+  Dart_Handle drawCommands(Dart_Handle paint_objects,
+                           Dart_Handle paint_data,
+                           Dart_Handle commands_handle);
+
   void drawShadow(const CanvasPath* path,
                   SkColor color,
                   double elevation,
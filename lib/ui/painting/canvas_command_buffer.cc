@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/canvas_command_buffer.h"
+
+#include <cmath>
+#include <iterator>
+#include <sstream>
+
+#include "flutter/display_list/display_list_flags.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// The number of arguments that follow each opcode.
+static constexpr size_t kArgumentCounts[] = {
+    0,   // kSave
+    0,   // kRestore
+    2,   // kTranslate
+    2,   // kScale
+    1,   // kRotate
+    6,   // kClipRect
+    1,   // kSetPaint
+    4,   // kDrawLine
+    4,   // kDrawRect
+    12,  // kDrawRRect
+    4,   // kDrawOval
+    3,   // kDrawCircle
+    7,   // kDrawArc
+};
+static_assert(std::size(kArgumentCounts) ==
+                  static_cast<size_t>(CanvasCommand::kLastCommand) + 1,
+              "Every command must have an argument count.");
+
+static std::string CommandError(size_t index, const char* message) {
+  std::stringstream stream;
+  stream << "Canvas command at index " << index << " " << message << ".";
+  return stream.str();
+}
+
+// Whether the value is an integer in [0, limit).
+static bool IsIndex(float value, size_t limit) {
+  return value >= 0 && value < limit && std::floor(value) == value;
+}
+
+static SkRect RectFromArguments(const float* args) {
+  return SkRect::MakeLTRB(args[0], args[1], args[2], args[3]);
+}
+
+std::optional<std::string> ReplayCanvasCommands(
+    DisplayListBuilder* builder,
+    const float* commands,
+    size_t command_count,
+    const std::vector<Paint::Objects>& paint_objects,
+    const uint8_t* paint_data) {
+  std::optional<size_t> paint_index;
+  // The attributes the current paint was last synchronized for. Operations
+  // do not change attributes, so the paint only needs to be synchronized
+  // again once either changes.
+  const DisplayListAttributeFlags* synced_flags = nullptr;
+
+  size_t index = 0;
+  while (index < command_count) {
+    const size_t command_index = index;
+    if (!IsIndex(commands[index], std::size(kArgumentCounts))) {
+      return CommandError(command_index, "has an unknown opcode");
+    }
+    auto command = static_cast<CanvasCommand>(commands[index]);
+    size_t argument_count = kArgumentCounts[static_cast<size_t>(command)];
+    if (command_count - index - 1 < argument_count) {
+      return CommandError(command_index, "is missing arguments");
+    }
+    const float* args = commands + index + 1;
+    index += argument_count + 1;
+
+    switch (command) {
+      case CanvasCommand::kSave:
+        builder->save();
+        continue;
+      case CanvasCommand::kRestore:
+        builder->restore();
+        continue;
+      case CanvasCommand::kTranslate:
+        builder->translate(args[0], args[1]);
+        continue;
+      case CanvasCommand::kScale:
+        builder->scale(args[0], args[1]);
+        continue;
+      case CanvasCommand::kRotate:
+        builder->rotate(args[0] * 180.0 / M_PI);
+        continue;
+      case CanvasCommand::kClipRect:
+        if (!IsIndex(args[4], 2)) {
+          return CommandError(command_index, "has an unknown clip op");
+        }
+        builder->clipRect(RectFromArguments(args),
+                          static_cast<SkClipOp>(args[4]), args[5] != 0);
+        continue;
+      case CanvasCommand::kSetPaint:
+        if (!IsIndex(args[0], paint_objects.size())) {
+          return CommandError(command_index, "refers to an unknown paint");
+        }
+        if (paint_index != static_cast<size_t>(args[0])) {
+          paint_index = static_cast<size_t>(args[0]);
+          synced_flags = nullptr;
+        }
+        continue;
+      default:
+        break;
+    }
+
+    // All remaining commands draw with the current paint.
+    if (!paint_index.has_value()) {
+      return CommandError(command_index, "draws without a paint");
+    }
+    auto sync_paint = [&](const DisplayListAttributeFlags& flags) {
+      if (synced_flags != &flags) {
+        Paint::SyncTo(builder, flags, paint_objects[paint_index.value()],
+                      paint_data + paint_index.value() * Paint::kDataByteCount);
+        synced_flags = &flags;
+      }
+    };
+    switch (command) {
+      case CanvasCommand::kDrawLine:
+        sync_paint(DisplayListOpFlags::kDrawLineFlags);
+        builder->drawLine(SkPoint::Make(args[0], args[1]),
+                          SkPoint::Make(args[2], args[3]));
+        break;
+      case CanvasCommand::kDrawRect:
+        sync_paint(DisplayListOpFlags::kDrawRectFlags);
+        builder->drawRect(RectFromArguments(args));
+        break;
+      case CanvasCommand::kDrawRRect: {
+        sync_paint(DisplayListOpFlags::kDrawRRectFlags);
+        SkVector radii[4] = {{args[4], args[5]},
+                             {args[6], args[7]},
+                             {args[8], args[9]},
+                             {args[10], args[11]}};
+        SkRRect rrect;
+        rrect.setRectRadii(RectFromArguments(args), radii);
+        builder->drawRRect(rrect);
+        break;
+      }
+      case CanvasCommand::kDrawOval:
+        sync_paint(DisplayListOpFlags::kDrawOvalFlags);
+        builder->drawOval(RectFromArguments(args));
+        break;
+      case CanvasCommand::kDrawCircle:
+        sync_paint(DisplayListOpFlags::kDrawCircleFlags);
+        builder->drawCircle(SkPoint::Make(args[0], args[1]), args[2]);
+        break;
+      case CanvasCommand::kDrawArc: {
+        bool use_center = args[6] != 0;
+        sync_paint(use_center ? DisplayListOpFlags::kDrawArcWithCenterFlags
+                              : DisplayListOpFlags::kDrawArcNoCenterFlags);
+        builder->drawArc(RectFromArguments(args), args[4] * 180.0 / M_PI,
+                         args[5] * 180.0 / M_PI, use_center);
+        break;
+      }
+      default:
+        FML_UNREACHABLE();
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace flutter
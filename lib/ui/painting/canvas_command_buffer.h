@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_CANVAS_COMMAND_BUFFER_H_
+#define FLUTTER_LIB_UI_PAINTING_CANVAS_COMMAND_BUFFER_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/lib/ui/painting/paint.h"
+
+namespace flutter {
+
+// Must be kept in sync with the opcodes of CanvasCommandBuffer in
+// painting.dart.
+enum class CanvasCommand : uint32_t {
+  kSave,        // ()
+  kRestore,     // ()
+  kTranslate,   // (dx, dy)
+  kScale,       // (sx, sy)
+  kRotate,      // (radians)
+  kClipRect,    // (left, top, right, bottom, clip op, anti-alias)
+  kSetPaint,    // (paint index)
+  kDrawLine,    // (x1, y1, x2, y2)
+  kDrawRect,    // (left, top, right, bottom)
+  kDrawRRect,   // (left, top, right, bottom, 4 x (x radius, y radius))
+  kDrawOval,    // (left, top, right, bottom)
+  kDrawCircle,  // (x, y, radius)
+  kDrawArc,     // (left, top, right, bottom, start, sweep, use center)
+  kLastCommand = kDrawArc,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Replays the commands recorded by a Dart CanvasCommandBuffer
+///             into a display list builder.
+///
+///             The commands are a flat list of floats in which every opcode is
+///             followed by its arguments. Paints are stored out of line and
+///             selected with kSetPaint. A paint is only synchronized with the
+///             builder when it, or the attributes that the next operation
+///             uses, change, so long runs of primitives that share a paint
+///             only decode it once.
+///
+/// @param[in]  builder        The builder to replay the commands into.
+/// @param[in]  commands       The packed commands.
+/// @param[in]  command_count  The number of floats in `commands`.
+/// @param[in]  paint_objects  The unwrapped objects of every recorded paint.
+/// @param[in]  paint_data     Paint::kDataByteCount bytes of data for every
+///                            recorded paint.
+///
+/// @return     A description of the first malformed command, if any. Commands
+///             before it have been replayed.
+///
+std::optional<std::string> ReplayCanvasCommands(
+    DisplayListBuilder* builder,
+    const float* commands,
+    size_t command_count,
+    const std::vector<Paint::Objects>& paint_objects,
+    const uint8_t* paint_data);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_CANVAS_COMMAND_BUFFER_H_
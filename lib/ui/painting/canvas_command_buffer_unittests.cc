@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/canvas_command_buffer.h"
+
+#include <cmath>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static float Op(CanvasCommand command) {
+  return static_cast<float>(command);
+}
+
+TEST(CanvasCommandBufferTest, ReplaysLikeDirectCalls) {
+  std::vector<Paint::Objects> objects = {{nullptr, nullptr, nullptr}};
+  std::vector<uint8_t> data(Paint::kDataByteCount, 0);
+  // clang-format off
+  std::vector<float> commands = {
+      Op(CanvasCommand::kSave),
+      Op(CanvasCommand::kTranslate), 10, 20,
+      Op(CanvasCommand::kRotate), M_PI / 2,
+      Op(CanvasCommand::kClipRect), 0, 0, 100, 100, 0, 1,
+      Op(CanvasCommand::kSetPaint), 0,
+      Op(CanvasCommand::kDrawRect), 1, 2, 3, 4,
+      Op(CanvasCommand::kDrawRect), 5, 6, 7, 8,
+      Op(CanvasCommand::kDrawLine), 0, 0, 10, 10,
+      Op(CanvasCommand::kDrawCircle), 5, 5, 2,
+      Op(CanvasCommand::kRestore),
+  };
+  // clang-format on
+
+  DisplayListBuilder replayed;
+  auto error = ReplayCanvasCommands(&replayed, commands.data(),
+                                    commands.size(), objects, data.data());
+  ASSERT_FALSE(error.has_value()) << error.value();
+
+  DisplayListBuilder expected;
+  expected.save();
+  expected.translate(10, 20);
+  expected.rotate(static_cast<float>(M_PI / 2) * 180.0 / M_PI);
+  expected.clipRect(SkRect::MakeLTRB(0, 0, 100, 100), SkClipOp::kDifference,
+                    true);
+  Paint::SyncTo(&expected, DisplayListOpFlags::kDrawRectFlags, objects[0],
+                data.data());
+  expected.drawRect(SkRect::MakeLTRB(1, 2, 3, 4));
+  expected.drawRect(SkRect::MakeLTRB(5, 6, 7, 8));
+  Paint::SyncTo(&expected, DisplayListOpFlags::kDrawLineFlags, objects[0],
+                data.data());
+  expected.drawLine(SkPoint::Make(0, 0), SkPoint::Make(10, 10));
+  Paint::SyncTo(&expected, DisplayListOpFlags::kDrawCircleFlags, objects[0],
+                data.data());
+  expected.drawCircle(SkPoint::Make(5, 5), 2);
+  expected.restore();
+
+  ASSERT_TRUE(replayed.Build()->Equals(expected.Build()));
+}
+
+TEST(CanvasCommandBufferTest, ReportsMalformedCommands) {
+  std::vector<Paint::Objects> objects = {{nullptr, nullptr, nullptr}};
+  std::vector<uint8_t> data(Paint::kDataByteCount, 0);
+  auto replay = [&](std::vector<float> commands) {
+    DisplayListBuilder builder;
+    return ReplayCanvasCommands(&builder, commands.data(), commands.size(),
+                                objects, data.data());
+  };
+
+  ASSERT_EQ(replay({Op(CanvasCommand::kSave), 99}),
+            "Canvas command at index 1 has an unknown opcode.");
+  ASSERT_EQ(replay({Op(CanvasCommand::kTranslate), 1}),
+            "Canvas command at index 0 is missing arguments.");
+  ASSERT_EQ(replay({Op(CanvasCommand::kDrawOval), 0, 0, 1, 1}),
+            "Canvas command at index 0 draws without a paint.");
+  ASSERT_EQ(replay({Op(CanvasCommand::kSetPaint), 1}),
+            "Canvas command at index 0 refers to an unknown paint.");
+  ASSERT_EQ(replay({Op(CanvasCommand::kClipRect), 0, 0, 1, 1, 2, 1}),
+            "Canvas command at index 0 has an unknown clip op.");
+  ASSERT_FALSE(replay({}).has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
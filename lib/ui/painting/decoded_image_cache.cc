@@ -0,0 +1,187 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+static size_t HashEncodedData(const sk_sp<SkData>& encoded) {
+  if (!encoded) {
+    return 0;
+  }
+  return std::hash<std::string_view>{}(std::string_view(
+      static_cast<const char*>(encoded->data()), encoded->size()));
+}
+
+DecodedImageCache::Key::Key(sk_sp<SkData> encoded,
+                            const SkImageInfo& decoded_info)
+    : encoded_(std::move(encoded)),
+      dimensions_(decoded_info.dimensions()),
+      color_type_(decoded_info.colorType()),
+      alpha_type_(decoded_info.alphaType()),
+      hash_(fml::HashCombine(HashEncodedData(encoded_),
+                             dimensions_.width(),
+                             dimensions_.height(),
+                             static_cast<int>(color_type_),
+                             static_cast<int>(alpha_type_))) {}
+
+DecodedImageCache::Key::~Key() = default;
+
+DecodedImageCache::Key::Key(const Key& other) = default;
+
+DecodedImageCache::Key& DecodedImageCache::Key::operator=(const Key& other) =
+    default;
+
+bool DecodedImageCache::Key::Describes(const SkImageInfo& info) const {
+  return info.dimensions() == dimensions_ &&
+         info.colorType() == color_type_ && info.alphaType() == alpha_type_;
+}
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  if (hash_ != other.hash_ || dimensions_ != other.dimensions_ ||
+      color_type_ != other.color_type_ || alpha_type_ != other.alpha_type_) {
+    return false;
+  }
+  if (encoded_ == other.encoded_) {
+    return true;
+  }
+  // Equal hashes are not proof of equal contents. Comparing the encoded bytes
+  // is still far cheaper than decoding them.
+  return encoded_ && other.encoded_ && encoded_->equals(other.encoded_.get());
+}
+
+size_t DecodedImageCache::Key::GetEncodedSize() const {
+  return encoded_ ? encoded_->size() : 0;
+}
+
+DecodedImageCache& DecodedImageCache::GetInstance() {
+  static DecodedImageCache* instance = new DecodedImageCache();
+  return *instance;
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+void DecodedImageCache::EnsureMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = std::max(max_bytes_, max_bytes);
+}
+
+void DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = max_bytes;
+  EvictLocked();
+}
+
+size_t DecodedImageCache::GetMaxBytes() const {
+  std::scoped_lock lock(mutex_);
+  return max_bytes_;
+}
+
+bool DecodedImageCache::IsEnabled() const {
+  return GetMaxBytes() > 0;
+}
+
+size_t DecodedImageCache::GetCurrentBytes() const {
+  std::scoped_lock lock(mutex_);
+  return current_bytes_;
+}
+
+sk_sp<SkImage> DecodedImageCache::GetRasterImage(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = FindLocked(key);
+  if (found == entries_.end()) {
+    return nullptr;
+  }
+  return found->raster_image;
+}
+
+void DecodedImageCache::PutRasterImage(const Key& key, sk_sp<SkImage> image) {
+  if (!image || image->isTextureBacked()) {
+    return;
+  }
+  if (!key.Describes(image->imageInfo())) {
+    FML_DLOG(ERROR) << "Not caching an image that does not match its key.";
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (max_bytes_ == 0) {
+    return;
+  }
+  auto found = FindLocked(key);
+  if (found != entries_.end()) {
+    EraseLocked(found);
+  }
+  PutLocked({.key = key, .raster_image = std::move(image)});
+}
+
+void DecodedImageCache::Purge() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  current_bytes_ = 0;
+}
+
+size_t DecodedImageCache::Trim(size_t bytes) {
+  std::scoped_lock lock(mutex_);
+  size_t released = 0;
+  while (released < bytes && !entries_.empty()) {
+    auto last = std::prev(entries_.end());
+    released += last->bytes;
+    EraseLocked(last);
+  }
+  return released;
+}
+
+DecodedImageCache::EntryList::iterator DecodedImageCache::FindLocked(
+    const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return entries_.end();
+  }
+  // Mark as most recently used.
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second;
+}
+
+void DecodedImageCache::PutLocked(Entry entry) {
+  entry.bytes = entry.key.GetEncodedSize();
+  if (entry.raster_image) {
+    entry.bytes += entry.raster_image->imageInfo().computeMinByteSize();
+  }
+  if (entry.bytes > max_bytes_) {
+    // Would evict everything else and still not fit.
+    return;
+  }
+  current_bytes_ += entry.bytes;
+  entries_.push_front(std::move(entry));
+  index_[entries_.front().key] = entries_.begin();
+  EvictLocked();
+}
+
+void DecodedImageCache::EraseLocked(EntryList::iterator entry) {
+  FML_DCHECK(current_bytes_ >= entry->bytes);
+  current_bytes_ -= entry->bytes;
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+void DecodedImageCache::EvictLocked() {
+  while (current_bytes_ > max_bytes_ && !entries_.empty()) {
+    TRACE_EVENT0("flutter", "DecodedImageCache::Evict");
+    EraseLocked(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace flutter
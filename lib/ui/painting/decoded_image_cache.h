@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace flutter {
+
+/// @brief  A process-wide, byte-budgeted cache of decoded images that is
+///         shared by the image decoders of every engine in the process.
+///
+///         Entries are keyed by the contents of the encoded image along with
+///         the info of the image it was decoded to, so identical assets
+///         loaded by different shells, windows or isolates are only decoded
+///         once, and decoders only share images whose pixels they can use
+///         as they are.
+///
+///         Only raster images are cached. Textures belong to the rendering
+///         context they were created with and must be collected on its
+///         threads before it is, which an entry of a process-wide cache that
+///         may be evicted on any thread can not guarantee. Decoders still
+///         upload the cached pixels themselves.
+///
+///         The least recently used entries are evicted once the total size
+///         exceeds the budget. A budget of zero, the default, disables the
+///         cache. All methods are thread safe.
+class DecodedImageCache {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief  Identifies a decode of a particular encoded image. Creating a
+  ///         key hashes the entire encoded buffer, so keys should be made on
+  ///         worker threads.
+  ///
+  class Key {
+   public:
+    //--------------------------------------------------------------------------
+    /// @param[in]  encoded       The encoded image.
+    /// @param[in]  decoded_info  The info of the image the decoder produces,
+    ///                           after any resizing and color conversion.
+    ///
+    Key(sk_sp<SkData> encoded, const SkImageInfo& decoded_info);
+
+    /// @brief  Whether an image with `info` is a decode this key identifies.
+    bool Describes(const SkImageInfo& info) const;
+
+    ~Key();
+
+    Key(const Key& other);
+
+    Key& operator=(const Key& other);
+
+    bool operator==(const Key& other) const;
+
+    size_t GetHash() const { return hash_; }
+
+    size_t GetEncodedSize() const;
+
+   private:
+    sk_sp<SkData> encoded_;
+    SkISize dimensions_;
+    SkColorType color_type_;
+    SkAlphaType alpha_type_;
+    size_t hash_;
+  };
+
+  /// @brief  The cache shared by all engines in the process.
+  static DecodedImageCache& GetInstance();
+
+  explicit DecodedImageCache(size_t max_bytes = 0);
+
+  ~DecodedImageCache();
+
+  /// @brief  Raises the byte budget to at least `max_bytes`. Engines in the
+  ///         same process may request different budgets; the largest wins.
+  void EnsureMaxBytes(size_t max_bytes);
+
+  /// @brief  Sets the byte budget, evicting entries as necessary.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t GetMaxBytes() const;
+
+  bool IsEnabled() const;
+
+  /// @brief  The number of bytes currently held by the cache.
+  size_t GetCurrentBytes() const;
+
+  /// @brief  Returns a previously decoded raster image for `key`, or null.
+  sk_sp<SkImage> GetRasterImage(const Key& key);
+
+  /// @brief  Caches a raster image for `key`. Texture backed images are
+  ///         ignored.
+  void PutRasterImage(const Key& key, sk_sp<SkImage> image);
+
+  /// @brief  Drops every entry.
+  void Purge();
+
+  /// @brief  Drops the least recently used entries until at least `bytes`
+  ///         bytes have been released or the cache is empty.
+  ///
+  /// @return The number of bytes released.
+  size_t Trim(size_t bytes);
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.GetHash(); }
+  };
+
+  struct Entry {
+    Key key;
+    sk_sp<SkImage> raster_image;
+    size_t bytes = 0;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  mutable std::mutex mutex_;
+  size_t max_bytes_;
+  size_t current_bytes_ = 0;
+  // Most recently used entries are at the front.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+
+  EntryList::iterator FindLocked(const Key& key);
+
+  void PutLocked(Entry entry);
+
+  void EraseLocked(EntryList::iterator entry);
+
+  void EvictLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<SkData> MakeEncodedData(uint8_t fill, size_t size = 64) {
+  std::vector<uint8_t> bytes(size, fill);
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+static sk_sp<SkImage> MakeRasterImage(int width, int height) {
+  SkBitmap bitmap;
+  FML_CHECK(bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(width, height)));
+  bitmap.eraseColor(SK_ColorRED);
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+static DecodedImageCache::Key MakeKey(const sk_sp<SkData>& data,
+                                      int width = 10,
+                                      int height = 10) {
+  return DecodedImageCache::Key(data,
+                                SkImageInfo::MakeN32Premul(width, height));
+}
+
+TEST(DecodedImageCacheTest, DisabledByDefault) {
+  DecodedImageCache cache;
+  ASSERT_FALSE(cache.IsEnabled());
+  auto key = MakeKey(MakeEncodedData(1));
+  cache.PutRasterImage(key, MakeRasterImage(10, 10));
+  ASSERT_EQ(cache.GetRasterImage(key), nullptr);
+  ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, EqualContentsShareEntries) {
+  DecodedImageCache cache(1 << 20);
+  auto image = MakeRasterImage(10, 10);
+  cache.PutRasterImage(MakeKey(MakeEncodedData(1)), image);
+
+  // Separately allocated but identical encoded bytes hit the same entry.
+  ASSERT_EQ(cache.GetRasterImage(MakeKey(MakeEncodedData(1))), image);
+  // Different contents, sizes, color types or alpha types miss.
+  ASSERT_EQ(cache.GetRasterImage(MakeKey(MakeEncodedData(2))), nullptr);
+  ASSERT_EQ(cache.GetRasterImage(MakeKey(MakeEncodedData(1), 20, 20)),
+            nullptr);
+  ASSERT_EQ(cache.GetRasterImage(DecodedImageCache::Key(
+                MakeEncodedData(1),
+                SkImageInfo::Make(10, 10, kRGBA_F16_SkColorType,
+                                  kPremul_SkAlphaType))),
+            nullptr);
+  ASSERT_EQ(cache.GetRasterImage(DecodedImageCache::Key(
+                MakeEncodedData(1),
+                SkImageInfo::Make(10, 10, kN32_SkColorType,
+                                  kUnpremul_SkAlphaType))),
+            nullptr);
+}
+
+TEST(DecodedImageCacheTest, EvictsLeastRecentlyUsedEntries) {
+  const size_t entry_bytes = 64 + 10 * 10 * 4;
+  DecodedImageCache cache(entry_bytes * 2);
+
+  auto first = MakeKey(MakeEncodedData(1));
+  auto second = MakeKey(MakeEncodedData(2));
+  auto third = MakeKey(MakeEncodedData(3));
+  cache.PutRasterImage(first, MakeRasterImage(10, 10));
+  cache.PutRasterImage(second, MakeRasterImage(10, 10));
+  ASSERT_EQ(cache.GetCurrentBytes(), entry_bytes * 2);
+
+  // Touch the first entry so that the second one is evicted.
+  ASSERT_NE(cache.GetRasterImage(first), nullptr);
+  cache.PutRasterImage(third, MakeRasterImage(10, 10));
+
+  ASSERT_NE(cache.GetRasterImage(first), nullptr);
+  ASSERT_EQ(cache.GetRasterImage(second), nullptr);
+  ASSERT_NE(cache.GetRasterImage(third), nullptr);
+  ASSERT_EQ(cache.GetCurrentBytes(), entry_bytes * 2);
+
+  cache.SetMaxBytes(entry_bytes);
+  ASSERT_EQ(cache.GetCurrentBytes(), entry_bytes);
+  cache.Purge();
+  ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, TrimEvictsLeastRecentlyUsedEntries) {
+  const size_t entry_bytes = 64 + 10 * 10 * 4;
+  DecodedImageCache cache(entry_bytes * 3);
+
+  auto first = MakeKey(MakeEncodedData(1));
+  auto second = MakeKey(MakeEncodedData(2));
+  auto third = MakeKey(MakeEncodedData(3));
+  cache.PutRasterImage(first, MakeRasterImage(10, 10));
+  cache.PutRasterImage(second, MakeRasterImage(10, 10));
+  cache.PutRasterImage(third, MakeRasterImage(10, 10));
+  ASSERT_NE(cache.GetRasterImage(first), nullptr);
+
+  ASSERT_EQ(cache.Trim(1), entry_bytes);
+  ASSERT_EQ(cache.GetRasterImage(second), nullptr);
+  ASSERT_EQ(cache.Trim(entry_bytes * 10), entry_bytes * 2);
+  ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+  ASSERT_EQ(cache.Trim(1), 0u);
+}
+
+TEST(DecodedImageCacheTest, DoesNotCacheImagesLargerThanTheBudget) {
+  DecodedImageCache cache(128);
+  auto key = MakeKey(MakeEncodedData(1));
+  cache.PutRasterImage(key, MakeRasterImage(10, 10));
+  ASSERT_EQ(cache.GetRasterImage(key), nullptr);
+  ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, DoesNotCacheImagesThatDoNotMatchTheirKey) {
+  DecodedImageCache cache(1 << 20);
+  auto key = MakeKey(MakeEncodedData(1), 20, 20);
+  cache.PutRasterImage(key, MakeRasterImage(10, 10));
+  ASSERT_EQ(cache.GetRasterImage(key), nullptr);
+  ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, BudgetCanOnlyBeRaisedByEngines) {
+  DecodedImageCache cache(100);
+  cache.EnsureMaxBytes(50);
+  ASSERT_EQ(cache.GetMaxBytes(), 100u);
+  cache.EnsureMaxBytes(200);
+  ASSERT_EQ(cache.GetMaxBytes(), 200u);
+}
+
+}  // namespace testing
+}  // namespace flutter
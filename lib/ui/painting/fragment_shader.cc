@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -21,6 +23,35 @@
 
 namespace flutter {
 
+UniformSnapshots::UniformSnapshots(size_t size) : size_(size) {}
+
+UniformSnapshots::~UniformSnapshots() = default;
+
+bool UniformSnapshots::Matches(const void* data) const {
+  const auto& current = buffers_[current_];
+  return current && memcmp(current->data(), data, size_) == 0;
+}
+
+std::shared_ptr<std::vector<uint8_t>> UniformSnapshots::Take(
+    const void* data) {
+  current_ = (current_ + 1) % buffers_.size();
+  auto& buffer = buffers_[current_];
+  // If this is the last reference to the older buffer, every display list that
+  // used it has been collected. The fence orders the writes that follow after
+  // the reads of the raster thread that dropped the previous reference.
+  if (buffer && buffer.use_count() == 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } else {
+    buffer = std::make_shared<std::vector<uint8_t>>(size_);
+  }
+  memcpy(buffer->data(), data, size_);
+  return buffer;
+}
+
+void UniformSnapshots::Reset() {
+  buffers_ = {};
+}
+
 IMPLEMENT_WRAPPERTYPEINFO(ui, ReusableFragmentShader);
 
 ReusableFragmentShader::ReusableFragmentShader(
@@ -31,7 +62,8 @@ ReusableFragmentShader::ReusableFragmentShader(
       uniform_data_(SkData::MakeUninitialized(
           (float_count + 2 * sampler_count) * sizeof(float))),
       samplers_(sampler_count),
-      float_count_(float_count) {}
+      float_count_(float_count),
+      uniform_snapshots_(uniform_data_->size()) {}
 
 Dart_Handle ReusableFragmentShader::Create(Dart_Handle wrapper,
                                            Dart_Handle program,
@@ -77,6 +109,7 @@ void ReusableFragmentShader::SetImageSampler(Dart_Handle index_handle,
   samplers_[index] = std::make_shared<DlImageColorSource>(
       image->image(), DlTileMode::kClamp, DlTileMode::kClamp,
       DlImageSampling::kNearestNeighbor, nullptr);
+  samplers_changed_ = true;
 
   auto* uniform_floats =
       reinterpret_cast<float*>(uniform_data_->writable_data());
@@ -88,18 +121,30 @@ std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
     DlImageSampling sampling) {
   FML_CHECK(program_);
 
+  // Dart writes the uniforms straight into |uniform_data_|, so the only way to
+  // tell whether they changed is to compare them with the last snapshot.
+  // Handing out the same color source keeps the display lists of unchanged
+  // shaders equal, which lets later stages reuse their work.
+  if (color_source_ && !samplers_changed_ &&
+      uniform_snapshots_.Matches(uniform_data_->bytes())) {
+    return color_source_;
+  }
+
   // The lifetime of this object is longer than a frame, and the uniforms can be
   // continually changed on the UI thread. So we take a copy of the uniforms
   // before handing it to the DisplayList for consumption on the render thread.
-  auto uniform_data = std::make_shared<std::vector<uint8_t>>();
-  uniform_data->resize(uniform_data_->size());
-  memcpy(uniform_data->data(), uniform_data_->bytes(), uniform_data->size());
+  auto uniform_data = uniform_snapshots_.Take(uniform_data_->bytes());
+  samplers_changed_ = false;
 
-  return program_->MakeDlColorSource(std::move(uniform_data), samplers_);
+  color_source_ =
+      program_->MakeDlColorSource(std::move(uniform_data), samplers_);
+  return color_source_;
 }
 
 void ReusableFragmentShader::Dispose() {
   uniform_data_.reset();
+  uniform_snapshots_.Reset();
+  color_source_ = nullptr;
   program_ = nullptr;
   samplers_.clear();
   ClearDartWrapper();
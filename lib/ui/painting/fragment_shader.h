@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_FRAGMENT_SHADER_H_
 #define FLUTTER_LIB_UI_PAINTING_FRAGMENT_SHADER_H_
 
+#include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/fragment_program.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -15,6 +16,8 @@
 #include "third_party/tonic/dart_library_natives.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 
+#include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,6 +25,33 @@ namespace flutter {
 
 class FragmentProgram;
 
+// Copies of the uniforms of a fragment shader, taken to be handed to display
+// lists. The uniforms themselves are written by Dart and can change at any
+// time on the UI thread, while a display list may still be drawn from on the
+// raster thread. Two buffers are alternated between, and the older one is
+// only written to again once nothing else refers to it.
+class UniformSnapshots {
+ public:
+  explicit UniformSnapshots(size_t size);
+
+  ~UniformSnapshots();
+
+  // Whether a snapshot was taken and |data| still has the same contents.
+  bool Matches(const void* data) const;
+
+  // Returns a snapshot of the |size| bytes at |data|.
+  std::shared_ptr<std::vector<uint8_t>> Take(const void* data);
+
+  void Reset();
+
+ private:
+  size_t size_;
+  std::array<std::shared_ptr<std::vector<uint8_t>>, 2> buffers_;
+  size_t current_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UniformSnapshots);
+};
+
 class ReusableFragmentShader : public Shader {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ReusableFragmentShader);
@@ -52,6 +82,13 @@ class ReusableFragmentShader : public Shader {
   sk_sp<SkData> uniform_data_;
   std::vector<std::shared_ptr<DlColorSource>> samplers_;
   size_t float_count_;
+
+  // The snapshots of |uniform_data_| handed out to display lists, and the
+  // color source made from the newest one. The color source is returned
+  // again for as long as neither the uniforms nor the samplers change.
+  UniformSnapshots uniform_snapshots_;
+  std::shared_ptr<DlColorSource> color_source_;
+  bool samplers_changed_ = true;
 };
 
 }  // namespace flutter
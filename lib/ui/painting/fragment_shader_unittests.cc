@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/fragment_shader.h"
+
+#include <array>
+#include <cstring>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(UniformSnapshotsTest, UnchangedUniformsMatchTheLastSnapshot) {
+  std::array<float, 4> uniforms = {1, 2, 3, 4};
+  UniformSnapshots snapshots(sizeof(uniforms));
+  // Nothing can be reused before the first snapshot.
+  ASSERT_FALSE(snapshots.Matches(uniforms.data()));
+
+  auto snapshot = snapshots.Take(uniforms.data());
+  ASSERT_EQ(snapshot->size(), sizeof(uniforms));
+  // The shader returns its previous color source for as long as this holds.
+  ASSERT_TRUE(snapshots.Matches(uniforms.data()));
+}
+
+TEST(UniformSnapshotsTest, ChangedUniformsProduceANewSnapshot) {
+  std::array<float, 4> uniforms = {1, 2, 3, 4};
+  UniformSnapshots snapshots(sizeof(uniforms));
+  auto first = snapshots.Take(uniforms.data());
+
+  uniforms[2] = 5;
+  ASSERT_FALSE(snapshots.Matches(uniforms.data()));
+  auto second = snapshots.Take(uniforms.data());
+  ASSERT_NE(first, second);
+  ASSERT_EQ(memcmp(second->data(), uniforms.data(), sizeof(uniforms)), 0);
+  ASSERT_TRUE(snapshots.Matches(uniforms.data()));
+}
+
+TEST(UniformSnapshotsTest, SnapshotsHeldByAFrameAreNeverOverwritten) {
+  std::array<float, 4> uniforms = {1, 2, 3, 4};
+  const std::array<float, 4> first_uniforms = uniforms;
+  UniformSnapshots snapshots(sizeof(uniforms));
+  // Stands in for a display list that is still being drawn from.
+  auto in_flight = snapshots.Take(uniforms.data());
+
+  for (float value = 5; value < 10; value++) {
+    uniforms[0] = value;
+    auto snapshot = snapshots.Take(uniforms.data());
+    ASSERT_NE(snapshot, in_flight);
+    ASSERT_EQ(memcmp(snapshot->data(), uniforms.data(), sizeof(uniforms)), 0);
+  }
+  ASSERT_EQ(
+      memcmp(in_flight->data(), first_uniforms.data(), sizeof(uniforms)), 0);
+}
+
+TEST(UniformSnapshotsTest, ReusesBuffersThatAreNoLongerReferenced) {
+  std::array<float, 4> uniforms = {1, 2, 3, 4};
+  UniformSnapshots snapshots(sizeof(uniforms));
+  auto first = snapshots.Take(uniforms.data());
+  const auto* first_buffer = first.get();
+  first.reset();
+
+  uniforms[0] = 5;
+  auto second = snapshots.Take(uniforms.data());
+  uniforms[0] = 6;
+  auto third = snapshots.Take(uniforms.data());
+  ASSERT_EQ(third.get(), first_buffer);
+  ASSERT_EQ(memcmp(third->data(), uniforms.data(), sizeof(uniforms)), 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_decoder.h"
 
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -17,6 +18,10 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
     const TaskRunners& runners,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     fml::WeakPtr<IOManager> io_manager) {
+  if (settings.decoded_image_cache_max_bytes > 0) {
+    DecodedImageCache::GetInstance().EnsureMaxBytes(
+        settings.decoded_image_cache_max_bytes);
+  }
 #if IMPELLER_SUPPORTS_RENDERING
   if (settings.enable_impeller) {
     return std::make_unique<ImageDecoderImpeller>(
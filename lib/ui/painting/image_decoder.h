@@ -43,6 +43,12 @@ class ImageDecoder {
                       uint32_t target_height,
                       const ImageResult& result) = 0;
 
+  // Takes an image that was already decoded into system memory, such as a
+  // frame of a progressive decode, and returns a handle to a texture resident
+  // on the GPU. The upload is done like the uploads of |Decode| and the result
+  // is returned on the UI thread. On error, the texture is null.
+  virtual void Upload(sk_sp<SkImage> image, const ImageResult& result) = 0;
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  protected:
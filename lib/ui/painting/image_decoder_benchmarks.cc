@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/lib/ui/painting/scanline_downsampler.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+static fml::RefPtr<ImageDescriptor> CreateDescriptorForFixture(
+    const char* fixture_name) {
+  auto mapping = testing::OpenFixtureAsMapping(fixture_name);
+  FML_CHECK(mapping) << "Could not open fixture " << fixture_name;
+  auto data = SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  FML_CHECK(generator);
+  return fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                              std::move(generator));
+}
+
+// Decodes the fixture at full size and then resizes, the way images are
+// decoded when the codec can not stream scanlines.
+static void BM_DecodeThenResize(benchmark::State& state) {
+  auto descriptor = CreateDescriptorForFixture("DashInNooglerHat.jpg");
+  const auto target_size =
+      SkISize::Make(descriptor->width() / state.range(0),
+                    descriptor->height() / state.range(0));
+  const auto target_info = descriptor->image_info().makeDimensions(target_size);
+
+  while (state.KeepRunning()) {
+    SkBitmap full_bitmap;
+    FML_CHECK(full_bitmap.tryAllocPixels(descriptor->image_info()));
+    FML_CHECK(descriptor->get_pixels(full_bitmap.pixmap()));
+
+    SkBitmap target_bitmap;
+    FML_CHECK(target_bitmap.tryAllocPixels(target_info));
+    FML_CHECK(full_bitmap.pixmap().scalePixels(
+        target_bitmap.pixmap(),
+        SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone)));
+  }
+  state.counters["PeakBytes"] = descriptor->image_info().computeMinByteSize() +
+                                target_info.computeMinByteSize();
+}
+
+// Streams scanlines from the codec into a target sized bitmap.
+static void BM_DecodeToSize(benchmark::State& state) {
+  auto descriptor = CreateDescriptorForFixture("DashInNooglerHat.jpg");
+  const auto target_size =
+      SkISize::Make(descriptor->width() / state.range(0),
+                    descriptor->height() / state.range(0));
+  const auto target_info = descriptor->image_info().makeDimensions(target_size);
+
+  while (state.KeepRunning()) {
+    SkBitmap target_bitmap;
+    FML_CHECK(target_bitmap.tryAllocPixels(target_info));
+    if (!descriptor->get_downscaled_pixels(target_bitmap.pixmap())) {
+      state.SkipWithError("Fixture can not be decoded by scanline.");
+      break;
+    }
+  }
+  state.counters["PeakBytes"] = target_info.computeMinByteSize();
+}
+
+// The complete decode path used by the Skia image decoder.
+static void BM_ImageFromCompressedData(benchmark::State& state) {
+  auto descriptor = CreateDescriptorForFixture("DashInNooglerHat.jpg");
+  const uint32_t target_width = descriptor->width() / state.range(0);
+  const uint32_t target_height = descriptor->height() / state.range(0);
+
+  while (state.KeepRunning()) {
+    auto image = ImageDecoderSkia::ImageFromCompressedData(
+        descriptor.get(), target_width, target_height,
+        fml::tracing::TraceFlow(""));
+    FML_CHECK(image);
+  }
+}
+
+// The downsampling filter on its own, without decoding.
+static void BM_ScanlineDownsample(benchmark::State& state) {
+  const auto source_info = SkImageInfo::MakeN32Premul(4032, 3024);
+  SkBitmap source_bitmap;
+  FML_CHECK(source_bitmap.tryAllocPixels(source_info));
+  source_bitmap.eraseColor(SK_ColorBLUE);
+
+  const auto target_info =
+      source_info.makeWH(source_info.width() / state.range(0),
+                         source_info.height() / state.range(0));
+  SkBitmap target_bitmap;
+  FML_CHECK(target_bitmap.tryAllocPixels(target_info));
+
+  while (state.KeepRunning()) {
+    FML_CHECK(ScanlineDownsampler::Downsample(source_bitmap.pixmap(),
+                                              target_bitmap.pixmap()));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          source_info.computeMinByteSize());
+}
+
+BENCHMARK(BM_DecodeThenResize)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DecodeToSize)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ImageFromCompressedData)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanlineDownsample)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -14,6 +14,7 @@
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/impeller/renderer/texture.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
 #include "impeller/geometry/size.h"
@@ -57,6 +58,20 @@ static std::optional<impeller::PixelFormat> ToPixelFormat(SkColorType type) {
   return std::nullopt;
 }
 
+SkImageInfo ImageDecoderImpeller::GetDecompressedImageInfo(
+    const ImageDescriptor& descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size) {
+  const auto base_image_info = descriptor.image_info();
+  return base_image_info
+      .makeWH(std::min(static_cast<int32_t>(max_texture_size.width),
+                       target_size.width()),
+              std::min(static_cast<int32_t>(max_texture_size.height),
+                       target_size.height()))
+      .makeColorType(ChooseCompatibleColorType(base_image_info.colorType()))
+      .makeAlphaType(ChooseCompatibleAlphaType(base_image_info.alphaType()));
+}
+
 std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
     ImageDescriptor* descriptor,
     SkISize target_size,
@@ -67,10 +82,9 @@ std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
     return nullptr;
   }
 
-  target_size.set(std::min(static_cast<int32_t>(max_texture_size.width),
-                           target_size.width()),
-                  std::min(static_cast<int32_t>(max_texture_size.height),
-                           target_size.height()));
+  target_size =
+      GetDecompressedImageInfo(*descriptor, target_size, max_texture_size)
+          .dimensions();
 
   const SkISize source_size = descriptor->image_info().dimensions();
   auto decode_size = source_size;
@@ -97,6 +111,19 @@ std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
     return nullptr;
   }
 
+  // When shrinking, stream scanlines straight into a target sized bitmap so
+  // that the full size image is never held in memory.
+  if (descriptor->is_compressed() && decode_size != target_size &&
+      target_size.width() <= decode_size.width() &&
+      target_size.height() <= decode_size.height()) {
+    auto target_bitmap = std::make_shared<SkBitmap>();
+    if (target_bitmap->tryAllocPixels(image_info.makeDimensions(target_size)) &&
+        descriptor->get_downscaled_pixels(target_bitmap->pixmap())) {
+      target_bitmap->setImmutable();
+      return target_bitmap;
+    }
+  }
+
   auto bitmap = std::make_shared<SkBitmap>();
   if (descriptor->is_compressed()) {
     if (!bitmap->tryAllocPixels(image_info)) {
@@ -243,13 +270,43 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
+        // Any engine in the process can reuse the decoded pixels. Textures
+        // are always uploaded by the engine that uses them.
+        auto& cache = DecodedImageCache::GetInstance();
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (raw_descriptor->is_compressed() && cache.IsEnabled()) {
+          cache_key.emplace(
+              raw_descriptor->data(),
+              GetDecompressedImageInfo(*raw_descriptor, target_size,
+                                       max_size_supported));
+        }
+
+        std::shared_ptr<SkBitmap> bitmap;
+        if (cache_key) {
+          if (auto cached = cache.GetRasterImage(*cache_key)) {
+            bitmap = std::make_shared<SkBitmap>();
+            if (!cached->asLegacyBitmap(bitmap.get())) {
+              bitmap.reset();
+            }
+          }
+        }
+
         // Always decompress on the concurrent runner.
-        auto bitmap =
-            DecompressTexture(raw_descriptor, target_size, max_size_supported);
         if (!bitmap) {
-          result(nullptr);
-          return;
+          bitmap = DecompressTexture(raw_descriptor, target_size,
+                                     max_size_supported);
+          if (!bitmap) {
+            result(nullptr);
+            return;
+          }
+          if (cache_key) {
+            // The bitmap is only read from here on. Marking it immutable lets
+            // the cached image share its pixels instead of copying them.
+            bitmap->setImmutable();
+            cache.PutRasterImage(*cache_key, SkImage::MakeFromBitmap(*bitmap));
+          }
         }
+
         auto upload_texture_and_invoke_result = [result, context, bitmap]() {
           result(UploadTexture(context, bitmap));
         };
@@ -264,4 +321,50 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
       });
 }
 
+// |ImageDecoder|
+void ImageDecoderImpeller::Upload(sk_sp<SkImage> image,
+                                  const ImageResult& p_result) {
+  FML_DCHECK(p_result);
+
+  ImageResult result = [p_result,                               //
+                        ui_runner = runners_.GetUITaskRunner()  //
+  ](auto image) {
+    ui_runner->PostTask([p_result, image]() { p_result(std::move(image)); });
+  };
+
+  concurrent_task_runner_->PostTask(
+      [image = std::move(image),                //
+       context = context_.get(),                //
+       io_runner = runners_.GetIOTaskRunner(),  //
+       result                                   //
+  ]() {
+        FML_CHECK(context) << "No valid impeller context";
+        if (!image) {
+          result(nullptr);
+          return;
+        }
+        // Impeller only samples RGBA textures, so convert images decoded to
+        // other color types.
+        auto bitmap = std::make_shared<SkBitmap>();
+        const auto info = image->imageInfo().makeColorType(
+            ChooseCompatibleColorType(image->colorType()));
+        if (!bitmap->tryAllocPixels(info) ||
+            !image->readPixels(bitmap->pixmap(), 0, 0)) {
+          FML_DLOG(ERROR) << "Could not convert image for texture upload.";
+          result(nullptr);
+          return;
+        }
+        bitmap->setImmutable();
+
+        auto upload_texture_and_invoke_result = [result, context, bitmap]() {
+          result(UploadTexture(context, bitmap));
+        };
+        if (context->HasThreadingRestrictions()) {
+          io_runner->PostTask(upload_texture_and_invoke_result);
+        } else {
+          upload_texture_and_invoke_result();
+        }
+      });
+}
+
 }  // namespace flutter
@@ -32,6 +32,16 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  // |ImageDecoder|
+  void Upload(sk_sp<SkImage> image, const ImageResult& result) override;
+
+  // The info of the bitmap |DecompressTexture| produces for the same
+  // arguments.
+  static SkImageInfo GetDecompressedImageInfo(
+      const ImageDescriptor& descriptor,
+      SkISize target_size,
+      impeller::ISize max_texture_size);
+
   static std::shared_ptr<SkBitmap> DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 
 namespace flutter {
@@ -94,6 +95,16 @@ static sk_sp<SkImage> ImageFromDecompressedData(
                            flow);
 }
 
+SkImageInfo ImageDecoderSkia::GetDecompressedImageInfo(
+    const ImageDescriptor& descriptor,
+    uint32_t target_width,
+    uint32_t target_height) {
+  if (!descriptor.should_resize(target_width, target_height)) {
+    return descriptor.image_info();
+  }
+  return descriptor.image_info().makeWH(target_width, target_height);
+}
+
 sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     ImageDescriptor* descriptor,
     uint32_t target_width,
@@ -112,6 +123,25 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
   const SkISize resized_dimensions = {static_cast<int32_t>(target_width),
                                       static_cast<int32_t>(target_height)};
 
+  // When shrinking, stream scanlines straight into a target sized bitmap so
+  // that the full size image is never held in memory.
+  if (resized_dimensions.width() <= source_dimensions.width() &&
+      resized_dimensions.height() <= source_dimensions.height()) {
+    auto target_image_info =
+        descriptor->image_info().makeDimensions(resized_dimensions);
+    SkBitmap target_bitmap;
+    if (target_bitmap.tryAllocPixels(target_image_info) &&
+        descriptor->get_downscaled_pixels(target_bitmap.pixmap())) {
+      // Marking this as immutable makes the MakeFromBitmap call share
+      // the pixels instead of copying.
+      target_bitmap.setImmutable();
+      auto downscaled_image = SkImage::MakeFromBitmap(target_bitmap);
+      if (downscaled_image) {
+        return downscaled_image;
+      }
+    }
+  }
+
   auto decode_dimensions = descriptor->get_scaled_dimensions(
       std::max(static_cast<double>(resized_dimensions.width()) /
                    source_dimensions.width(),
@@ -212,6 +242,32 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+// Uploads a decompressed image on the IO thread, falling back to the image
+// itself when there is no resource context.
+static SkiaGPUObject<SkImage> UploadOnIOThread(
+    sk_sp<SkImage> image,
+    const fml::WeakPtr<IOManager>& io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  if (!io_manager) {
+    FML_DLOG(ERROR) << "Could not acquire IO manager.";
+    return {};
+  }
+
+  // If the IO manager does not have a resource context, the caller might not
+  // have set one or a software backend could be in use. Either way, just
+  // return the image as-is.
+  if (!io_manager->GetResourceContext()) {
+    return {std::move(image), io_manager->GetSkiaUnrefQueue()};
+  }
+
+  auto uploaded = UploadRasterImage(std::move(image), io_manager, flow);
+  if (!uploaded.skia_object()) {
+    FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+    return {};
+  }
+  return uploaded;
+}
+
 // |ImageDecoder|
 void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                               uint32_t target_width,
@@ -269,18 +325,35 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                          target_height = target_height,           //
                          flow = std::move(flow)                   //
   ]() mutable {
-        // Step 1: Decompress the image.
+        // Step 1: Decompress the image, unless another engine in the process
+        // already has.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
+        auto& cache = DecodedImageCache::GetInstance();
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (raw_descriptor->is_compressed() && cache.IsEnabled()) {
+          cache_key.emplace(raw_descriptor->data(),
+                            GetDecompressedImageInfo(
+                                *raw_descriptor, target_width, target_height));
+        }
+
+        sk_sp<SkImage> decompressed =
+            cache_key ? cache.GetRasterImage(*cache_key) : nullptr;
+        if (!decompressed) {
+          decompressed =
+              raw_descriptor->is_compressed()
+                  ? ImageFromCompressedData(raw_descriptor,  //
+                                            target_width,    //
+                                            target_height,   //
+                                            flow)
+                  : ImageFromDecompressedData(raw_descriptor,  //
+                                              target_width,    //
+                                              target_height,   //
+                                              flow);
+          if (decompressed && cache_key) {
+            cache.PutRasterImage(*cache_key, decompressed);
+          }
+        }
 
         if (!decompressed) {
           FML_DLOG(ERROR) << "Could not decompress image.";
@@ -294,34 +367,36 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
                                                flow =
                                                    std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
           auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
+              UploadOnIOThread(std::move(decompressed), io_manager, flow);
           result(std::move(uploaded), std::move(flow));
         }));
       }));
 }
 
+// |ImageDecoder|
+void ImageDecoderSkia::Upload(sk_sp<SkImage> image,
+                              const ImageResult& callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  fml::tracing::TraceFlow flow(__FUNCTION__);
+
+  FML_DCHECK(callback);
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [image = std::move(image), callback, io_manager = io_manager_,
+       ui_runner = runners_.GetUITaskRunner(),
+       flow = std::move(flow)]() mutable {
+        auto uploaded = image ? UploadOnIOThread(image, io_manager, flow)
+                              : SkiaGPUObject<SkImage>{};
+        ui_runner->PostTask(fml::MakeCopyable(
+            [callback, uploaded = std::move(uploaded),
+             flow = std::move(flow)]() mutable {
+              TRACE_EVENT0("flutter", "ImageUploadCallback");
+              flow.End();
+              callback(DlImageGPU::Make(std::move(uploaded)));
+            }));
+      }));
+}
+
 }  // namespace flutter
@@ -25,6 +25,15 @@ class ImageDecoderSkia final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  // |ImageDecoder|
+  void Upload(sk_sp<SkImage> image, const ImageResult& result) override;
+
+  // The info of the image |ImageFromCompressedData| produces for the same
+  // arguments.
+  static SkImageInfo GetDecompressedImageInfo(const ImageDescriptor& descriptor,
+                                              uint32_t target_width,
+                                              uint32_t target_height);
+
   static sk_sp<SkImage> ImageFromCompressedData(
       ImageDescriptor* descriptor,
       uint32_t target_width,
@@ -9,6 +9,8 @@
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/progressive_image_decoder.h"
+#include "flutter/lib/ui/painting/scanline_downsampler.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/dart_isolate_runner.h"
@@ -518,6 +520,42 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderTest, DecompressedImageInfoMatchesTheDecodedImage) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+  // Decoded image cache keys are made from these infos, so they must
+  // describe exactly what the decoders produce.
+  for (auto size : {SkISize::Make(600, 200), SkISize::Make(6, 2),
+                    SkISize::Make(1200, 400)}) {
+    auto image = ImageDecoderSkia::ImageFromCompressedData(
+        descriptor.get(), size.width(), size.height(),
+        fml::tracing::TraceFlow(""));
+    ASSERT_TRUE(image);
+    auto info = ImageDecoderSkia::GetDecompressedImageInfo(
+        *descriptor, size.width(), size.height());
+    ASSERT_EQ(image->dimensions(), info.dimensions());
+    ASSERT_EQ(image->colorType(), info.colorType());
+    ASSERT_EQ(image->alphaType(), info.alphaType());
+
+#if IMPELLER_SUPPORTS_RENDERING
+    auto bitmap = ImageDecoderImpeller::DecompressTexture(descriptor.get(),
+                                                          size, {1000, 1000});
+    ASSERT_TRUE(bitmap);
+    info = ImageDecoderImpeller::GetDecompressedImageInfo(*descriptor, size,
+                                                          {1000, 1000});
+    ASSERT_EQ(bitmap->dimensions(), info.dimensions());
+    ASSERT_EQ(bitmap->colorType(), info.colorType());
+    ASSERT_EQ(bitmap->alphaType(), info.alphaType());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  }
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
 
@@ -551,6 +589,87 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, ScanlineDownsamplerAveragesCoveredPixels) {
+  SkBitmap source;
+  ASSERT_TRUE(source.tryAllocPixels(SkImageInfo::MakeN32Premul(4, 2)));
+  // Left half white, right half black.
+  source.eraseColor(SK_ColorBLACK);
+  source.erase(SK_ColorWHITE, SkIRect::MakeWH(2, 2));
+
+  SkBitmap destination;
+  ASSERT_TRUE(destination.tryAllocPixels(SkImageInfo::MakeN32Premul(2, 1)));
+  ASSERT_TRUE(
+      ScanlineDownsampler::Downsample(source.pixmap(), destination.pixmap()));
+  ASSERT_EQ(destination.getColor(0, 0), SK_ColorWHITE);
+  ASSERT_EQ(destination.getColor(1, 0), SK_ColorBLACK);
+
+  // Reducing by a non-integer factor straddles the boundary.
+  SkBitmap straddle;
+  ASSERT_TRUE(straddle.tryAllocPixels(SkImageInfo::MakeN32Premul(3, 1)));
+  ASSERT_TRUE(
+      ScanlineDownsampler::Downsample(source.pixmap(), straddle.pixmap()));
+  ASSERT_EQ(straddle.getColor(0, 0), SK_ColorWHITE);
+  ASSERT_EQ(SkColorGetR(straddle.getColor(1, 0)), 128u);
+  ASSERT_EQ(straddle.getColor(2, 0), SK_ColorBLACK);
+}
+
+TEST(ImageDecoderTest, ScanlineDownsamplerRejectsUpscalingAndUnpremul) {
+  ASSERT_FALSE(ScanlineDownsampler::CanDownsample(
+      SkISize::Make(10, 10), SkImageInfo::MakeN32Premul(20, 5)));
+  ASSERT_FALSE(ScanlineDownsampler::CanDownsample(
+      SkISize::Make(10, 10),
+      SkImageInfo::MakeN32(5, 5, kUnpremul_SkAlphaType)));
+  ASSERT_FALSE(ScanlineDownsampler::CanDownsample(
+      SkISize::Make(10, 10), SkImageInfo::MakeA8(5, 5)));
+  ASSERT_TRUE(ScanlineDownsampler::CanDownsample(
+      SkISize::Make(10, 10), SkImageInfo::MakeN32Premul(10, 10)));
+}
+
+TEST(ImageDecoderTest, DownscaledDecodingMatchesTargetSize) {
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(descriptor->image_info().makeWH(
+      descriptor->width() / 3, descriptor->height() / 3)));
+  ASSERT_TRUE(descriptor->get_downscaled_pixels(bitmap.pixmap()));
+
+  auto image = ImageDecoderSkia::ImageFromCompressedData(
+      descriptor.get(), descriptor->width() / 3, descriptor->height() / 3,
+      fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), bitmap.dimensions());
+
+  // Upscaling is never done by scanline.
+  SkBitmap larger;
+  ASSERT_TRUE(larger.tryAllocPixels(descriptor->image_info().makeWH(
+      descriptor->width() * 2, descriptor->height() * 2)));
+  ASSERT_FALSE(descriptor->get_downscaled_pixels(larger.pixmap()));
+}
+
+TEST(ImageDecoderTest, DownscaledDecodingSkipsExifOrientedImages) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(descriptor->image_info().makeWH(6, 2)));
+  ASSERT_FALSE(descriptor->get_downscaled_pixels(bitmap.pixmap()));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -706,5 +825,127 @@ TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDidAccessGpuDisabledSyncSwitch) {
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+static void FeedInChunks(ProgressiveImageDecoder* decoder,
+                         const sk_sp<SkData>& data,
+                         size_t begin,
+                         size_t end,
+                         size_t chunk_size) {
+  for (size_t offset = begin; offset < end; offset += chunk_size) {
+    decoder->AddChunk(SkData::MakeSubset(data.get(), offset,
+                                         std::min(chunk_size, end - offset)));
+  }
+}
+
+TEST_F(ImageDecoderFixtureTest,
+       ProgressiveDecoderDeliversIntermediateAndFinalFrames) {
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  ASSERT_TRUE(data);
+  auto expected = SkImage::MakeFromEncoded(data);
+  ASSERT_TRUE(expected);
+
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto callback_runner = CreateNewThread();
+
+  // Written on the callback runner, and only read once the final frame has
+  // been delivered.
+  fml::AutoResetWaitableEvent intermediate_latch;
+  fml::AutoResetWaitableEvent final_latch;
+  bool callbacks_on_runner = true;
+  std::vector<sk_sp<SkImage>> intermediate_frames;
+  sk_sp<SkImage> final_image;
+  auto decoder = ProgressiveImageDecoder::Make(
+      loop->GetTaskRunner(), callback_runner,
+      [&](sk_sp<SkImage> image, bool is_final) {
+        callbacks_on_runner &= callback_runner->RunsTasksOnCurrentThread();
+        if (!is_final) {
+          intermediate_frames.push_back(std::move(image));
+          if (intermediate_frames.size() == 1) {
+            intermediate_latch.Signal();
+          }
+          return;
+        }
+        final_image = std::move(image);
+        final_latch.Signal();
+      });
+
+  // Half of the rows of a non-interlaced PNG can be decoded from the first
+  // half of its data, so a partial frame must arrive before the rest does.
+  const size_t half = data->size() / 2;
+  FeedInChunks(decoder.get(), data, 0, half, 512);
+  intermediate_latch.Wait();
+  FeedInChunks(decoder.get(), data, half, data->size(), 512);
+  decoder->Finish();
+  final_latch.Wait();
+
+  ASSERT_TRUE(callbacks_on_runner);
+  ASSERT_GT(intermediate_frames.size(), 0u);
+  for (const auto& frame : intermediate_frames) {
+    ASSERT_TRUE(frame);
+    ASSERT_EQ(frame->dimensions(), expected->dimensions());
+  }
+  ASSERT_TRUE(final_image);
+  ASSERT_EQ(final_image->dimensions(), expected->dimensions());
+  ASSERT_EQ(decoder->GetBytesReceived(), data->size());
+  ASSERT_TRUE(final_image->encodeToData(SkEncodedImageFormat::kPNG, 100)
+                  ->equals(expected->encodeToData(SkEncodedImageFormat::kPNG,
+                                                  100)
+                               .get()));
+  // Chunks race with decode passes, so the exact count varies, but the
+  // decoder must never deliver more frames than chunks.
+  ASSERT_LE(intermediate_frames.size(), data->size() / 512 + 1);
+}
+
+TEST_F(ImageDecoderFixtureTest, ProgressiveDecoderHandlesNonIncrementalCodecs) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ASSERT_TRUE(data);
+  auto expected = SkImage::MakeFromEncoded(data);
+  ASSERT_TRUE(expected);
+
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto callback_runner = CreateNewThread();
+
+  fml::AutoResetWaitableEvent latch;
+  sk_sp<SkImage> final_image;
+  auto decoder = ProgressiveImageDecoder::Make(
+      loop->GetTaskRunner(), callback_runner,
+      [&](sk_sp<SkImage> image, bool is_final) {
+        if (is_final) {
+          final_image = std::move(image);
+          latch.Signal();
+        }
+      });
+
+  FeedInChunks(decoder.get(), data, 0, data->size(), 4096);
+  decoder->Finish();
+  latch.Wait();
+
+  ASSERT_TRUE(final_image);
+  ASSERT_EQ(final_image->dimensions(), expected->dimensions());
+}
+
+TEST_F(ImageDecoderFixtureTest, ProgressiveDecoderReportsInvalidData) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto callback_runner = CreateNewThread();
+
+  fml::AutoResetWaitableEvent latch;
+  bool got_final = false;
+  sk_sp<SkImage> final_image;
+  auto decoder = ProgressiveImageDecoder::Make(
+      loop->GetTaskRunner(), callback_runner,
+      [&](sk_sp<SkImage> image, bool is_final) {
+        got_final = is_final;
+        final_image = std::move(image);
+        latch.Signal();
+      });
+
+  std::vector<uint8_t> garbage(1024, 0xAB);
+  decoder->AddChunk(SkData::MakeWithCopy(garbage.data(), garbage.size()));
+  decoder->Finish();
+  latch.Wait();
+
+  ASSERT_TRUE(got_final);
+  ASSERT_FALSE(final_image);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,10 +4,14 @@
 
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/scanline_downsampler.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -126,4 +130,52 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_downscaled_pixels(const SkPixmap& pixmap) const {
+  TRACE_EVENT0("flutter", "ImageDescriptor::get_downscaled_pixels");
+  if (!generator_ || !buffer_ || generator_->GetFrameCount() != 1) {
+    return false;
+  }
+  if (!ScanlineDownsampler::CanDownsample(image_info_.dimensions(),
+                                          pixmap.info())) {
+    return false;
+  }
+
+  // Scanline decoding does not apply the EXIF orientation that the generator
+  // does, so only images that need no correction can take this path.
+  auto codec = SkCodec::MakeFromData(buffer_);
+  if (!codec || codec->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec->dimensions() != image_info_.dimensions()) {
+    return false;
+  }
+
+  // Let the codec do as much of the work as it can natively (e.g. JPEG DCT
+  // scaling) without going below the target size.
+  const SkISize source_size = codec->dimensions();
+  SkISize decode_size = codec->getScaledDimensions(std::max(
+      static_cast<float>(pixmap.width()) / source_size.width(),
+      static_cast<float>(pixmap.height()) / source_size.height()));
+  if (decode_size.width() < pixmap.width() ||
+      decode_size.height() < pixmap.height()) {
+    decode_size = source_size;
+  }
+
+  const auto decode_info = pixmap.info().makeDimensions(decode_size);
+  if (codec->startScanlineDecode(decode_info) != SkCodec::kSuccess ||
+      codec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+
+  std::vector<uint32_t> scanline(decode_size.width());
+  ScanlineDownsampler downsampler(decode_size, pixmap);
+  for (int y = 0; y < decode_size.height(); y++) {
+    if (codec->getScanlines(scanline.data(), 1, decode_info.minRowBytes()) !=
+        1) {
+      FML_DLOG(ERROR) << "Could not decode scanline " << y << ".";
+      return false;
+    }
+    downsampler.AddRow(scanline.data());
+  }
+  return downsampler.IsComplete();
+}
+
 }  // namespace flutter
@@ -108,6 +108,17 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Decodes this image directly into a smaller `pixmap`, streaming
+  ///         scanlines from the codec's closest natively scaled size through
+  ///         a `ScanlineDownsampler`. Peak memory is bounded by the size of
+  ///         `pixmap` rather than by the size of the decoded image.
+  /// @return False if the encoded data can not be decoded this way (for
+  ///         example because it is EXIF oriented, animated, or handled by a
+  ///         custom `ImageGenerator`), in which case callers should fall back
+  ///         to `get_pixels` followed by a resize.
+  /// @see    `ScanlineDownsampler`
+  bool get_downscaled_pixels(const SkPixmap& pixmap) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
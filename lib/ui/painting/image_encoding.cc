@@ -5,7 +5,9 @@
 #include "flutter/lib/ui/painting/image_encoding.h"
 #include "flutter/lib/ui/painting/image_encoding_impl.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "flutter/common/task_runners.h"
@@ -13,6 +15,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_encoding_parallel.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
 #endif  // IMPELLER_SUPPORTS_RENDERING
@@ -38,6 +41,7 @@ enum ImageByteFormat {
   kRawStraightRGBA,
   kRawUnmodified,
   kPNG,
+  kQOI,
 };
 
 void FinalizeSkData(void* isolate_callback_data, void* peer) {
@@ -104,16 +108,30 @@ sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
-sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
-                          ImageByteFormat format) {
+sk_sp<SkData> EncodeImage(
+    const sk_sp<SkImage>& raster_image,
+    ImageByteFormat format,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
   if (!raster_image) {
     return nullptr;
   }
 
+  SkPixmap pixmap;
   switch (format) {
     case kPNG: {
+      // Compress bands of the image on all workers when the pixels are
+      // directly accessible and 8-bit sRGB. Otherwise fall back to Skia's
+      // serial encoder, which preserves wide gamut and high precision pixels.
+      if (raster_image->peekPixels(&pixmap) && CanEncodePNGInBands(pixmap)) {
+        auto png_image = EncodePNGInBands(
+            pixmap, concurrent_task_runner,
+            std::max(std::thread::hardware_concurrency(), 1u));
+        if (png_image) {
+          return png_image;
+        }
+      }
       auto png_image =
           raster_image->encodeToData(SkEncodedImageFormat::kPNG, 0);
 
@@ -135,6 +153,17 @@ sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
       return CopyImageByteData(raster_image, raster_image->colorType(),
                                raster_image->alphaType());
     } break;
+    case kQOI: {
+      if (!raster_image->peekPixels(&pixmap)) {
+        FML_LOG(ERROR) << "Could not read pixels of the raster image.";
+        return nullptr;
+      }
+      auto qoi_image = EncodeQOI(pixmap);
+      if (qoi_image == nullptr) {
+        FML_LOG(ERROR) << "Could not convert raster image to QOI.";
+      }
+      return qoi_image;
+    } break;
   }
 
   FML_LOG(ERROR) << "Unknown error encoding image.";
@@ -148,6 +177,7 @@ void EncodeImageAndInvokeDataCallback(
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
     const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
     const fml::WeakPtr<GrDirectContext>& resource_context,
     const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
@@ -161,12 +191,24 @@ void EncodeImageAndInvokeDataCallback(
   // EncodeImage.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](const sk_sp<SkImage>& raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(raster_image, format);
-    ui_task_runner->PostTask([callback_task = callback_task,
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      ui_task_runner, concurrent_task_runner](
+                         const sk_sp<SkImage>& raster_image) {
+    // Encoding is CPU bound and does not need a GPU context, so move it off
+    // the raster or IO thread the image was converted on.
+    auto encode_and_respond = [callback_task, format, ui_task_runner,
+                               concurrent_task_runner, raster_image]() {
+      sk_sp<SkData> encoded =
+          EncodeImage(raster_image, format, concurrent_task_runner);
+      ui_task_runner->PostTask([callback_task = callback_task,
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(encode_and_respond);
+    } else {
+      encode_and_respond();
+    }
   };
 
   FML_DCHECK(image);
@@ -210,13 +252,15 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate = UIDartState::Current()->GetSnapshotDelegate(),
        is_impeller_enabled =
            UIDartState::Current()->IsImpellerEnabled()]() mutable {
         EncodeImageAndInvokeDataCallback(
             image, std::move(callback), image_format, ui_task_runner,
-            raster_task_runner, io_task_runner,
+            raster_task_runner, io_task_runner, concurrent_task_runner,
             io_manager->GetResourceContext(), snapshot_delegate,
             io_manager->GetIsGpuDisabledSyncSwitch(),
             io_manager->GetImpellerContext(), is_impeller_enabled);
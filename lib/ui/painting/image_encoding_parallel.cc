@@ -0,0 +1,406 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_encoding_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+// Bands smaller than this compress noticeably worse, and the cost of
+// dispatching them outweighs the parallelism gained.
+constexpr int kMinRowsPerBand = 32;
+
+// More bands than threads keeps all threads busy when bands take different
+// amounts of time to compress.
+constexpr size_t kBandsPerThread = 2;
+
+constexpr uint8_t kPNGSignature[] = {0x89, 'P',  'N',  'G',
+                                     '\r', '\n', 0x1A, '\n'};
+
+// CMF and FLG bytes for a deflate stream with a 32K window at the default
+// compression level.
+constexpr uint8_t kZlibHeader[] = {0x78, 0x9C};
+
+enum PNGFilter : uint8_t {
+  kNone = 0,
+  kSub = 1,
+  kUp = 2,
+  kAverage = 3,
+  kPaeth = 4,
+  kFilterCount = 5,
+};
+
+void AppendBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void AppendPNGChunk(std::vector<uint8_t>& out,
+                    const char type[4],
+                    const uint8_t* data,
+                    size_t length) {
+  AppendBigEndian32(out, static_cast<uint32_t>(length));
+  const auto type_bytes = reinterpret_cast<const uint8_t*>(type);
+  out.insert(out.end(), type_bytes, type_bytes + 4);
+  if (length > 0) {
+    out.insert(out.end(), data, data + length);
+  }
+  uLong crc = crc32(0L, Z_NULL, 0);
+  crc = crc32(crc, type_bytes, 4);
+  crc = crc32(crc, data, static_cast<uInt>(length));
+  AppendBigEndian32(out, static_cast<uint32_t>(crc));
+}
+
+uint8_t PaethPredictor(int a, int b, int c) {
+  const int p = a + b - c;
+  const int pa = std::abs(p - a);
+  const int pb = std::abs(p - b);
+  const int pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return static_cast<uint8_t>(a);
+  }
+  return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+// Filters one row with every filter type and keeps the one with the smallest
+// sum of absolute signed residuals, the heuristic libpng uses by default.
+void FilterRow(const uint8_t* row,
+               const uint8_t* previous_row,
+               size_t row_bytes,
+               uint8_t* scratch,
+               uint8_t* out) {
+  uint64_t best_sum = UINT64_MAX;
+  uint8_t best_filter = kNone;
+  for (uint8_t filter = kNone; filter < kFilterCount; filter++) {
+    uint8_t* candidate = scratch + filter * row_bytes;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < row_bytes; i++) {
+      const int a = i >= kBytesPerPixel ? row[i - kBytesPerPixel] : 0;
+      const int b = previous_row[i];
+      const int c = i >= kBytesPerPixel ? previous_row[i - kBytesPerPixel] : 0;
+      uint8_t predicted = 0;
+      switch (filter) {
+        case kNone:
+          predicted = 0;
+          break;
+        case kSub:
+          predicted = a;
+          break;
+        case kUp:
+          predicted = b;
+          break;
+        case kAverage:
+          predicted = static_cast<uint8_t>((a + b) >> 1);
+          break;
+        case kPaeth:
+          predicted = PaethPredictor(a, b, c);
+          break;
+      }
+      const auto residual = static_cast<uint8_t>(row[i] - predicted);
+      candidate[i] = residual;
+      sum += std::abs(static_cast<int8_t>(residual));
+    }
+    if (sum < best_sum) {
+      best_sum = sum;
+      best_filter = filter;
+    }
+  }
+  out[0] = best_filter;
+  ::memcpy(out + 1, scratch + best_filter * row_bytes, row_bytes);
+}
+
+struct Band {
+  int first_row = 0;
+  int row_count = 0;
+  bool is_last = false;
+  std::vector<uint8_t> compressed;
+  uLong adler = 0;
+  size_t filtered_size = 0;
+  bool success = false;
+};
+
+bool Deflate(const std::vector<uint8_t>& input, Band* band) {
+  z_stream stream = {};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   -MAX_WBITS,  // Raw deflate. The zlib wrapper is shared.
+                   8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  // A sync flush appends an empty stored block to the bound.
+  band->compressed.resize(deflateBound(&stream, input.size()) + 16);
+  stream.next_in = const_cast<Bytef*>(input.data());
+  stream.avail_in = static_cast<uInt>(input.size());
+
+  // Every band but the last ends with a sync flush so that it stops on a byte
+  // boundary without marking the final block.
+  const int flush = band->is_last ? Z_FINISH : Z_SYNC_FLUSH;
+  int result = Z_OK;
+  do {
+    if (stream.total_out == band->compressed.size()) {
+      band->compressed.resize(band->compressed.size() * 2);
+    }
+    stream.next_out = band->compressed.data() + stream.total_out;
+    stream.avail_out =
+        static_cast<uInt>(band->compressed.size() - stream.total_out);
+    result = deflate(&stream, flush);
+  } while ((flush == Z_FINISH && result == Z_OK) ||
+           (flush == Z_SYNC_FLUSH && result == Z_OK && stream.avail_out == 0));
+
+  const bool success = flush == Z_FINISH
+                           ? result == Z_STREAM_END
+                           : result == Z_OK && stream.avail_in == 0;
+  band->compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  return success;
+}
+
+bool EncodeBand(const SkPixmap& pixmap, Band* band) {
+  TRACE_EVENT0("flutter", "EncodePNGBand");
+  const size_t row_bytes = static_cast<size_t>(pixmap.width()) * kBytesPerPixel;
+
+  // Filters predict from the row above, so read one extra row when the band
+  // does not start at the top of the image.
+  const int context_rows = band->first_row > 0 ? 1 : 0;
+  const int rows_to_read = band->row_count + context_rows;
+  std::vector<uint8_t> pixels(rows_to_read * row_bytes);
+  const auto info = SkImageInfo::Make(pixmap.width(), rows_to_read,
+                                      kRGBA_8888_SkColorType,
+                                      kUnpremul_SkAlphaType);
+  if (!pixmap.readPixels(info, pixels.data(), row_bytes, 0,
+                         band->first_row - context_rows)) {
+    FML_LOG(ERROR) << "Could not convert pixels for PNG encoding.";
+    return false;
+  }
+
+  const std::vector<uint8_t> zero_row(row_bytes, 0);
+  std::vector<uint8_t> scratch(row_bytes * kFilterCount);
+  std::vector<uint8_t> filtered(band->row_count * (row_bytes + 1));
+  for (int row = 0; row < band->row_count; row++) {
+    const uint8_t* current = pixels.data() + (row + context_rows) * row_bytes;
+    const uint8_t* previous =
+        row + context_rows > 0 ? current - row_bytes : zero_row.data();
+    FilterRow(current, previous, row_bytes, scratch.data(),
+              filtered.data() + row * (row_bytes + 1));
+  }
+
+  band->filtered_size = filtered.size();
+  band->adler = adler32(adler32(0L, Z_NULL, 0), filtered.data(),
+                        static_cast<uInt>(filtered.size()));
+  return Deflate(filtered, band);
+}
+
+// State shared with the helper tasks. Helpers that start after every band
+// has been claimed return without touching the pixels, so the state may
+// outlive the call that created it.
+struct EncodeState {
+  EncodeState(const SkPixmap& p_pixmap, std::vector<Band> p_bands)
+      : pixmap(p_pixmap), bands(std::move(p_bands)), latch(bands.size()) {}
+
+  const SkPixmap pixmap;
+  std::vector<Band> bands;
+  std::atomic<size_t> next_band = 0;
+  fml::CountDownLatch latch;
+
+  void EncodeRemainingBands() {
+    while (true) {
+      const size_t index = next_band.fetch_add(1);
+      if (index >= bands.size()) {
+        return;
+      }
+      bands[index].success = EncodeBand(pixmap, &bands[index]);
+      latch.CountDown();
+    }
+  }
+};
+
+}  // namespace
+
+bool CanEncodePNGInBands(const SkPixmap& pixmap) {
+  switch (pixmap.colorType()) {
+    case kRGBA_8888_SkColorType:
+    case kBGRA_8888_SkColorType:
+      break;
+    default:
+      return false;
+  }
+  return pixmap.colorSpace() == nullptr || pixmap.colorSpace()->isSRGB();
+}
+
+sk_sp<SkData> EncodePNGInBands(
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::BasicTaskRunner>& runner,
+    size_t concurrency) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  if (pixmap.addr() == nullptr || pixmap.width() <= 0 ||
+      pixmap.height() <= 0 || !CanEncodePNGInBands(pixmap)) {
+    return nullptr;
+  }
+
+  concurrency = runner ? std::max<size_t>(concurrency, 1) : 1;
+  const int band_count = std::clamp<int>(
+      pixmap.height() / kMinRowsPerBand, 1,
+      static_cast<int>(concurrency * kBandsPerThread));
+  const int rows_per_band = (pixmap.height() + band_count - 1) / band_count;
+
+  std::vector<Band> bands;
+  for (int row = 0; row < pixmap.height(); row += rows_per_band) {
+    Band band;
+    band.first_row = row;
+    band.row_count = std::min(rows_per_band, pixmap.height() - row);
+    bands.push_back(std::move(band));
+  }
+  bands.back().is_last = true;
+
+  auto state = std::make_shared<EncodeState>(pixmap, std::move(bands));
+  const size_t helpers = std::min(concurrency, state->bands.size()) - 1;
+  for (size_t i = 0; i < helpers; i++) {
+    runner->PostTask([state]() { state->EncodeRemainingBands(); });
+  }
+  state->EncodeRemainingBands();
+  state->latch.Wait();
+
+  std::vector<uint8_t> png(std::begin(kPNGSignature), std::end(kPNGSignature));
+
+  std::vector<uint8_t> header;
+  AppendBigEndian32(header, pixmap.width());
+  AppendBigEndian32(header, pixmap.height());
+  header.push_back(8);  // Bit depth.
+  header.push_back(6);  // Color type: RGBA.
+  header.push_back(0);  // Compression method: deflate.
+  header.push_back(0);  // Filter method: adaptive.
+  header.push_back(0);  // Interlace method: none.
+  AppendPNGChunk(png, "IHDR", header.data(), header.size());
+
+  uLong adler = adler32(0L, Z_NULL, 0);
+  for (size_t i = 0; i < state->bands.size(); i++) {
+    const auto& band = state->bands[i];
+    if (!band.success) {
+      FML_LOG(ERROR) << "Could not compress PNG image data.";
+      return nullptr;
+    }
+    adler = i == 0 ? band.adler
+                   : adler32_combine(adler, band.adler,
+                                     static_cast<z_off_t>(band.filtered_size));
+
+    std::vector<uint8_t> data;
+    if (i == 0) {
+      data.assign(std::begin(kZlibHeader), std::end(kZlibHeader));
+    }
+    data.insert(data.end(), band.compressed.begin(), band.compressed.end());
+    if (band.is_last) {
+      AppendBigEndian32(data, static_cast<uint32_t>(adler));
+    }
+    AppendPNGChunk(png, "IDAT", data.data(), data.size());
+  }
+
+  AppendPNGChunk(png, "IEND", nullptr, 0);
+  return SkData::MakeWithCopy(png.data(), png.size());
+}
+
+sk_sp<SkData> EncodeQOI(const SkPixmap& pixmap) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  if (pixmap.addr() == nullptr || pixmap.width() <= 0 ||
+      pixmap.height() <= 0) {
+    return nullptr;
+  }
+
+  const size_t pixel_count =
+      static_cast<size_t>(pixmap.width()) * pixmap.height();
+  std::vector<uint8_t> pixels(pixel_count * kBytesPerPixel);
+  const auto info =
+      SkImageInfo::Make(pixmap.width(), pixmap.height(),
+                        kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+  if (!pixmap.readPixels(info, pixels.data(), info.minRowBytes(), 0, 0)) {
+    FML_LOG(ERROR) << "Could not convert pixels for QOI encoding.";
+    return nullptr;
+  }
+
+  std::vector<uint8_t> out;
+  out.reserve(14 + pixel_count * 2 + 8);
+  out.insert(out.end(), {'q', 'o', 'i', 'f'});
+  AppendBigEndian32(out, pixmap.width());
+  AppendBigEndian32(out, pixmap.height());
+  out.push_back(4);  // Channels: RGBA.
+  out.push_back(0);  // Colorspace: sRGB with linear alpha.
+
+  constexpr uint8_t kOpIndex = 0x00;
+  constexpr uint8_t kOpDiff = 0x40;
+  constexpr uint8_t kOpLuma = 0x80;
+  constexpr uint8_t kOpRun = 0xC0;
+  constexpr uint8_t kOpRGB = 0xFE;
+  constexpr uint8_t kOpRGBA = 0xFF;
+  constexpr int kMaxRun = 62;
+
+  uint8_t index[64][4] = {};
+  uint8_t previous[4] = {0, 0, 0, 255};
+  int run = 0;
+  for (size_t i = 0; i < pixel_count; i++) {
+    const uint8_t* pixel = pixels.data() + i * kBytesPerPixel;
+    if (::memcmp(pixel, previous, kBytesPerPixel) == 0) {
+      run++;
+      if (run == kMaxRun || i == pixel_count - 1) {
+        out.push_back(kOpRun | (run - 1));
+        run = 0;
+      }
+      continue;
+    }
+
+    if (run > 0) {
+      out.push_back(kOpRun | (run - 1));
+      run = 0;
+    }
+
+    const uint8_t r = pixel[0], g = pixel[1], b = pixel[2], a = pixel[3];
+    const int hash = (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+    if (::memcmp(index[hash], pixel, kBytesPerPixel) == 0) {
+      out.push_back(kOpIndex | hash);
+    } else {
+      ::memcpy(index[hash], pixel, kBytesPerPixel);
+      if (a == previous[3]) {
+        const int8_t vr = static_cast<int8_t>(r - previous[0]);
+        const int8_t vg = static_cast<int8_t>(g - previous[1]);
+        const int8_t vb = static_cast<int8_t>(b - previous[2]);
+        const int vg_r = vr - vg;
+        const int vg_b = vb - vg;
+        if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+          out.push_back(kOpDiff | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+        } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 &&
+                   vg_b > -9 && vg_b < 8) {
+          out.push_back(kOpLuma | (vg + 32));
+          out.push_back((vg_r + 8) << 4 | (vg_b + 8));
+        } else {
+          out.insert(out.end(), {kOpRGB, r, g, b});
+        }
+      } else {
+        out.insert(out.end(), {kOpRGBA, r, g, b, a});
+      }
+    }
+    ::memcpy(previous, pixel, kBytesPerPixel);
+  }
+
+  // End marker.
+  out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+  return SkData::MakeWithCopy(out.data(), out.size());
+}
+
+}  // namespace flutter
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_PARALLEL_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_PARALLEL_H_
+
+#include <memory>
+
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Whether |EncodePNGInBands| can encode `pixmap` without losing
+///             precision or color information.
+///
+///             The encoder writes 8-bit RGBA without color space chunks, so
+///             only 8-bit RGBA or BGRA pixels in sRGB, or without a color
+///             space, are supported. Others should be encoded by Skia, which
+///             preserves them.
+///
+bool CanEncodePNGInBands(const SkPixmap& pixmap);
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes pixels as an 8-bit RGBA PNG, filtering and deflating
+///             horizontal bands of rows concurrently.
+///
+///             Each band is compressed as an independent deflate stream that
+///             ends on a byte boundary without the final block flag, so the
+///             streams can be concatenated into the single zlib stream a PNG
+///             requires. The checksums of the bands are combined instead of
+///             recomputed. Compression is marginally worse than that of a
+///             serial encoder because matches can not span bands.
+///
+///             The calling thread encodes bands too, and only waits on bands
+///             that a helper task has already started. It is therefore safe
+///             to call this on a worker of the same concurrent runner the
+///             helpers are posted to.
+///
+/// @param[in]  pixmap       The pixels to encode. Only pixmaps that
+///                          |CanEncodePNGInBands| accepts are supported.
+/// @param[in]  runner       Where helper tasks are posted. May be null, in
+///                          which case all bands are encoded on the calling
+///                          thread.
+/// @param[in]  concurrency  The maximum number of threads, including the
+///                          calling thread, that encode bands.
+///
+/// @return     The encoded PNG, or null if the pixels could not be encoded.
+///
+sk_sp<SkData> EncodePNGInBands(
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::BasicTaskRunner>& runner,
+    size_t concurrency);
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes pixels as an RGBA "Quite OK Image" (QOI). QOI is a
+///             lossless format that encodes and decodes several times faster
+///             than PNG at a somewhat larger size, which suits captures that
+///             are written out or sent elsewhere rather than kept small.
+///
+/// @see        https://qoiformat.org/qoi-specification.pdf
+///
+/// @return     The encoded image, or null if the pixels could not be encoded.
+///
+sk_sp<SkData> EncodeQOI(const SkPixmap& pixmap);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_PARALLEL_H_
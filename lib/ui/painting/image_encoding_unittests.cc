@@ -6,13 +6,17 @@
 #include "flutter/lib/ui/painting/image_encoding_impl.h"
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_encoding_parallel.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
 
 // CREATE_NATIVE_ENTRY is leaky by design
 // NOLINTBEGIN(clang-analyzer-core.StackAddressEscape)
@@ -166,6 +170,99 @@ TEST_F(ShellTest, EncodeImageAccessesSyncSwitch) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+static SkBitmap MakeGradientBitmap(int width, int height) {
+  SkBitmap bitmap;
+  FML_CHECK(bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(width, height)));
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      // Opaque, so that the conversion to straight alpha is lossless.
+      *bitmap.getAddr32(x, y) =
+          SkPreMultiplyARGB(255, x % 256, y % 256, (x * y) % 256);
+    }
+  }
+  return bitmap;
+}
+
+TEST(ImageEncodingTest, PNGEncodedInBandsDecodesToTheSamePixels) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto bitmap = MakeGradientBitmap(300, 517);
+
+  for (size_t concurrency : {1u, 4u}) {
+    auto png = EncodePNGInBands(bitmap.pixmap(), loop->GetTaskRunner(),
+                                concurrency);
+    ASSERT_TRUE(png);
+
+    auto decoded = SkImage::MakeFromEncoded(png);
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(decoded->dimensions(), bitmap.dimensions());
+
+    SkBitmap decoded_bitmap;
+    ASSERT_TRUE(decoded_bitmap.tryAllocPixels(bitmap.info()));
+    ASSERT_TRUE(decoded->readPixels(decoded_bitmap.pixmap(), 0, 0));
+    ASSERT_EQ(::memcmp(decoded_bitmap.getPixels(), bitmap.getPixels(),
+                       bitmap.computeByteSize()),
+              0);
+  }
+}
+
+TEST(ImageEncodingTest, PNGEncodingInBandsWorksWithoutARunner) {
+  auto bitmap = MakeGradientBitmap(64, 64);
+  auto png = EncodePNGInBands(bitmap.pixmap(), nullptr, 8);
+  ASSERT_TRUE(png);
+  auto decoded = SkImage::MakeFromEncoded(png);
+  ASSERT_TRUE(decoded);
+  ASSERT_EQ(decoded->dimensions(), bitmap.dimensions());
+}
+
+TEST(ImageEncodingTest, PNGEncodingInBandsIsOnlyUsedFor8BitSRGB) {
+  const auto info =
+      SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+
+  SkBitmap untagged;
+  ASSERT_TRUE(untagged.tryAllocPixels(info));
+  ASSERT_TRUE(CanEncodePNGInBands(untagged.pixmap()));
+
+  SkBitmap srgb;
+  ASSERT_TRUE(
+      srgb.tryAllocPixels(info.makeColorType(kBGRA_8888_SkColorType)
+                              .makeColorSpace(SkColorSpace::MakeSRGB())));
+  ASSERT_TRUE(CanEncodePNGInBands(srgb.pixmap()));
+
+  SkBitmap wide_gamut;
+  ASSERT_TRUE(wide_gamut.tryAllocPixels(info.makeColorSpace(
+      SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                            SkNamedGamut::kDisplayP3))));
+  ASSERT_FALSE(CanEncodePNGInBands(wide_gamut.pixmap()));
+  ASSERT_EQ(EncodePNGInBands(wide_gamut.pixmap(), nullptr, 1), nullptr);
+
+  SkBitmap high_precision;
+  ASSERT_TRUE(high_precision.tryAllocPixels(
+      info.makeColorType(kRGBA_F16_SkColorType)));
+  ASSERT_FALSE(CanEncodePNGInBands(high_precision.pixmap()));
+  ASSERT_EQ(EncodePNGInBands(high_precision.pixmap(), nullptr, 1), nullptr);
+}
+
+TEST(ImageEncodingTest, QOIEncodesRunsAndDifferences) {
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(4, 1)));
+  bitmap.eraseColor(SK_ColorRED);
+
+  auto qoi = EncodeQOI(bitmap.pixmap());
+  ASSERT_TRUE(qoi);
+
+  const uint8_t expected[] = {
+      'q', 'o', 'i', 'f',  //
+      0, 0, 0, 4,          // Width.
+      0, 0, 0, 1,          // Height.
+      4, 0,                // Channels and colorspace.
+      0x5A,                // Difference from opaque black: r - 1 (wrapping).
+      0xC2,                // A run of the three remaining pixels.
+      0, 0, 0, 0, 0, 0, 0, 1,
+  };
+  ASSERT_EQ(qoi->size(), sizeof(expected));
+  ASSERT_EQ(::memcmp(qoi->data(), expected, sizeof(expected)), 0);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
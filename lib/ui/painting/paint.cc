@@ -34,13 +34,11 @@ constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
 constexpr int kDitherIndex = 13;
-constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
 constexpr int kColorFilterIndex = 1;
 constexpr int kImageFilterIndex = 2;
-constexpr int kObjectCount = 3;  // One larger than largest object index.
 
 // Must be kept in sync with the default in painting.dart.
 constexpr uint32_t kColorDefault = 0xFF000000;
@@ -195,72 +193,72 @@ bool Paint::sync_to(DisplayListBuilder* builder,
   if (isNull()) {
     return false;
   }
-  tonic::DartByteData byte_data(paint_data_);
-  FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
-
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
 
-  Dart_Handle values[kObjectCount];
-  if (Dart_IsNull(paint_objects_)) {
-    if (flags.applies_shader()) {
-      builder->setColorSource(nullptr);
-    }
-    if (flags.applies_color_filter()) {
-      builder->setColorFilter(nullptr);
-    }
-    if (flags.applies_image_filter()) {
-      builder->setImageFilter(nullptr);
-    }
-  } else {
+  Objects objects;
+  if (!Dart_IsNull(paint_objects_)) {
     FML_DCHECK(Dart_IsList(paint_objects_));
     intptr_t length = 0;
     Dart_ListLength(paint_objects_, &length);
 
     FML_CHECK(length == kObjectCount);
+    Dart_Handle values[kObjectCount];
     if (Dart_IsError(
             Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
       return false;
     }
+    objects = UnwrapObjects(values);
+  }
 
-    if (flags.applies_shader()) {
-      Dart_Handle shader = values[kShaderIndex];
-      if (Dart_IsNull(shader)) {
-        builder->setColorSource(nullptr);
-      } else {
-        if (Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader)) {
-          auto sampling =
-              ImageFilter::SamplingFromIndex(uint_data[kFilterQualityIndex]);
-          builder->setColorSource(decoded->shader(sampling).get());
-        } else {
-          builder->setColorSource(nullptr);
-        }
-      }
-    }
+  tonic::DartByteData byte_data(paint_data_);
+  FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+  SyncTo(builder, flags, objects, byte_data.data());
+  return true;
+}
 
-    if (flags.applies_color_filter()) {
-      Dart_Handle color_filter = values[kColorFilterIndex];
-      if (Dart_IsNull(color_filter)) {
-        builder->setColorFilter(nullptr);
-      } else {
-        ColorFilter* decoded =
-            tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
-        builder->setColorFilter(decoded->dl_filter());
-      }
-    }
+Paint::Objects Paint::UnwrapObjects(const Dart_Handle* values) {
+  Objects objects;
+  if (!Dart_IsNull(values[kShaderIndex])) {
+    objects.shader =
+        tonic::DartConverter<Shader*>::FromDart(values[kShaderIndex]);
+  }
+  if (!Dart_IsNull(values[kColorFilterIndex])) {
+    objects.color_filter =
+        tonic::DartConverter<ColorFilter*>::FromDart(values[kColorFilterIndex]);
+  }
+  if (!Dart_IsNull(values[kImageFilterIndex])) {
+    objects.image_filter =
+        tonic::DartConverter<ImageFilter*>::FromDart(values[kImageFilterIndex]);
+  }
+  return objects;
+}
 
-    if (flags.applies_image_filter()) {
-      Dart_Handle image_filter = values[kImageFilterIndex];
-      if (Dart_IsNull(image_filter)) {
-        builder->setImageFilter(nullptr);
-      } else {
-        ImageFilter* decoded =
-            tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
-        builder->setImageFilter(decoded->dl_filter());
-      }
+void Paint::SyncTo(DisplayListBuilder* builder,
+                   const DisplayListAttributeFlags& flags,
+                   const Objects& objects,
+                   const void* data) {
+  const uint32_t* uint_data = static_cast<const uint32_t*>(data);
+  const float* float_data = static_cast<const float*>(data);
+
+  if (flags.applies_shader()) {
+    if (objects.shader) {
+      auto sampling =
+          ImageFilter::SamplingFromIndex(uint_data[kFilterQualityIndex]);
+      builder->setColorSource(objects.shader->shader(sampling).get());
+    } else {
+      builder->setColorSource(nullptr);
     }
   }
 
+  if (flags.applies_color_filter()) {
+    builder->setColorFilter(
+        objects.color_filter ? objects.color_filter->dl_filter() : nullptr);
+  }
+
+  if (flags.applies_image_filter()) {
+    builder->setImageFilter(
+        objects.image_filter ? objects.image_filter->dl_filter() : nullptr);
+  }
+
   if (flags.applies_anti_alias()) {
     builder->setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
   }
@@ -327,8 +325,6 @@ bool Paint::sync_to(DisplayListBuilder* builder,
         break;
     }
   }
-
-  return true;
 }
 
 void Paint::toDlPaint(DlPaint& paint) const {
@@ -12,11 +12,39 @@
 
 namespace flutter {
 
+class ColorFilter;
+class ImageFilter;
+class Shader;
+
 class Paint {
  public:
+  // Must be kept in sync with the constants of the same name in painting.dart.
+  static constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
+  static constexpr int kObjectCount = 3;  // One larger than largest index.
+
+  /// The native objects referenced by a Dart Paint. Unwrapping them ahead of
+  /// time lets paints be synchronized while typed data is acquired, at which
+  /// point the VM can not be re-entered.
+  struct Objects {
+    Shader* shader = nullptr;
+    ColorFilter* color_filter = nullptr;
+    ImageFilter* image_filter = nullptr;
+  };
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
+  /// Unwraps the kObjectCount object handles of a Dart Paint.
+  static Objects UnwrapObjects(const Dart_Handle* values);
+
+  /// Synchronize paint properties that have already been read from Dart to
+  /// the display list. `data` must point to kDataByteCount bytes laid out as
+  /// in the Dart Paint.
+  static void SyncTo(DisplayListBuilder* builder,
+                     const DisplayListAttributeFlags& flags,
+                     const Objects& objects,
+                     const void* data);
+
   const SkPaint* paint(SkPaint& paint) const;
 
   void toDlPaint(DlPaint& paint) const;
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/progressive_codec.h"
+
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace flutter {
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, ProgressiveCodec);
+
+void ProgressiveCodec::Create(Dart_Handle wrapper) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto codec = fml::MakeRefCounted<ProgressiveCodec>();
+  codec->AssociateWithDartWrapper(wrapper);
+}
+
+ProgressiveCodec::ProgressiveCodec() : weak_factory_(this) {
+  auto dart_state = UIDartState::Current();
+  image_decoder_ = dart_state->GetImageDecoder();
+  decoder_ = ProgressiveImageDecoder::Make(
+      dart_state->GetConcurrentTaskRunner(),
+      dart_state->GetTaskRunners().GetUITaskRunner(),
+      [weak = weak_factory_.GetWeakPtr()](sk_sp<SkImage> image,
+                                          bool is_final) {
+        if (weak) {
+          weak->OnFrameDecoded(std::move(image), is_final);
+        }
+      });
+}
+
+ProgressiveCodec::~ProgressiveCodec() {
+  decoder_->Cancel();
+}
+
+int ProgressiveCodec::frameCount() const {
+  return 1;
+}
+
+int ProgressiveCodec::repetitionCount() const {
+  return 0;
+}
+
+void ProgressiveCodec::addChunk(Dart_Handle chunk_handle) {
+  tonic::Uint8List chunk(chunk_handle);
+  auto data = SkData::MakeWithCopy(chunk.data(), chunk.num_elements());
+  chunk.Release();
+  decoder_->AddChunk(data);
+}
+
+void ProgressiveCodec::finish() {
+  decoder_->Finish();
+}
+
+bool ProgressiveCodec::isComplete() const {
+  return final_frame_returned_;
+}
+
+Dart_Handle ProgressiveCodec::getNextFrame(Dart_Handle callback_handle) {
+  if (!Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+
+  if (!image_decoder_) {
+    return tonic::ToDart(
+        "Failed to access the internal image decoder "
+        "registry on this isolate. Please file a bug on "
+        "https://github.com/flutter/flutter/issues.");
+  }
+
+  if (final_frame_received_ || (frame_ && !frame_returned_)) {
+    ReturnFrame(callback_handle);
+    return Dart_Null();
+  }
+
+  // Wait for the next frame.
+  pending_callbacks_.emplace_back(UIDartState::Current(), callback_handle);
+  return Dart_Null();
+}
+
+void ProgressiveCodec::ReturnFrame(Dart_Handle callback_handle) {
+  frame_returned_ = true;
+  final_frame_returned_ = final_frame_received_;
+  fml::RefPtr<CanvasImage> canvas_image;
+  if (frame_) {
+    canvas_image = CanvasImage::Create();
+    canvas_image->set_image(frame_);
+  }
+  tonic::DartInvoke(callback_handle,
+                    {tonic::ToDart(canvas_image), tonic::ToDart(0)});
+}
+
+void ProgressiveCodec::OnFrameDecoded(sk_sp<SkImage> image, bool is_final) {
+  const size_t frame_number = ++frames_decoded_;
+  if (!image || !image_decoder_) {
+    OnFrameUploaded(frame_number, nullptr, is_final);
+    return;
+  }
+  image_decoder_->Upload(
+      std::move(image), [weak = weak_factory_.GetWeakPtr(), frame_number,
+                         is_final](sk_sp<DlImage> uploaded) {
+        if (weak) {
+          weak->OnFrameUploaded(frame_number, std::move(uploaded), is_final);
+        }
+      });
+}
+
+void ProgressiveCodec::OnFrameUploaded(size_t frame_number,
+                                       sk_sp<DlImage> image,
+                                       bool is_final) {
+  if (frame_number < newest_frame_received_ || final_frame_received_) {
+    return;
+  }
+  if (!image && !is_final) {
+    // A partial frame that could not be uploaded is not worth failing for.
+    return;
+  }
+  newest_frame_received_ = frame_number;
+  frame_ = std::move(image);
+  frame_returned_ = false;
+  final_frame_received_ = is_final;
+
+  if (pending_callbacks_.empty()) {
+    return;
+  }
+  auto state = pending_callbacks_.front().dart_state().lock();
+  if (!state) {
+    // The isolate has been terminated before the frame was decoded.
+    return;
+  }
+  tonic::DartState::Scope scope(state.get());
+  for (const DartPersistentValue& callback : pending_callbacks_) {
+    ReturnFrame(callback.value());
+  }
+  pending_callbacks_.clear();
+}
+
+}  // namespace flutter
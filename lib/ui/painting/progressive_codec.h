@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_CODEC_H_
+#define FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_CODEC_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/lib/ui/painting/codec.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/progressive_image_decoder.h"
+
+using tonic::DartPersistentValue;
+
+namespace flutter {
+
+// A codec for encoded data that arrives in chunks. Frames of the partially
+// decoded image are uploaded as they are decoded, and |getNextFrame| returns
+// the newest frame that it has not returned yet, waiting for one if
+// necessary. Once the fully decoded frame has been returned, it is returned
+// again by every later call.
+class ProgressiveCodec : public Codec {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(ProgressiveCodec);
+
+ public:
+  ~ProgressiveCodec() override;
+
+  static void Create(Dart_Handle wrapper);
+
+  // |Codec|
+  int frameCount() const override;
+
+  // |Codec|
+  int repetitionCount() const override;
+
+  // |Codec|
+  Dart_Handle getNextFrame(Dart_Handle callback_handle) override;
+
+  void addChunk(Dart_Handle chunk_handle);
+
+  void finish();
+
+  // Whether the last frame returned by |getNextFrame| is the fully decoded
+  // image.
+  bool isComplete() const;
+
+ private:
+  fml::WeakPtr<ImageDecoder> image_decoder_;
+  std::shared_ptr<ProgressiveImageDecoder> decoder_;
+  std::vector<DartPersistentValue> pending_callbacks_;
+  // The newest uploaded frame, and whether it was returned already.
+  sk_sp<DlImage> frame_;
+  bool frame_returned_ = false;
+  bool final_frame_received_ = false;
+  bool final_frame_returned_ = false;
+  // Uploads may complete out of order. Frames older than the newest one
+  // received are dropped.
+  size_t frames_decoded_ = 0;
+  size_t newest_frame_received_ = 0;
+  fml::WeakPtrFactory<ProgressiveCodec> weak_factory_;
+
+  ProgressiveCodec();
+
+  void OnFrameDecoded(sk_sp<SkImage> image, bool is_final);
+
+  void OnFrameUploaded(size_t frame_number,
+                       sk_sp<DlImage> image,
+                       bool is_final);
+
+  void ReturnFrame(Dart_Handle callback_handle);
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(ProgressiveCodec);
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgressiveCodec);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_CODEC_H_
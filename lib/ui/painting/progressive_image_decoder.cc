@@ -0,0 +1,300 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/progressive_image_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+
+// Codecs need at least this many bytes to recognize the image format and
+// parse the header. Attempts with less data are guaranteed to fail.
+static constexpr size_t kMinimumHeaderBytes = 32;
+
+// A stream over the bytes received so far. Reads past the available data are
+// short, which codecs report as incomplete input. Later reads observe chunks
+// that arrived in the meantime, allowing an incremental decode to resume.
+class ProgressiveImageDecoder::ChunkedStream final : public SkStream {
+ public:
+  explicit ChunkedStream(std::shared_ptr<EncodedData> data)
+      : data_(std::move(data)) {}
+
+  ~ChunkedStream() override = default;
+
+  // |SkStream|
+  size_t read(void* buffer, size_t size) override {
+    std::scoped_lock lock(data_->mutex);
+    const size_t available = data_->bytes.size() - position_;
+    size = std::min(size, available);
+    if (buffer != nullptr && size > 0) {
+      ::memcpy(buffer, data_->bytes.data() + position_, size);
+    }
+    position_ += size;
+    return size;
+  }
+
+  // |SkStream|
+  size_t peek(void* buffer, size_t size) const override {
+    std::scoped_lock lock(data_->mutex);
+    const size_t available = data_->bytes.size() - position_;
+    size = std::min(size, available);
+    if (size > 0) {
+      ::memcpy(buffer, data_->bytes.data() + position_, size);
+    }
+    return size;
+  }
+
+  // |SkStream|
+  bool isAtEnd() const override {
+    std::scoped_lock lock(data_->mutex);
+    return data_->finished && position_ >= data_->bytes.size();
+  }
+
+  // |SkStream|
+  bool rewind() override {
+    position_ = 0;
+    return true;
+  }
+
+  // |SkStream|
+  bool hasPosition() const override { return true; }
+
+  // |SkStream|
+  size_t getPosition() const override { return position_; }
+
+ private:
+  const std::shared_ptr<EncodedData> data_;
+  size_t position_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ChunkedStream);
+};
+
+std::shared_ptr<ProgressiveImageDecoder> ProgressiveImageDecoder::Make(
+    std::shared_ptr<fml::BasicTaskRunner> decode_runner,
+    fml::RefPtr<fml::TaskRunner> callback_runner,
+    FrameCallback callback) {
+  FML_DCHECK(decode_runner);
+  FML_DCHECK(callback_runner);
+  FML_DCHECK(callback);
+  return std::shared_ptr<ProgressiveImageDecoder>(new ProgressiveImageDecoder(
+      std::move(decode_runner), std::move(callback_runner),
+      std::move(callback)));
+}
+
+ProgressiveImageDecoder::ProgressiveImageDecoder(
+    std::shared_ptr<fml::BasicTaskRunner> decode_runner,
+    fml::RefPtr<fml::TaskRunner> callback_runner,
+    FrameCallback callback)
+    : decode_runner_(std::move(decode_runner)),
+      callback_runner_(std::move(callback_runner)),
+      callback_(std::move(callback)),
+      data_(std::make_shared<EncodedData>()) {}
+
+ProgressiveImageDecoder::~ProgressiveImageDecoder() = default;
+
+void ProgressiveImageDecoder::AddChunk(const sk_sp<SkData>& chunk) {
+  if (!chunk || chunk->isEmpty()) {
+    return;
+  }
+  std::scoped_lock lock(data_->mutex);
+  if (data_->finished || cancelled_) {
+    return;
+  }
+  auto bytes = static_cast<const uint8_t*>(chunk->data());
+  data_->bytes.insert(data_->bytes.end(), bytes, bytes + chunk->size());
+  ScheduleDecodeLocked();
+}
+
+void ProgressiveImageDecoder::Finish() {
+  std::scoped_lock lock(data_->mutex);
+  if (data_->finished || cancelled_) {
+    return;
+  }
+  data_->finished = true;
+  ScheduleDecodeLocked();
+}
+
+void ProgressiveImageDecoder::Cancel() {
+  std::scoped_lock lock(data_->mutex);
+  cancelled_ = true;
+}
+
+size_t ProgressiveImageDecoder::GetBytesReceived() const {
+  std::scoped_lock lock(data_->mutex);
+  return data_->bytes.size();
+}
+
+void ProgressiveImageDecoder::ScheduleDecodeLocked() {
+  dirty_ = true;
+  if (decode_pending_) {
+    return;
+  }
+  decode_pending_ = true;
+  decode_runner_->PostTask(
+      [self = shared_from_this()]() { self->DecodeAvailableData(); });
+}
+
+void ProgressiveImageDecoder::DecodeAvailableData() {
+  TRACE_EVENT0("flutter", "ProgressiveImageDecoder::DecodeAvailableData");
+  while (true) {
+    size_t available_bytes = 0;
+    bool finished = false;
+    {
+      std::scoped_lock lock(data_->mutex);
+      if (!dirty_ || cancelled_ || done_) {
+        decode_pending_ = false;
+        return;
+      }
+      dirty_ = false;
+      available_bytes = data_->bytes.size();
+      finished = data_->finished;
+    }
+    DecodeStep(available_bytes, finished);
+  }
+}
+
+bool ProgressiveImageDecoder::PrepareCodec(bool finished) {
+  if (codec_) {
+    return true;
+  }
+
+  SkCodec::Result result = SkCodec::kSuccess;
+  codec_ = SkCodec::MakeFromStream(std::make_unique<ChunkedStream>(data_),
+                                   &result);
+  if (!codec_) {
+    // Not enough of the header has arrived yet. Try again with more data.
+    if (!finished && result == SkCodec::kIncompleteInput) {
+      return false;
+    }
+    FML_DLOG(ERROR) << "Could not create a codec for progressive decoding: "
+                    << SkCodec::ResultToString(result);
+    DeliverFailure();
+    return false;
+  }
+
+  const auto& codec_info = codec_->getInfo();
+  const auto info = codec_info.makeColorType(kN32_SkColorType)
+                        .makeAlphaType(codec_info.isOpaque()
+                                           ? kOpaque_SkAlphaType
+                                           : kPremul_SkAlphaType);
+  if (!bitmap_.tryAllocPixels(info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << info.computeMinByteSize() << "B";
+    DeliverFailure();
+    return false;
+  }
+  // Rows that have not been decoded yet read as transparent.
+  bitmap_.eraseColor(SK_ColorTRANSPARENT);
+
+  result = codec_->startIncrementalDecode(info, bitmap_.getPixels(),
+                                          bitmap_.rowBytes());
+  switch (result) {
+    case SkCodec::kSuccess:
+      incremental_ = true;
+      break;
+    case SkCodec::kUnimplemented:
+      incremental_ = false;
+      break;
+    default:
+      FML_DLOG(ERROR) << "Could not start progressive decode: "
+                      << SkCodec::ResultToString(result);
+      DeliverFailure();
+      return false;
+  }
+  return true;
+}
+
+void ProgressiveImageDecoder::DecodeStep(size_t available_bytes,
+                                         bool finished) {
+  if (!finished && available_bytes < kMinimumHeaderBytes) {
+    return;
+  }
+
+  if (!PrepareCodec(finished)) {
+    return;
+  }
+
+  if (incremental_) {
+    int rows_decoded = 0;
+    const auto result = codec_->incrementalDecode(&rows_decoded);
+    if (result == SkCodec::kSuccess) {
+      DeliverFrame(true);
+      return;
+    }
+    if (result != SkCodec::kIncompleteInput) {
+      FML_DLOG(ERROR) << "Progressive decode failed: "
+                      << SkCodec::ResultToString(result);
+      DeliverFailure();
+      return;
+    }
+    if (finished) {
+      // The data was truncated. Deliver what could be decoded, as a one-shot
+      // decode of the same data would.
+      DeliverFrame(true);
+    } else if (rows_decoded > rows_delivered_) {
+      rows_delivered_ = rows_decoded;
+      DeliverFrame(false);
+    }
+    return;
+  }
+
+  // Whole-image codecs start from scratch on every attempt. Only retry once
+  // the available data has doubled so that the total work stays bounded.
+  if (!finished && available_bytes < bytes_at_last_attempt_ * 2) {
+    return;
+  }
+  bytes_at_last_attempt_ = available_bytes;
+
+  const auto result = codec_->getPixels(bitmap_.info(), bitmap_.getPixels(),
+                                        bitmap_.rowBytes());
+  switch (result) {
+    case SkCodec::kSuccess:
+      DeliverFrame(true);
+      return;
+    case SkCodec::kIncompleteInput:
+    case SkCodec::kErrorInInput:
+      DeliverFrame(finished);
+      return;
+    default:
+      if (finished) {
+        FML_DLOG(ERROR) << "Progressive decode failed: "
+                        << SkCodec::ResultToString(result);
+        DeliverFailure();
+      }
+      return;
+  }
+}
+
+void ProgressiveImageDecoder::DeliverFrame(bool is_final) {
+  TRACE_EVENT0("flutter", "ProgressiveImageDecoder::DeliverFrame");
+  auto image = SkImage::MakeRasterCopy(bitmap_.pixmap());
+  if (!image) {
+    FML_LOG(ERROR) << "Could not snapshot progressively decoded bitmap.";
+    if (!is_final) {
+      return;
+    }
+  }
+  if (is_final) {
+    done_ = true;
+    codec_.reset();
+  }
+  callback_runner_->PostTask(
+      [callback = callback_, image = std::move(image), is_final]() {
+        callback(image, is_final);
+      });
+}
+
+void ProgressiveImageDecoder::DeliverFailure() {
+  done_ = true;
+  codec_.reset();
+  callback_runner_->PostTask(
+      [callback = callback_]() { callback(nullptr, true); });
+}
+
+}  // namespace flutter
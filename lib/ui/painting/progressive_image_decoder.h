@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_IMAGE_DECODER_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+/// @brief  Decodes an encoded image whose bytes arrive in chunks, delivering
+///         partially decoded raster images as more of the data becomes
+///         available.
+///
+///         Chunks may be added from any thread. Decoding is performed on the
+///         supplied decode runner (typically the concurrent worker runner),
+///         with at most one decode pass in flight at a time; chunks that
+///         arrive while a pass is running are coalesced into the next pass.
+///
+///         For codecs that support incremental decoding (such as PNG,
+///         including interlaced PNG), each pass resumes where the previous
+///         one stopped. For codecs that only support whole-image decoding
+///         (such as JPEG, including progressive JPEG), the partial data is
+///         re-decoded each time the number of available bytes has doubled,
+///         bounding the number of passes to a logarithm of the final size.
+///
+///         Every delivered image is an immutable raster copy, so callers may
+///         retain intermediate frames while decoding continues. The final
+///         frame is delivered exactly once with `is_final` set, and is null
+///         if the data could not be decoded.
+///
+///         The images are not uploaded, so that the decoder works the same
+///         with every rendering backend. `ProgressiveCodec` uploads them
+///         through `ImageDecoder::Upload`.
+class ProgressiveImageDecoder
+    : public std::enable_shared_from_this<ProgressiveImageDecoder> {
+ public:
+  using FrameCallback =
+      std::function<void(sk_sp<SkImage> image, bool is_final)>;
+
+  /// @brief      Creates a decoder that is ready to accept chunks.
+  ///
+  /// @param[in]  decode_runner    The runner on which decode passes are
+  ///                              performed. This may be a concurrent runner.
+  /// @param[in]  callback_runner  The runner on which `callback` is invoked.
+  /// @param[in]  callback         Invoked with every decoded frame.
+  ///
+  static std::shared_ptr<ProgressiveImageDecoder> Make(
+      std::shared_ptr<fml::BasicTaskRunner> decode_runner,
+      fml::RefPtr<fml::TaskRunner> callback_runner,
+      FrameCallback callback);
+
+  ~ProgressiveImageDecoder();
+
+  /// @brief  Appends encoded bytes and schedules a decode pass if one is not
+  ///         already pending. Chunks added after `Finish` are ignored.
+  void AddChunk(const sk_sp<SkData>& chunk);
+
+  /// @brief  Signals that no more chunks will be added. The final frame is
+  ///         delivered after the pending decode pass completes.
+  void Finish();
+
+  /// @brief  Stops decoding. No further frames, including the final frame,
+  ///         are delivered after this call returns to the decode runner.
+  void Cancel();
+
+  /// @brief  The number of encoded bytes received so far.
+  size_t GetBytesReceived() const;
+
+ private:
+  // The encoded bytes received so far, shared between the decoder and the
+  // streams handed to the codecs it creates.
+  struct EncodedData {
+    mutable std::mutex mutex;
+    std::vector<uint8_t> bytes;
+    bool finished = false;
+  };
+
+  class ChunkedStream;
+
+  const std::shared_ptr<fml::BasicTaskRunner> decode_runner_;
+  const fml::RefPtr<fml::TaskRunner> callback_runner_;
+  const FrameCallback callback_;
+  const std::shared_ptr<EncodedData> data_;
+
+  // Guarded by |data_->mutex|.
+  bool decode_pending_ = false;
+  bool dirty_ = false;
+  bool cancelled_ = false;
+
+  // Only accessed on the decode runner, one pass at a time.
+  std::unique_ptr<SkCodec> codec_;
+  SkBitmap bitmap_;
+  bool incremental_ = false;
+  bool done_ = false;
+  int rows_delivered_ = 0;
+  size_t bytes_at_last_attempt_ = 0;
+
+  ProgressiveImageDecoder(std::shared_ptr<fml::BasicTaskRunner> decode_runner,
+                          fml::RefPtr<fml::TaskRunner> callback_runner,
+                          FrameCallback callback);
+
+  void ScheduleDecodeLocked();
+
+  void DecodeAvailableData();
+
+  void DecodeStep(size_t available_bytes, bool finished);
+
+  bool PrepareCodec(bool finished);
+
+  void DeliverFrame(bool is_final);
+
+  void DeliverFailure();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgressiveImageDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_PROGRESSIVE_IMAGE_DECODER_H_
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/scanline_downsampler.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+static constexpr int kChannels = 4;
+
+bool ScanlineDownsampler::CanDownsample(SkISize source_size,
+                                        const SkImageInfo& destination) {
+  if (source_size.isEmpty() || destination.isEmpty()) {
+    return false;
+  }
+  if (destination.width() > source_size.width() ||
+      destination.height() > source_size.height()) {
+    return false;
+  }
+  switch (destination.colorType()) {
+    case kRGBA_8888_SkColorType:
+    case kBGRA_8888_SkColorType:
+      break;
+    default:
+      return false;
+  }
+  return destination.alphaType() == kPremul_SkAlphaType ||
+         destination.alphaType() == kOpaque_SkAlphaType;
+}
+
+bool ScanlineDownsampler::Downsample(const SkPixmap& source,
+                                     const SkPixmap& destination) {
+  TRACE_EVENT0("flutter", "ScanlineDownsampler::Downsample");
+  if (source.colorType() != destination.colorType() ||
+      !CanDownsample(source.dimensions(), destination.info())) {
+    return false;
+  }
+  ScanlineDownsampler downsampler(source.dimensions(), destination);
+  for (int y = 0; y < source.height(); y++) {
+    downsampler.AddRow(source.addr(0, y));
+  }
+  return downsampler.IsComplete();
+}
+
+ScanlineDownsampler::ScanlineDownsampler(SkISize source_size,
+                                         const SkPixmap& destination)
+    : source_size_(source_size), destination_(destination) {
+  FML_DCHECK(CanDownsample(source_size_, destination_.info()));
+
+  // Work in units where a source pixel is `dst_width` wide and a destination
+  // pixel is `src_width` wide so that every boundary falls on an integer.
+  const int64_t src_width = source_size_.width();
+  const int64_t dst_width = destination_.width();
+  horizontal_spans_.reserve(dst_width);
+  horizontal_weights_.reserve(src_width + dst_width);
+  for (int64_t x = 0; x < dst_width; x++) {
+    const int64_t dst_left = x * src_width;
+    const int64_t dst_right = dst_left + src_width;
+    const int64_t first = dst_left / dst_width;
+    const int64_t last = (dst_right - 1) / dst_width;
+    horizontal_spans_.push_back({
+        .first_pixel = static_cast<int>(first),
+        .pixel_count = static_cast<int>(last - first + 1),
+        .weights_offset = horizontal_weights_.size(),
+    });
+    for (int64_t i = first; i <= last; i++) {
+      const int64_t overlap = std::min(dst_right, (i + 1) * dst_width) -
+                              std::max(dst_left, i * dst_width);
+      horizontal_weights_.push_back(static_cast<float>(overlap) / src_width);
+    }
+  }
+
+  filtered_row_.resize(dst_width * kChannels);
+  accumulator_.resize(dst_width * kChannels);
+}
+
+ScanlineDownsampler::~ScanlineDownsampler() = default;
+
+void ScanlineDownsampler::AddRow(const void* row) {
+  FML_DCHECK(source_row_ < source_size_.height());
+  if (IsComplete()) {
+    return;
+  }
+
+  FilterRowHorizontally(static_cast<const uint8_t*>(row));
+
+  // Same integer units as the horizontal pass, but for rows.
+  const int64_t src_height = source_size_.height();
+  const int64_t dst_height = destination_.height();
+  const int64_t row_top = source_row_ * dst_height;
+  const int64_t row_bottom = row_top + dst_height;
+  while (destination_row_ < dst_height) {
+    const int64_t dst_top = destination_row_ * src_height;
+    const int64_t dst_bottom = dst_top + src_height;
+    const int64_t overlap =
+        std::min(row_bottom, dst_bottom) - std::max(row_top, dst_top);
+    if (overlap > 0) {
+      AccumulateFilteredRow(static_cast<float>(overlap) / src_height);
+    }
+    if (row_bottom < dst_bottom) {
+      break;
+    }
+    // The destination row is fully covered. The remainder of this source row,
+    // if any, belongs to the next destination row.
+    EmitDestinationRow();
+    if (row_bottom == dst_bottom) {
+      break;
+    }
+  }
+  source_row_++;
+}
+
+bool ScanlineDownsampler::IsComplete() const {
+  return destination_row_ == destination_.height();
+}
+
+void ScanlineDownsampler::FilterRowHorizontally(const uint8_t* row) {
+  float* out = filtered_row_.data();
+  const float* weights = horizontal_weights_.data();
+  for (const auto& span : horizontal_spans_) {
+    const uint8_t* pixel = row + span.first_pixel * kChannels;
+    const float* weight = weights + span.weights_offset;
+    float sum[kChannels] = {};
+    for (int i = 0; i < span.pixel_count; i++) {
+      // Fixed trip count loops over the channels are readily vectorized.
+      for (int c = 0; c < kChannels; c++) {
+        sum[c] += pixel[c] * weight[i];
+      }
+      pixel += kChannels;
+    }
+    for (int c = 0; c < kChannels; c++) {
+      out[c] = sum[c];
+    }
+    out += kChannels;
+  }
+}
+
+void ScanlineDownsampler::AccumulateFilteredRow(float weight) {
+  const size_t count = accumulator_.size();
+  float* accumulator = accumulator_.data();
+  const float* filtered = filtered_row_.data();
+  for (size_t i = 0; i < count; i++) {
+    accumulator[i] += filtered[i] * weight;
+  }
+}
+
+void ScanlineDownsampler::EmitDestinationRow() {
+  auto out =
+      static_cast<uint8_t*>(destination_.writable_addr(0, destination_row_));
+  const size_t count = accumulator_.size();
+  float* accumulator = accumulator_.data();
+  for (size_t i = 0; i < count; i++) {
+    const float value = std::clamp(accumulator[i] + 0.5f, 0.0f, 255.0f);
+    out[i] = static_cast<uint8_t>(value);
+    accumulator[i] = 0.0f;
+  }
+  destination_row_++;
+}
+
+}  // namespace flutter
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_SCANLINE_DOWNSAMPLER_H_
+#define FLUTTER_LIB_UI_PAINTING_SCANLINE_DOWNSAMPLER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+/// @brief  Downsamples 32-bit pixels into a destination pixmap using an
+///         area-averaging (box) filter, consuming source rows one at a time
+///         in top-down order.
+///
+///         Only a single row of intermediate state is kept, so a decoder can
+///         feed scanlines straight into a target sized bitmap without ever
+///         materializing the full size image. The filter weighs every source
+///         pixel by the exact fraction of the destination pixel it covers,
+///         which avoids the aliasing of point or bilinear sampling at large
+///         reduction factors.
+///
+///         The filter averages each of the four 8-bit channels independently
+///         and so is agnostic to channel order. Averaging is only correct for
+///         premultiplied or opaque pixels.
+class ScanlineDownsampler {
+ public:
+  /// @brief      Whether pixels of the given size can be downsampled into
+  ///             `destination` by this class.
+  static bool CanDownsample(SkISize source_size,
+                            const SkImageInfo& destination);
+
+  /// @brief      Downsamples the entirety of `source` into `destination`.
+  ///             Both pixmaps must be of the same 32-bit color type.
+  ///
+  /// @return     If the pixels were downsampled.
+  ///
+  static bool Downsample(const SkPixmap& source, const SkPixmap& destination);
+
+  /// @param[in]  source_size  The size of the image whose rows will be added.
+  /// @param[in]  destination  Where the downsampled pixels are written. The
+  ///                          pixels must outlive this object.
+  ///
+  ScanlineDownsampler(SkISize source_size, const SkPixmap& destination);
+
+  ~ScanlineDownsampler();
+
+  /// @brief      Adds the next row of the source image. `row` must point to
+  ///             `source_size.width()` pixels.
+  void AddRow(const void* row);
+
+  /// @brief      Whether every row of the destination has been written.
+  bool IsComplete() const;
+
+ private:
+  // The source pixels that contribute to one destination column, along with
+  // the offset of their weights in |horizontal_weights_|.
+  struct Span {
+    int first_pixel;
+    int pixel_count;
+    size_t weights_offset;
+  };
+
+  const SkISize source_size_;
+  const SkPixmap destination_;
+  std::vector<Span> horizontal_spans_;
+  std::vector<float> horizontal_weights_;
+  // The current source row, filtered horizontally to the destination width.
+  std::vector<float> filtered_row_;
+  // The weighted sum of filtered rows contributing to |destination_row_|.
+  std::vector<float> accumulator_;
+  int source_row_ = 0;
+  int destination_row_ = 0;
+
+  void FilterRowHorizontally(const uint8_t* row);
+
+  void AccumulateFilteredRow(float weight);
+
+  void EmitDestinationRow();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScanlineDownsampler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_SCANLINE_DOWNSAMPLER_H_
@@ -6,6 +6,7 @@
 
 #include <mutex>
 
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
@@ -42,9 +43,15 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
+  fml::StartupProfiler::ScopedSpan startup_span(
+      "FontCollection::SetupDefaultFontManager");
   collection_->SetupDefaultFontManager(font_initialization_data);
 }
 
+void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  collection_->SetDefaultFontManager(std::move(font_manager));
+}
+
 // Font manifest yaml format:
 //
 // flutter:
@@ -63,6 +70,8 @@ void FontCollection::SetupDefaultFontManager(
 // Structure described in https://docs.flutter.dev/cookbook/design/fonts
 void FontCollection::RegisterFonts(
     const std::shared_ptr<AssetManager>& asset_manager) {
+  fml::StartupProfiler::ScopedSpan startup_span(
+      "FontCollection::RegisterFonts");
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
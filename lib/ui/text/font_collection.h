@@ -26,6 +26,8 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
+  void SetDefaultFontManager(sk_sp<SkFontMgr> font_manager);
+
   void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager);
 
   void RegisterTestFonts();
@@ -117,6 +117,7 @@ abstract class Canvas {
     Rect? cullRect,
     Paint paint,
   );
+  void drawCommands(CanvasCommandBuffer commands);
   void drawShadow(
     Path path,
     Color color,
@@ -125,6 +126,26 @@ abstract class Canvas {
   );
 }
 
+abstract class CanvasCommandBuffer {
+  factory CanvasCommandBuffer() => engine.EngineCanvasCommandBuffer();
+  bool get isEmpty;
+  void clear();
+  void save();
+  void restore();
+  void translate(double dx, double dy);
+  void scale(double sx, [double? sy]);
+  void rotate(double radians);
+  void clipRect(Rect rect,
+      {ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true});
+  void drawLine(Offset p1, Offset p2, Paint paint);
+  void drawRect(Rect rect, Paint paint);
+  void drawRRect(RRect rrect, Paint paint);
+  void drawOval(Rect rect, Paint paint);
+  void drawCircle(Offset c, double radius, Paint paint);
+  void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter,
+      Paint paint);
+}
+
 typedef PictureEventCallback = void Function(Picture picture);
 
 abstract class Picture {
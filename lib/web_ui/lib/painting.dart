@@ -441,6 +441,7 @@ enum ImageByteFormat {
   rawStraightRgba,
   rawUnmodified,
   png,
+  qoi,
 }
 
 enum PixelFormat {
@@ -469,6 +470,66 @@ class Codec {
   void dispose() {}
 }
 
+// Browsers do not expose partially decoded images, so the chunks are decoded
+// once all of them have been added.
+class ProgressiveCodec extends Codec {
+  ProgressiveCodec() : super._();
+
+  final List<Uint8List> _chunks = <Uint8List>[];
+  final Completer<Codec> _codec = Completer<Codec>();
+  bool _finished = false;
+  bool _isComplete = false;
+  Codec? _decoded;
+
+  @override
+  int get frameCount => 1;
+
+  bool get isComplete => _isComplete;
+
+  void addChunk(Uint8List chunk) {
+    if (!_finished) {
+      _chunks.add(Uint8List.fromList(chunk));
+    }
+  }
+
+  void finish() {
+    if (_finished) {
+      return;
+    }
+    _finished = true;
+    final int length = _chunks.fold<int>(0, (int sum, Uint8List chunk) => sum + chunk.length);
+    final Uint8List data = Uint8List(length);
+    int offset = 0;
+    for (final Uint8List chunk in _chunks) {
+      data.setRange(offset, offset + chunk.length, chunk);
+      offset += chunk.length;
+    }
+    _chunks.clear();
+    _codec.complete(instantiateImageCodec(data));
+  }
+
+  @override
+  Future<FrameInfo> getNextFrame() async {
+    final Codec codec = _decoded ??= await _codec.future;
+    final FrameInfo frame = await codec.getNextFrame();
+    _isComplete = true;
+    return frame;
+  }
+
+  @override
+  void dispose() {
+    _finished = true;
+    _chunks.clear();
+    if (!_codec.isCompleted) {
+      // Frames that are being waited for would otherwise never arrive.
+      _codec.completeError(StateError('The codec was disposed before finish() was called.'));
+      // Nothing may be waiting for a frame, which is not an unhandled error.
+      unawaited(_codec.future.then<void>((_) {}, onError: (Object _) {}));
+    }
+    _decoded?.dispose();
+  }
+}
+
 Future<Codec> instantiateImageCodec(
   Uint8List list, {
   int? targetWidth,
@@ -19,6 +19,7 @@ export 'engine/alarm_clock.dart';
 export 'engine/app_bootstrap.dart';
 export 'engine/assets.dart';
 export 'engine/browser_detection.dart';
+export 'engine/canvas_command_buffer.dart';
 export 'engine/canvas_pool.dart';
 export 'engine/canvaskit/canvas.dart';
 export 'engine/canvaskit/canvaskit_api.dart';
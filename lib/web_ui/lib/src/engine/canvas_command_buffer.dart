@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'package:ui/ui.dart' as ui;
+
+typedef _CanvasCommand = void Function(ui.Canvas canvas);
+
+/// Records canvas commands to replay them later with [ui.Canvas.drawCommands].
+///
+/// On the web canvas calls do not cross an isolate boundary, so there is no
+/// call overhead to amortize. The commands are simply recorded as closures
+/// that are replayed against the target canvas.
+class EngineCanvasCommandBuffer implements ui.CanvasCommandBuffer {
+  final List<_CanvasCommand> _commands = <_CanvasCommand>[];
+
+  // The last recorded paint and the snapshot taken of it, so that runs of
+  // commands using an unchanged paint share one snapshot.
+  ui.Paint? _lastPaint;
+  ui.Paint? _lastSnapshot;
+
+  @override
+  bool get isEmpty => _commands.isEmpty;
+
+  @override
+  void clear() {
+    _commands.clear();
+    _lastPaint = null;
+    _lastSnapshot = null;
+  }
+
+  /// Draws the recorded commands into [canvas].
+  void replay(ui.Canvas canvas) {
+    for (final _CanvasCommand command in _commands) {
+      command(canvas);
+    }
+  }
+
+  // Paints are mutable, so a copy is recorded to match the native engine,
+  // which copies the paint data when a command is recorded.
+  ui.Paint _snapshot(ui.Paint paint) {
+    final ui.Paint? last = _lastSnapshot;
+    if (last != null && identical(paint, _lastPaint) && _isEqual(paint, last)) {
+      return last;
+    }
+    final ui.Paint snapshot = ui.Paint()
+      ..blendMode = paint.blendMode
+      ..style = paint.style
+      ..strokeWidth = paint.strokeWidth
+      ..strokeCap = paint.strokeCap
+      ..strokeJoin = paint.strokeJoin
+      ..isAntiAlias = paint.isAntiAlias
+      ..color = paint.color
+      ..invertColors = paint.invertColors
+      ..shader = paint.shader
+      ..maskFilter = paint.maskFilter
+      ..filterQuality = paint.filterQuality
+      ..colorFilter = paint.colorFilter
+      ..strokeMiterLimit = paint.strokeMiterLimit
+      ..imageFilter = paint.imageFilter;
+    _lastPaint = paint;
+    _lastSnapshot = snapshot;
+    return snapshot;
+  }
+
+  static bool _isEqual(ui.Paint a, ui.Paint b) {
+    return a.blendMode == b.blendMode &&
+        a.style == b.style &&
+        a.strokeWidth == b.strokeWidth &&
+        a.strokeCap == b.strokeCap &&
+        a.strokeJoin == b.strokeJoin &&
+        a.isAntiAlias == b.isAntiAlias &&
+        a.color == b.color &&
+        a.invertColors == b.invertColors &&
+        identical(a.shader, b.shader) &&
+        a.maskFilter == b.maskFilter &&
+        a.filterQuality == b.filterQuality &&
+        a.colorFilter == b.colorFilter &&
+        a.strokeMiterLimit == b.strokeMiterLimit &&
+        a.imageFilter == b.imageFilter;
+  }
+
+  @override
+  void save() {
+    _commands.add((ui.Canvas canvas) => canvas.save());
+  }
+
+  @override
+  void restore() {
+    _commands.add((ui.Canvas canvas) => canvas.restore());
+  }
+
+  @override
+  void translate(double dx, double dy) {
+    _commands.add((ui.Canvas canvas) => canvas.translate(dx, dy));
+  }
+
+  @override
+  void scale(double sx, [double? sy]) {
+    _commands.add((ui.Canvas canvas) => canvas.scale(sx, sy));
+  }
+
+  @override
+  void rotate(double radians) {
+    _commands.add((ui.Canvas canvas) => canvas.rotate(radians));
+  }
+
+  @override
+  void clipRect(ui.Rect rect,
+      {ui.ClipOp clipOp = ui.ClipOp.intersect, bool doAntiAlias = true}) {
+    _commands.add((ui.Canvas canvas) =>
+        canvas.clipRect(rect, clipOp: clipOp, doAntiAlias: doAntiAlias));
+  }
+
+  @override
+  void drawLine(ui.Offset p1, ui.Offset p2, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add((ui.Canvas canvas) => canvas.drawLine(p1, p2, snapshot));
+  }
+
+  @override
+  void drawRect(ui.Rect rect, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add((ui.Canvas canvas) => canvas.drawRect(rect, snapshot));
+  }
+
+  @override
+  void drawRRect(ui.RRect rrect, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add((ui.Canvas canvas) => canvas.drawRRect(rrect, snapshot));
+  }
+
+  @override
+  void drawOval(ui.Rect rect, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add((ui.Canvas canvas) => canvas.drawOval(rect, snapshot));
+  }
+
+  @override
+  void drawCircle(ui.Offset c, double radius, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add(
+        (ui.Canvas canvas) => canvas.drawCircle(c, radius, snapshot));
+  }
+
+  @override
+  void drawArc(ui.Rect rect, double startAngle, double sweepAngle,
+      bool useCenter, ui.Paint paint) {
+    final ui.Paint snapshot = _snapshot(paint);
+    _commands.add((ui.Canvas canvas) => canvas.drawArc(
+        rect, startAngle, sweepAngle, useCenter, snapshot));
+  }
+}
@@ -6,6 +6,7 @@ import 'dart:typed_data';
 
 import 'package:ui/ui.dart' as ui;
 
+import '../canvas_command_buffer.dart';
 import '../util.dart';
 import '../validators.dart';
 import '../vector_math.dart';
@@ -457,6 +458,12 @@ class CanvasKitCanvas implements ui.Canvas {
     );
   }
 
+  @override
+  void drawCommands(ui.CanvasCommandBuffer commands) {
+    assert(commands != null);
+    (commands as EngineCanvasCommandBuffer).replay(this);
+  }
+
   @override
   void drawShadow(ui.Path path, ui.Color color, double elevation,
       bool transparentOccluder) {
@@ -291,6 +291,10 @@ class CkImage implements ui.Image, StackTraceDebugger {
     ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba,
   }) {
     assert(_debugCheckIsNotDisposed());
+    if (format == ui.ImageByteFormat.qoi) {
+      return Future<ByteData>.error(
+          UnsupportedError('QOI encoding is not supported on the web.'));
+    }
     if (videoFrame != null) {
       return readPixelsFromVideoFrame(videoFrame!, format);
     } else {
@@ -7,6 +7,7 @@ import 'dart:typed_data';
 
 import 'package:ui/ui.dart' as ui;
 
+import '../canvas_command_buffer.dart';
 import '../picture.dart';
 import '../util.dart';
 import '../validators.dart';
@@ -533,6 +534,12 @@ class SurfaceCanvas implements ui.Canvas {
     throw UnimplementedError();
   }
 
+  @override
+  void drawCommands(ui.CanvasCommandBuffer commands) {
+    assert(commands != null);
+    (commands as EngineCanvasCommandBuffer).replay(this);
+  }
+
   @override
   void drawShadow(
     ui.Path path,
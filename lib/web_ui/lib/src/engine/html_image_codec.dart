@@ -194,6 +194,10 @@ class HtmlImage implements ui.Image {
         ctx.drawImage(imgElement, 0, 0);
         final DomImageData imageData = ctx.getImageData(0, 0, width, height);
         return Future<ByteData?>.value(imageData.data.buffer.asByteData());
+      case ui.ImageByteFormat.qoi:
+        // Fails the same way as on the CanvasKit renderer.
+        return Future<ByteData?>.error(
+            UnsupportedError('QOI encoding is not supported on the web.'));
       default:
         if (imgElement.src?.startsWith('data:') ?? false) {
           final UriData data = UriData.fromUri(Uri.parse(imgElement.src!));
@@ -175,6 +175,10 @@ void _testForImageCodecs({required bool useBrowserImageDecoder}) {
       final CkImage image = CkImage(skImage);
       expect((await image.toByteData()).lengthInBytes, greaterThan(0));
       expect((await image.toByteData(format: ui.ImageByteFormat.png)).lengthInBytes, greaterThan(0));
+      expect(
+        image.toByteData(format: ui.ImageByteFormat.qoi),
+        throwsA(isA<UnsupportedError>()),
+      );
       testCollector.collectNow();
     });
 
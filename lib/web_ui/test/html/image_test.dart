@@ -104,6 +104,16 @@ Future<void> testMain() async {
     expect(actualPixels, listEqual(benchmarkPixels));
   });
 
+  test('Fails to encode to QOI', () async {
+    final Image sourceImage = await _encodeToHtmlThenDecode(
+      _pixelsToBytes(<int>[0xFF0102FF]), 1, 1,
+    );
+    expect(
+      sourceImage.toByteData(format: ImageByteFormat.qoi),
+      throwsA(isA<UnsupportedError>()),
+    );
+  });
+
   test('Correctly encodes an opaque image in bgra8888', () async {
     // A 2x2 testing image without transparency.
     final Image sourceImage = await _encodeToHtmlThenDecode(
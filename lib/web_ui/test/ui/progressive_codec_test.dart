@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:typed_data';
+
+import 'package:test/bootstrap/browser.dart';
+import 'package:test/test.dart';
+import 'package:ui/ui.dart' as ui;
+
+import 'utils.dart';
+
+void main() {
+  internalBootstrapBrowserTest(() => testMain);
+}
+
+void testMain() {
+  setUpUiTest();
+
+  group('ProgressiveCodec', () {
+    test('fails pending frames when disposed before finish', () async {
+      final ui.ProgressiveCodec codec = ui.ProgressiveCodec();
+      codec.addChunk(Uint8List.fromList(<int>[0x89, 0x50, 0x4E, 0x47]));
+      final Future<ui.FrameInfo> frame = codec.getNextFrame();
+      codec.dispose();
+      await expectLater(frame, throwsA(isA<StateError>()));
+      expect(codec.isComplete, isFalse);
+    });
+
+    test('can be disposed while no frame is pending', () {
+      final ui.ProgressiveCodec codec = ui.ProgressiveCodec();
+      codec.addChunk(Uint8List.fromList(<int>[0x89, 0x50, 0x4E, 0x47]));
+      codec.dispose();
+      // Ignored, as the codec is disposed.
+      codec.finish();
+    });
+
+    test('fails frames when the data can not be decoded', () async {
+      final ui.ProgressiveCodec codec = ui.ProgressiveCodec();
+      codec.addChunk(Uint8List.fromList(<int>[1, 2, 3, 4]));
+      codec.finish();
+      await expectLater(codec.getNextFrame(), throwsA(anything));
+      expect(codec.isComplete, isFalse);
+      codec.dispose();
+    });
+  });
+}
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/logging.h"
 #include "flutter/lib/snapshot/snapshot.h"
@@ -182,6 +183,8 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateInstructions(
 fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::VMSnapshotFromSettings");
+  fml::StartupProfiler::ScopedSpan startup_span(
+      "DartSnapshot::VMSnapshotFromSettings");
   auto snapshot =
       fml::MakeRefCounted<DartSnapshot>(ResolveVMData(settings),         //
                                         ResolveVMInstructions(settings)  //
@@ -195,6 +198,8 @@ fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
 fml::RefPtr<const DartSnapshot> DartSnapshot::IsolateSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::IsolateSnapshotFromSettings");
+  fml::StartupProfiler::ScopedSpan startup_span(
+      "DartSnapshot::IsolateSnapshotFromSettings");
   auto snapshot =
       fml::MakeRefCounted<DartSnapshot>(ResolveIsolateData(settings),         //
                                         ResolveIsolateInstructions(settings)  //
@@ -257,6 +262,14 @@ const uint8_t* DartSnapshot::GetInstructionsMapping() const {
   return instructions_ ? instructions_->GetMapping() : nullptr;
 }
 
+size_t DartSnapshot::GetDataSize() const {
+  return data_ ? data_->GetSize() : 0u;
+}
+
+size_t DartSnapshot::GetInstructionsSize() const {
+  return instructions_ ? instructions_->GetSize() : 0u;
+}
+
 bool DartSnapshot::IsDontNeedSafe() const {
   if (data_ && !data_->IsDontNeedSafe()) {
     return false;
@@ -160,6 +160,16 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///
   const uint8_t* GetInstructionsMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the sizes of the heap and instructions snapshots.
+  ///
+  /// @return     The sizes, which are zero for absent snapshots and for
+  ///             snapshots resolved from symbols, whose sizes are unknown.
+  ///
+  size_t GetDataSize() const;
+
+  size_t GetInstructionsSize() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns whether both the data and instructions mappings are
   ///             safe to use with madvise(DONTNEED).
@@ -0,0 +1,275 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/dart_snapshot_prefetcher.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+static constexpr char kProfileHeader[] = "flutter-snapshot-page-profile 1";
+
+namespace {
+
+using PageRanges = std::vector<std::pair<size_t, size_t>>;
+
+struct RegionProfile {
+  size_t size = 0;
+  PageRanges pages;
+};
+
+}  // namespace
+
+static void AddRegion(std::vector<DartSnapshotPrefetcher::Region>& regions,
+                      const char* name,
+                      const uint8_t* start,
+                      size_t size,
+                      bool is_instructions) {
+  if (start == nullptr) {
+    return;
+  }
+  // Snapshots resolved from symbols in the executable or a shared library do
+  // not know their sizes. Bound them by the segment they were loaded into.
+  if (size == 0) {
+    size = fml::GetLoadedSegmentSizeFrom(start);
+  }
+  if (size == 0) {
+    return;
+  }
+  regions.push_back({
+      .name = name,
+      .start = start,
+      .size = size,
+      .is_instructions = is_instructions,
+  });
+}
+
+static std::vector<DartSnapshotPrefetcher::Region> GetSnapshotRegions(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot) {
+  std::vector<DartSnapshotPrefetcher::Region> regions;
+  AddRegion(regions, "vm_data", vm_snapshot.GetDataMapping(),
+            vm_snapshot.GetDataSize(), false);
+  AddRegion(regions, "vm_instructions", vm_snapshot.GetInstructionsMapping(),
+            vm_snapshot.GetInstructionsSize(), true);
+  AddRegion(regions, "isolate_data", isolate_snapshot.GetDataMapping(),
+            isolate_snapshot.GetDataSize(), false);
+  AddRegion(regions, "isolate_instructions",
+            isolate_snapshot.GetInstructionsMapping(),
+            isolate_snapshot.GetInstructionsSize(), true);
+  return regions;
+}
+
+static size_t GetPageCount(size_t size, size_t page_size) {
+  return (size + page_size - 1) / page_size;
+}
+
+static bool ParsePageRanges(const std::string& token, PageRanges& ranges) {
+  if (token == "-") {
+    return true;
+  }
+  std::istringstream stream(token);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    size_t first = 0;
+    size_t last = 0;
+    char separator = 0;
+    std::istringstream range_stream(range);
+    if (!(range_stream >> first)) {
+      return false;
+    }
+    if (range_stream >> separator) {
+      if (separator != '-' || !(range_stream >> last) || last < first) {
+        return false;
+      }
+    } else {
+      last = first;
+    }
+    ranges.emplace_back(first, last);
+  }
+  return true;
+}
+
+static bool ParseProfile(std::string_view profile,
+                         std::map<std::string, RegionProfile>& regions) {
+  std::istringstream stream{std::string(profile)};
+  std::string line;
+  if (!std::getline(stream, line) || line != kProfileHeader) {
+    return false;
+  }
+  std::string key;
+  size_t page_size = 0;
+  if (!(stream >> key >> page_size) || key != "page-size" ||
+      page_size != fml::GetMappingPageSize()) {
+    return false;
+  }
+  while (stream >> key) {
+    std::string name;
+    std::string ranges;
+    RegionProfile region;
+    if (key != "region" || !(stream >> name >> region.size >> ranges) ||
+        !ParsePageRanges(ranges, region.pages)) {
+      return false;
+    }
+    regions[name] = std::move(region);
+  }
+  return true;
+}
+
+static void WritePageRanges(std::ostringstream& stream,
+                            const std::vector<bool>& pages) {
+  bool wrote_range = false;
+  for (size_t first = 0; first < pages.size(); first++) {
+    if (!pages[first]) {
+      continue;
+    }
+    size_t last = first;
+    while (last + 1 < pages.size() && pages[last + 1]) {
+      last++;
+    }
+    if (wrote_range) {
+      stream << ',';
+    }
+    stream << first;
+    if (last != first) {
+      stream << '-' << last;
+    }
+    wrote_range = true;
+    first = last;
+  }
+  if (!wrote_range) {
+    stream << '-';
+  }
+}
+
+DartSnapshotPrefetcher::DartSnapshotPrefetcher(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot)
+    : DartSnapshotPrefetcher(
+          GetSnapshotRegions(vm_snapshot, isolate_snapshot)) {}
+
+// Widens the regions to page boundaries, so that page indices in profiles
+// match the residency reported for the pages of each region.
+static std::vector<DartSnapshotPrefetcher::Region> AlignToPages(
+    std::vector<DartSnapshotPrefetcher::Region> regions) {
+  const auto page_size = fml::GetMappingPageSize();
+  for (auto& region : regions) {
+    const auto start = reinterpret_cast<uintptr_t>(region.start);
+    const auto aligned_start = start - start % page_size;
+    const auto end = start + region.size;
+    const auto aligned_end = GetPageCount(end, page_size) * page_size;
+    region.start = reinterpret_cast<const uint8_t*>(aligned_start);
+    region.size = aligned_end - aligned_start;
+  }
+  return regions;
+}
+
+// Snapshots resolved from symbols are bounded by the segment they were loaded
+// into, which can contain the snapshot of the isolate after that of the VM.
+// Such a region ends where the next snapshot in its segment starts, so that
+// no page is recorded or prefetched for two regions.
+static std::vector<DartSnapshotPrefetcher::Region> ClampOverlappingRegions(
+    std::vector<DartSnapshotPrefetcher::Region> regions) {
+  for (auto& region : regions) {
+    for (const auto& other : regions) {
+      if (other.start > region.start &&
+          other.start < region.start + region.size) {
+        region.size = other.start - region.start;
+      }
+    }
+  }
+  return regions;
+}
+
+DartSnapshotPrefetcher::DartSnapshotPrefetcher(std::vector<Region> regions)
+    : regions_(AlignToPages(ClampOverlappingRegions(std::move(regions)))) {}
+
+DartSnapshotPrefetcher::~DartSnapshotPrefetcher() = default;
+
+const std::vector<DartSnapshotPrefetcher::Region>&
+DartSnapshotPrefetcher::GetRegions() const {
+  return regions_;
+}
+
+size_t DartSnapshotPrefetcher::PrefetchAll() const {
+  TRACE_EVENT0("flutter", "DartSnapshotPrefetcher::PrefetchAll");
+  const auto page_size = fml::GetMappingPageSize();
+  size_t prefetched = 0;
+  for (const auto& region : regions_) {
+    if (fml::PrefetchMappingRange(region.start, region.size)) {
+      prefetched += region.size / page_size;
+    }
+  }
+  return prefetched;
+}
+
+size_t DartSnapshotPrefetcher::PrefetchProfile(std::string_view profile) const {
+  TRACE_EVENT0("flutter", "DartSnapshotPrefetcher::PrefetchProfile");
+  std::map<std::string, RegionProfile> profiles;
+  if (!ParseProfile(profile, profiles)) {
+    FML_LOG(WARNING) << "Could not parse the snapshot page profile. All "
+                        "snapshot pages will be prefetched.";
+    return PrefetchAll();
+  }
+  const auto page_size = fml::GetMappingPageSize();
+  size_t prefetched = 0;
+  for (const auto& region : regions_) {
+    auto found = profiles.find(region.name);
+    if (found == profiles.end() || found->second.size != region.size) {
+      if (fml::PrefetchMappingRange(region.start, region.size)) {
+        prefetched += region.size / page_size;
+      }
+      continue;
+    }
+    const auto page_count = region.size / page_size;
+    for (const auto& [first, last] : found->second.pages) {
+      if (first >= page_count) {
+        continue;
+      }
+      const auto end = std::min(last + 1, page_count);
+      if (fml::PrefetchMappingRange(region.start + first * page_size,
+                                    (end - first) * page_size)) {
+        prefetched += end - first;
+      }
+    }
+  }
+  return prefetched;
+}
+
+std::string DartSnapshotPrefetcher::CaptureProfile() const {
+  TRACE_EVENT0("flutter", "DartSnapshotPrefetcher::CaptureProfile");
+  std::ostringstream stream;
+  stream << kProfileHeader << '\n'
+         << "page-size " << fml::GetMappingPageSize() << '\n';
+  for (const auto& region : regions_) {
+    auto pages = fml::GetResidentPages(region.start, region.size);
+    if (pages.empty()) {
+      return {};
+    }
+    stream << "region " << region.name << ' ' << region.size << ' ';
+    WritePageRanges(stream, pages);
+    stream << '\n';
+  }
+  return stream.str();
+}
+
+size_t DartSnapshotPrefetcher::AdviseHugePagesForInstructions() const {
+  size_t advised = 0;
+  for (const auto& region : regions_) {
+    if (region.is_instructions &&
+        fml::AdviseHugePages(region.start, region.size)) {
+      advised++;
+    }
+  }
+  return advised;
+}
+
+}  // namespace flutter
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_DART_SNAPSHOT_PREFETCHER_H_
+#define FLUTTER_RUNTIME_DART_SNAPSHOT_PREFETCHER_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the pages of the VM and isolate snapshots into memory
+///             ahead of their first access.
+///
+///             Snapshots are mapped from files and demand paged, so without a
+///             prefetch the first frames fault the pages they touch in one at
+///             a time. Prefetching every page reads more than startup needs,
+///             so the prefetcher can instead be driven by a page profile
+///             captured once a previous run drew its first frame.
+///
+///             Profiles are plain text. Each region of the snapshots is
+///             recorded along with its size and the ranges of its resident
+///             pages:
+///
+///             ```
+///             flutter-snapshot-page-profile 1
+///             page-size 4096
+///             region isolate_instructions 1052672 0-3,17,40-52
+///             ```
+///
+///             Regions whose size changed since the profile was captured,
+///             such as after an application update, are prefetched whole.
+///
+///             All methods may be called on any thread, but the snapshots must
+///             outlive the prefetcher.
+///
+class DartSnapshotPrefetcher {
+ public:
+  /// A range of a snapshot. Regions are widened to page boundaries. A region
+  /// that extends past the start of another one is first clamped at that
+  /// start.
+  struct Region {
+    /// The name the region is recorded by. It must have static storage
+    /// duration.
+    const char* name = nullptr;
+    const uint8_t* start = nullptr;
+    size_t size = 0;
+    bool is_instructions = false;
+  };
+
+  DartSnapshotPrefetcher(const DartSnapshot& vm_snapshot,
+                         const DartSnapshot& isolate_snapshot);
+
+  explicit DartSnapshotPrefetcher(std::vector<Region> regions);
+
+  ~DartSnapshotPrefetcher();
+
+  const std::vector<Region>& GetRegions() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prefetches all pages of all regions.
+  ///
+  /// @return     The number of pages that were prefetched.
+  ///
+  size_t PrefetchAll() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prefetches the pages a profile recorded as resident. If the
+  ///             profile can not be parsed, all pages are prefetched.
+  ///
+  /// @return     The number of pages that were prefetched.
+  ///
+  size_t PrefetchProfile(std::string_view profile) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a profile of the pages of each region that are
+  ///             currently resident.
+  ///
+  ///             Residency is that of the page cache, not of this process. A
+  ///             page read by an earlier run that is still cached is recorded
+  ///             too, so profiles should be captured on the first launch
+  ///             after installation or an update, when the cache is cold.
+  ///
+  /// @return     The profile, or an empty string if residency can not be
+  ///             queried on this platform.
+  ///
+  std::string CaptureProfile() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to back the instructions regions with
+  ///             transparent huge pages.
+  ///
+  /// @see        fml::AdviseHugePages
+  ///
+  /// @return     The number of regions the OS accepted the advice for.
+  ///
+  size_t AdviseHugePagesForInstructions() const;
+
+ private:
+  const std::vector<Region> regions_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DartSnapshotPrefetcher);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_DART_SNAPSHOT_PREFETCHER_H_
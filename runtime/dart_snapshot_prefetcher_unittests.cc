@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/dart_snapshot_prefetcher.h"
+
+#include <sstream>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+#if !defined(FML_OS_WIN)
+#include <sys/mman.h>
+#endif  // !defined(FML_OS_WIN)
+
+namespace flutter {
+namespace testing {
+
+static std::string CreateProfile(size_t region_size, const char* pages) {
+  std::ostringstream profile;
+  profile << "flutter-snapshot-page-profile 1\n"
+          << "page-size " << fml::GetMappingPageSize() << '\n'
+          << "region data " << region_size << ' ' << pages << '\n';
+  return profile.str();
+}
+
+TEST(DartSnapshotPrefetcherTest, RegionsAreWidenedToPages) {
+  const size_t page_size = fml::GetMappingPageSize();
+  std::vector<uint8_t> buffer(page_size * 4);
+  const auto* page = reinterpret_cast<const uint8_t*>(
+      (reinterpret_cast<uintptr_t>(buffer.data()) + page_size - 1) &
+      ~(page_size - 1));
+  DartSnapshotPrefetcher prefetcher({{.name = "data",
+                                      .start = page + 1,
+                                      .size = page_size}});
+  ASSERT_EQ(prefetcher.GetRegions().size(), 1u);
+  ASSERT_EQ(prefetcher.GetRegions()[0].start, page);
+  ASSERT_EQ(prefetcher.GetRegions()[0].size, page_size * 2);
+}
+
+TEST(DartSnapshotPrefetcherTest, RegionsEndWhereTheNextRegionStarts) {
+  const size_t page_size = fml::GetMappingPageSize();
+  std::vector<uint8_t> buffer(page_size * 5);
+  const auto* page = reinterpret_cast<const uint8_t*>(
+      (reinterpret_cast<uintptr_t>(buffer.data()) + page_size - 1) &
+      ~(page_size - 1));
+  // Like snapshots resolved from symbols, the first region is bounded by the
+  // end of the segment both are in.
+  DartSnapshotPrefetcher prefetcher(
+      {{.name = "vm_instructions", .start = page, .size = page_size * 4},
+       {.name = "isolate_instructions",
+        .start = page + page_size * 2,
+        .size = page_size * 2}});
+  ASSERT_EQ(prefetcher.GetRegions().size(), 2u);
+  ASSERT_EQ(prefetcher.GetRegions()[0].start, page);
+  ASSERT_EQ(prefetcher.GetRegions()[0].size, page_size * 2);
+  ASSERT_EQ(prefetcher.GetRegions()[1].start, page + page_size * 2);
+  ASSERT_EQ(prefetcher.GetRegions()[1].size, page_size * 2);
+}
+
+// Fuchsia's residency and prefetch stubs report nothing.
+#if !defined(FML_OS_WIN) && !defined(OS_FUCHSIA)
+
+class DartSnapshotPrefetcherPagesTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kPageCount = 4;
+
+  void SetUp() override {
+    size_ = fml::GetMappingPageSize() * kPageCount;
+    auto* mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    start_ = static_cast<uint8_t*>(mapping);
+  }
+
+  void TearDown() override {
+    if (start_ != nullptr) {
+      ::munmap(start_, size_);
+    }
+  }
+
+  DartSnapshotPrefetcher CreatePrefetcher() const {
+    return DartSnapshotPrefetcher({{.name = "data",
+                                    .start = start_,
+                                    .size = size_,
+                                    .is_instructions = false}});
+  }
+
+  uint8_t* start_ = nullptr;
+  size_t size_ = 0;
+};
+
+TEST_F(DartSnapshotPrefetcherPagesTest, CapturesResidentPageRanges) {
+  const size_t page_size = fml::GetMappingPageSize();
+  // Anonymous pages only become resident once they are written to.
+  start_[0] = 1;
+  start_[page_size * 2] = 1;
+  start_[page_size * 3] = 1;
+  ASSERT_EQ(CreatePrefetcher().CaptureProfile(),
+            CreateProfile(size_, "0,2-3"));
+}
+
+TEST_F(DartSnapshotPrefetcherPagesTest, PrefetchesRecordedPages) {
+  auto prefetcher = CreatePrefetcher();
+  ASSERT_EQ(prefetcher.PrefetchProfile(CreateProfile(size_, "1-2")), 2u);
+  ASSERT_EQ(prefetcher.PrefetchProfile(CreateProfile(size_, "-")), 0u);
+  // Pages beyond the end of the region are ignored.
+  ASSERT_EQ(prefetcher.PrefetchProfile(CreateProfile(size_, "0,3-9")), 2u);
+}
+
+TEST_F(DartSnapshotPrefetcherPagesTest, PrefetchesAllPagesOfChangedRegions) {
+  auto prefetcher = CreatePrefetcher();
+  ASSERT_EQ(prefetcher.PrefetchProfile(CreateProfile(size_ * 2, "1")),
+            kPageCount);
+  ASSERT_EQ(prefetcher.PrefetchProfile("not a profile"), kPageCount);
+  ASSERT_EQ(prefetcher.PrefetchProfile(CreateProfile(size_, "3-1")),
+            kPageCount);
+  ASSERT_EQ(prefetcher.PrefetchAll(), kPageCount);
+}
+
+#endif  // !defined(FML_OS_WIN) && !defined(OS_FUCHSIA)
+
+}  // namespace testing
+}  // namespace flutter
@@ -11,13 +11,17 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/fml/compiler_specific.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/size.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/dart_ui.h"
 #include "flutter/runtime/dart_isolate.h"
+#include "flutter/runtime/dart_snapshot_prefetcher.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
@@ -259,6 +263,7 @@ std::shared_ptr<DartVM> DartVM::Create(
     fml::RefPtr<const DartSnapshot> vm_snapshot,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
     std::shared_ptr<IsolateNameServer> isolate_name_server) {
+  fml::StartupProfiler::ScopedSpan startup_span("DartVM::Create");
   auto vm_data = DartVMData::Create(settings,                    //
                                     std::move(vm_snapshot),      //
                                     std::move(isolate_snapshot)  //
@@ -302,6 +307,8 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  PrefetchSnapshots();
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
@@ -517,6 +524,74 @@ DartVM::~DartVM() {
   dart::bin::CleanupDartIo();
 }
 
+void DartVM::PrefetchSnapshots() {
+  const auto& vm_snapshot = vm_data_->GetVMSnapshot();
+  const auto isolate_snapshot = vm_data_->GetIsolateSnapshot();
+  if (settings_.aot_instructions_huge_pages && IsRunningPrecompiledCode()) {
+    DartSnapshotPrefetcher prefetcher(vm_snapshot, *isolate_snapshot);
+    if (prefetcher.AdviseHugePagesForInstructions() == 0) {
+      FML_DLOG(WARNING) << "Could not back the AOT instructions with huge "
+                           "pages.";
+    }
+  }
+
+  if (!settings_.prefetch_dart_snapshot) {
+    return;
+  }
+  const auto& profile_path = settings_.snapshot_page_profile_path;
+  needs_snapshot_page_profile_ =
+      !profile_path.empty() && !fml::IsFile(profile_path);
+  // A launch that records the profile must not prefetch, as that would
+  // record the prefetched pages too.
+  if (needs_snapshot_page_profile_) {
+    return;
+  }
+  // The task holds on to the VM data, which owns the mappings of the
+  // snapshots.
+  concurrent_message_loop_->GetTaskRunner()->PostTask(
+      [vm_data = vm_data_, profile_path]() {
+        DartSnapshotPrefetcher prefetcher(vm_data->GetVMSnapshot(),
+                                          *vm_data->GetIsolateSnapshot());
+        auto profile = profile_path.empty()
+                           ? nullptr
+                           : fml::FileMapping::CreateReadOnly(profile_path);
+        if (profile) {
+          prefetcher.PrefetchProfile(
+              {reinterpret_cast<const char*>(profile->GetMapping()),
+               profile->GetSize()});
+        } else {
+          prefetcher.PrefetchAll();
+        }
+      });
+}
+
+void DartVM::RecordSnapshotPageProfile() {
+  if (!needs_snapshot_page_profile_.load(std::memory_order_relaxed) ||
+      !needs_snapshot_page_profile_.exchange(false)) {
+    return;
+  }
+  concurrent_message_loop_->GetTaskRunner()->PostTask(
+      [vm_data = vm_data_, path = settings_.snapshot_page_profile_path]() {
+        DartSnapshotPrefetcher prefetcher(vm_data->GetVMSnapshot(),
+                                          *vm_data->GetIsolateSnapshot());
+        auto profile = prefetcher.CaptureProfile();
+        if (profile.empty()) {
+          return;
+        }
+        auto directory_path = fml::paths::GetDirectoryName(path);
+        auto directory = fml::OpenDirectory(
+            directory_path.empty() ? "." : directory_path.c_str(), false,
+            fml::FilePermission::kReadWrite);
+        auto file_name = path.substr(path.find_last_of("/\\") + 1);
+        fml::DataMapping mapping(profile);
+        if (!directory.is_valid() ||
+            !fml::WriteAtomically(directory, file_name.c_str(), mapping)) {
+          FML_LOG(ERROR) << "Could not write the snapshot page profile to "
+                         << path;
+        }
+      });
+}
+
 std::shared_ptr<const DartVMData> DartVM::GetVMData() const {
   return vm_data_;
 }
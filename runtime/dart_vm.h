@@ -5,6 +5,7 @@
 #ifndef FLUTTER_RUNTIME_DART_VM_H_
 #define FLUTTER_RUNTIME_DART_VM_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -160,6 +161,19 @@ class DartVM {
   ///
   std::shared_ptr<fml::ConcurrentMessageLoop> GetConcurrentMessageLoop();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Captures which pages of the snapshots are resident and writes
+  ///             them to `Settings::snapshot_page_profile_path` on a worker
+  ///             thread, so that the snapshot prefetch of the next launches
+  ///             can be limited to those pages. Shells call this once they
+  ///             have rasterized their first frame.
+  ///
+  ///             The profile is only recorded once per VM, and only if the
+  ///             snapshot prefetch is enabled and the profile did not exist
+  ///             when the VM was created.
+  ///
+  void RecordSnapshotPageProfile();
+
  private:
   const Settings settings_;
   std::shared_ptr<fml::ConcurrentMessageLoop> concurrent_message_loop_;
@@ -167,6 +181,9 @@ class DartVM {
   std::shared_ptr<const DartVMData> vm_data_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   const std::shared_ptr<ServiceProtocol> service_protocol_;
+  std::atomic_bool needs_snapshot_page_profile_ = false;
+
+  void PrefetchSnapshots();
 
   friend class DartVMRef;
   friend class DartIsolate;
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -391,6 +392,8 @@ bool RuntimeController::LaunchRootIsolate(
     std::optional<std::string> dart_entrypoint_library,
     const std::vector<std::string>& dart_entrypoint_args,
     std::unique_ptr<IsolateConfiguration> isolate_configuration) {
+  fml::StartupProfiler::ScopedSpan startup_span(
+      "RuntimeController::LaunchRootIsolate");
   if (root_isolate_.lock()) {
     FML_LOG(ERROR) << "Root isolate was already running.";
     return false;
@@ -37,6 +37,10 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetResourceMemoryUsageExtensionName =
+    "_flutter.getResourceMemoryUsage";
+const std::string_view ServiceProtocol::kGetStartupProfileExtensionName =
+    "_flutter.getStartupProfile";
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
@@ -61,6 +65,8 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetResourceMemoryUsageExtensionName,
+          kGetStartupProfileExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
       }),
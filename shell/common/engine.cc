@@ -151,6 +151,11 @@ void Engine::SetupDefaultFontManager() {
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
+void Engine::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  TRACE_EVENT0("flutter", "Engine::SetDefaultFontManager");
+  font_collection_->SetDefaultFontManager(std::move(font_manager));
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
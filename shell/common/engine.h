@@ -445,6 +445,13 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Uses a default font manager that was loaded ahead of time,
+  ///             for example on a worker while the other subsystems of the
+  ///             shell were set up.
+  ///
+  void SetDefaultFontManager(sk_sp<SkFontMgr> font_manager);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/sksl_warmup.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
@@ -362,5 +363,105 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, RecordsAndPersistsSkSLUsage) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  sk_sp<SkData> early_key = SkData::MakeWithCString("early");
+  sk_sp<SkData> late_key = SkData::MakeWithCString("late");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+
+  auto* persistent_cache = PersistentCache::GetCacheForProcess();
+  persistent_cache->MarkFrameStart();
+  StorePersistentCache(persistent_cache, *early_key, *value);
+  persistent_cache->MarkFrameStart();
+  persistent_cache->MarkFrameStart();
+  StorePersistentCache(persistent_cache, *late_key, *value);
+  ASSERT_NE(persistent_cache->load(*late_key), nullptr);
+
+  auto check_usage = [&](PersistentCache* cache, uint32_t late_use_count) {
+    auto early = cache->GetSkSLUsage(*early_key);
+    ASSERT_EQ(early.first_use_frame, 1u);
+    ASSERT_EQ(early.use_count, 1u);
+    auto late = cache->GetSkSLUsage(*late_key);
+    ASSERT_EQ(late.first_use_frame, 3u);
+    ASSERT_EQ(late.use_count, late_use_count);
+    auto unknown = cache->GetSkSLUsage(*value);
+    ASSERT_EQ(unknown.first_use_frame,
+              PersistentCache::SkSLUsage::kUnknownFrame);
+    ASSERT_EQ(unknown.use_count, 0u);
+  };
+  check_usage(persistent_cache, 2u);
+
+  // Usage is written as a whole each time, so persisting it repeatedly does
+  // not count earlier uses again.
+  persistent_cache->PersistSkSLUsage();
+  ASSERT_NE(persistent_cache->load(*late_key), nullptr);
+  persistent_cache->PersistSkSLUsage();
+  check_usage(persistent_cache, 3u);
+
+  // The usage survives into the next run.
+  PersistentCache::ResetCacheForProcess();
+  check_usage(PersistentCache::GetCacheForProcess(), 3u);
+
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, SkSLWarmupPrioritizesByUsage) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  auto* persistent_cache = PersistentCache::GetCacheForProcess();
+  auto store = [persistent_cache](const char* key) {
+    StorePersistentCache(persistent_cache, *SkData::MakeWithCString(key),
+                         *SkData::MakeWithCString("sksl"));
+  };
+
+  // A shader without any recorded usage, e.g. from a previous engine version.
+  std::vector<std::string> components = {
+      "flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion(),
+      PersistentCache::kSkSLSubdirName};
+  auto sksl_dir = fml::CreateDirectory(base_dir.fd(), components,
+                                       fml::FilePermission::kReadWrite);
+  auto unknown = PersistentCache::BuildCacheObject(
+      *SkData::MakeWithCString("unknown"), *SkData::MakeWithCString("sksl"));
+  ASSERT_TRUE(fml::WriteAtomically(sksl_dir, "unknown", *unknown));
+
+  persistent_cache->MarkFrameStart();
+  store("first");
+  persistent_cache->MarkFrameStart();
+  persistent_cache->MarkFrameStart();
+  store("third");
+  persistent_cache->MarkFrameStart();
+  persistent_cache->MarkFrameStart();
+  store("fifth_once");
+  store("fifth_twice");
+  store("fifth_twice");
+
+  SkSLWarmup warmup(*persistent_cache);
+  std::vector<std::string> order;
+  for (const auto& sksl : warmup.GetSkSLs()) {
+    order.emplace_back(static_cast<const char*>(sksl.key->data()));
+  }
+  std::vector<std::string> expected_order = {
+      "first", "unknown", "third", "fifth_twice", "fifth_once"};
+  ASSERT_EQ(order, expected_order);
+  ASSERT_EQ(warmup.GetCriticalCount(), 2u);
+  ASSERT_EQ(warmup.GetPendingCount(), 5u);
+
+  // Nothing can be precompiled without a context.
+  ASSERT_EQ(warmup.PrecompileCritical(nullptr), 0u);
+  ASSERT_EQ(warmup.PrecompileBatch(nullptr, fml::TimeDelta::Max()), 0u);
+  ASSERT_FALSE(warmup.IsComplete());
+
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
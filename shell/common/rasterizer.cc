@@ -11,6 +11,7 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -30,6 +31,10 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// The fraction of the frame budget that a batch of the SkSL warmup may take,
+// even if the engine is idle for longer.
+static constexpr double kSkSLWarmupBatchBudgetFraction = 0.25;
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -40,10 +45,54 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  AddResourceMemorySources();
+  resource_memory_registry_.SetBudgetBytes(
+      delegate.GetSettings().resource_memory_budget_bytes);
 }
 
 Rasterizer::~Rasterizer() = default;
 
+static size_t GetSkiaResourceCacheBytes(GrDirectContext* context) {
+  size_t bytes = 0;
+  context->getResourceCacheUsage(nullptr, &bytes);
+  return bytes;
+}
+
+void Rasterizer::AddResourceMemorySources() {
+  // Sources are trimmed in this order, cheapest to rebuild first. Raster cache
+  // entries are re-rasterized from display lists, while Skia's resources
+  // include uploaded textures and compiled programs. The DecodedImageCache is
+  // shared by every engine in the process and kept within its own budget, so
+  // it is not a source of any one rasterizer.
+  resource_memory_registry_.AddSource(
+      "rasterCache",
+      [this]() {
+        const auto& raster_cache = compositor_context_->raster_cache();
+        return raster_cache.EstimateLayerCacheByteSize() +
+               raster_cache.EstimatePictureCacheByteSize();
+      },
+      [this](size_t bytes_to_free) {
+        return compositor_context_->raster_cache().Trim(bytes_to_free);
+      });
+  resource_memory_registry_.AddSource(
+      "skiaResourceCache",
+      [this]() -> size_t {
+        GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+        return context ? GetSkiaResourceCacheBytes(context) : 0;
+      },
+      [this](size_t bytes_to_free) -> size_t {
+        GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+        if (!context) {
+          return 0;
+        }
+        size_t before = GetSkiaResourceCacheBytes(context);
+        context->purgeUnlockedResources(bytes_to_free,
+                                        /*preferScratchResources=*/true);
+        size_t after = GetSkiaResourceCacheBytes(context);
+        return before > after ? before - after : 0;
+      });
+}
+
 fml::TaskRunnerAffineWeakPtr<Rasterizer> Rasterizer::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -64,6 +113,7 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   auto context_switch = surface_->MakeRenderContextCurrent();
   if (context_switch->GetResult()) {
     compositor_context_->OnGrContextCreated();
+    StartSkSLWarmup();
   }
 
   if (external_view_embedder_ &&
@@ -106,6 +156,8 @@ void Rasterizer::Teardown() {
 
   last_layer_tree_.reset();
 
+  PersistentCache::GetCacheForProcess()->PersistSkSLUsage();
+
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
     FML_DCHECK(raster_thread_merger_->IsEnabled());
@@ -197,8 +249,18 @@ RasterStatus Rasterizer::Draw(
         if (discard_callback(*layer_tree.get())) {
           raster_status = RasterStatus::kDiscarded;
         } else {
+          const bool is_first_frame = !startup_profile_finished_;
+          const auto draw_start =
+              is_first_frame ? fml::TimePoint::Now() : fml::TimePoint();
           raster_status =
               DoDraw(std::move(frame_timings_recorder), std::move(layer_tree));
+          if (is_first_frame && raster_status == RasterStatus::kSuccess) {
+            startup_profile_finished_ = true;
+            auto& startup_profiler = fml::StartupProfiler::GetInstance();
+            startup_profiler.AddSpan("Rasterizer::Draw (first frame)", {},
+                                     draw_start, fml::TimePoint::Now());
+            startup_profiler.Finish();
+          }
         }
       };
 
@@ -378,6 +440,7 @@ RasterStatus Rasterizer::DoDraw(
 
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
+  persistent_cache->MarkFrameStart();
 
   RasterStatus raster_status =
       DrawToSurface(*frame_timings_recorder, *layer_tree);
@@ -399,6 +462,12 @@ RasterStatus Rasterizer::DoDraw(
     persistent_cache->DumpSkp(*screenshot.data);
   }
 
+  // Deferred shaders are only precompiled once a frame has made it to the
+  // screen so that they never delay the first frame.
+  if (raster_status == RasterStatus::kSuccess) {
+    sksl_warmup_frame_drawn_ = true;
+  }
+
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
@@ -617,6 +686,9 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
     }
 
+    // The render context is still current, which trimming Skia's cache needs.
+    resource_memory_registry_.EnforceBudget();
+
     return raster_status;
   }
 
@@ -747,6 +819,47 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   return Rasterizer::Screenshot{data, layer_tree->frame_size()};
 }
 
+void Rasterizer::StartSkSLWarmup() {
+  auto* context = surface_->GetContext();
+  if (context == nullptr || context == sksl_warmup_context_) {
+    return;
+  }
+  // Shader precompilation from SkSL is not implemented by the Skia Vulkan
+  // backend.
+  if (context->backend() == GrBackendApi::kVulkan) {
+    return;
+  }
+  sksl_warmup_context_ = context;
+  sksl_warmup_ =
+      std::make_unique<SkSLWarmup>(*PersistentCache::GetCacheForProcess());
+  sksl_warmup_->PrecompileCritical(context);
+}
+
+void Rasterizer::NotifyIdle(fml::TimeDelta deadline) {
+  if (!sksl_warmup_ || !sksl_warmup_frame_drawn_ || !surface_) {
+    return;
+  }
+  auto budget = std::min(
+      deadline - fml::TimePoint::Now().ToEpochDelta(),
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count() *
+                                        kSkSLWarmupBatchBudgetFraction));
+  if (budget <= fml::TimeDelta::Zero()) {
+    return;
+  }
+  auto* context = surface_->GetContext();
+  if (context == nullptr || context != sksl_warmup_context_) {
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  sksl_warmup_->PrecompileBatch(context, budget);
+  if (sksl_warmup_->IsComplete()) {
+    sksl_warmup_.reset();
+  }
+}
+
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
   next_frame_callback_ = callback;
 }
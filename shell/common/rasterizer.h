@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/common/graphics/sksl_warmup.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/display_list/display_list_image.h"
@@ -15,6 +16,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/resource_memory_registry.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -169,6 +171,17 @@ class Rasterizer final : public SnapshotDelegate,
   ///             and waits until it completes.
   void TeardownExternalViewEmbedder();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the rasterizer that the engine is idle until the
+  ///             given deadline, for instance while waiting for the next
+  ///             vsync. The rasterizer uses the time to precompile deferred
+  ///             SkSLs.
+  ///
+  /// @param[in]  deadline  The deadline, in the same time base as
+  ///                       `fml::TimePoint::ToEpochDelta`.
+  ///
+  void NotifyIdle(fml::TimeDelta deadline);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the rasterizer that there is a low memory situation
   ///             and it must purge as many unnecessary resources as possible.
@@ -444,6 +457,18 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accounts for the memory retained by the raster cache, the
+  ///             decoded image cache and Skia's resource cache, and keeps it
+  ///             within `Settings::resource_memory_budget_bytes`. The budget
+  ///             is enforced after every frame.
+  ///
+  /// @attention  The registry may only be used on the raster thread.
+  ///
+  ResourceMemoryRegistry& GetResourceMemoryRegistry() {
+    return resource_memory_registry_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -522,6 +547,13 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Precompiles the critical SkSLs known to the persistent cache in the
+  // context of the current surface, if that has not been done for the context
+  // already.
+  void StartSkSLWarmup();
+
+  void AddResourceMemorySources();
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
@@ -540,9 +572,20 @@ class Rasterizer final : public SnapshotDelegate,
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
+  ResourceMemoryRegistry resource_memory_registry_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  std::unique_ptr<SkSLWarmup> sksl_warmup_;
+  // The context in which the SkSL warmup was last started. It is only
+  // compared against and never dereferenced.
+  GrDirectContext* sksl_warmup_context_ = nullptr;
+  // Deferred SkSLs are only precompiled once a frame has been drawn
+  // successfully.
+  bool sksl_warmup_frame_drawn_ = false;
+  // Whether the first frame was drawn successfully, which ends the recording
+  // of startup spans.
+  bool startup_profile_finished_ = false;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
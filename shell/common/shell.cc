@@ -21,7 +21,9 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
@@ -33,6 +35,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -126,6 +129,7 @@ std::unique_ptr<Shell> Shell::Create(
   PerformInitializationTasks(settings);
 
   TRACE_EVENT0("flutter", "Shell::Create");
+  fml::StartupProfiler::ScopedSpan startup_span("Shell::Create");
 
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
@@ -183,6 +187,36 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
+  // The subsystems below are set up concurrently on their threads, and each
+  // step only waits for the results of the steps it depends on:
+  // - The default font manager (worker) and the rasterizer (raster) depend on
+  //   nothing.
+  // - The IO manager (IO) depends on the platform view (platform).
+  // - The engine (UI) depends on the platform view, the references published
+  //   by the IO manager and the snapshot delegate of the rasterizer.
+  // - Setup (platform) joins all of them except for the default font manager,
+  //   which the UI thread waits for afterwards.
+
+  // Loading the default font manager of the platform does not depend on any
+  // other subsystem and can take a long time, so it is started on a worker
+  // right away. The UI thread only waits for it after the shell is set up.
+  std::shared_future<sk_sp<SkFontMgr>> default_font_manager_future;
+  if (!settings.prefetched_default_font_manager) {
+    auto default_font_manager_promise =
+        std::make_shared<std::promise<sk_sp<SkFontMgr>>>();
+    default_font_manager_future =
+        default_font_manager_promise->get_future().share();
+    shell->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask(
+        [default_font_manager_promise,
+         font_initialization_data = settings.font_initialization_data]() {
+          TRACE_EVENT0("flutter", "ShellLoadDefaultFontManager");
+          fml::StartupProfiler::ScopedSpan startup_span(
+              "Shell::LoadDefaultFontManager");
+          default_font_manager_promise->set_value(
+              txt::GetDefaultFontManager(font_initialization_data));
+        });
+  }
+
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
   auto rasterizer_future = rasterizer_promise.get_future();
@@ -217,7 +251,10 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
-  // other subsystems.
+  // other subsystems. Those references are published before the resource
+  // context is created, so that creating the engine does not wait for it. This
+  // is safe because all uses of the resource context are tasks on the IO
+  // thread, which only run after this one.
   std::promise<std::shared_ptr<ShellIOManager>> io_manager_promise;
   auto io_manager_future = io_manager_promise.get_future();
   std::promise<fml::WeakPtr<ShellIOManager>> weak_io_manager_promise;
@@ -245,14 +282,29 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
           io_manager = parent_io_manager;
         } else {
           io_manager = std::make_shared<ShellIOManager>(
-              platform_view_ptr->CreateResourceContext(),  // resource context
-              is_backgrounded_sync_switch,                 // sync switch
-              io_task_runner,  // unref queue task runner
+              nullptr,                      // resource context
+              is_backgrounded_sync_switch,  // sync switch
+              io_task_runner,               // unref queue task runner
               platform_view_ptr->GetImpellerContext()  // impeller context
           );
         }
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+        if (!parent_io_manager) {
+          TRACE_EVENT0("flutter", "ShellCreateResourceContext");
+          auto resource_context = platform_view_ptr->CreateResourceContext();
+          if (resource_context) {
+            io_manager->NotifyResourceContextAvailable(
+                std::move(resource_context));
+          } else {
+#ifndef OS_FUCHSIA
+            FML_DLOG(WARNING)
+                << "The IO manager was initialized without a resource "
+                   "context. Async texture uploads will be disabled. "
+                   "Expect performance degradation.";
+#endif  // OS_FUCHSIA
+          }
+        }
         io_manager_promise.set_value(io_manager);
       });
 
@@ -307,6 +359,18 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  if (default_font_manager_future.valid()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetUITaskRunner(),
+        [engine = shell->weak_engine_,
+         default_font_manager_future =
+             std::move(default_font_manager_future)] {
+          if (engine) {
+            engine->SetDefaultFontManager(default_font_manager_future.get());
+          }
+        });
+  }
+
   return shell;
 }
 
@@ -328,6 +392,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
   PerformInitializationTasks(settings);
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshot");
+  fml::StartupProfiler::ScopedSpan startup_span("Shell::CreateWithSnapshot");
 
   const bool callbacks_valid =
       on_create_platform_view && on_create_rasterizer && on_create_engine;
@@ -442,6 +507,16 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetResourceMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetResourceMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetStartupProfileExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupProfile, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_
       [ServiceProtocol::kRenderFrameWithRasterStatsExtensionName] = {
           task_runners_.GetRasterTaskRunner(),
@@ -683,16 +758,6 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
-  // Setup the time-consuming default font manager right after engine created.
-  if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
-                                        }
-                                      });
-  }
-
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
@@ -1141,6 +1206,13 @@ void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
   }
+
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = weak_rasterizer_, deadline]() {
+        if (rasterizer) {
+          rasterizer->NotifyIdle(deadline);
+        }
+      });
 }
 
 void Shell::OnAnimatorUpdateLatestFrameTargetTime(
@@ -1451,6 +1523,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  // The pages of the snapshots that are resident now are the ones the first
+  // frame needed.
+  vm_->RecordSnapshotPageProfile();
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1794,6 +1870,59 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetResourceMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& registry = rasterizer_->GetResourceMemoryRegistry();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ResourceMemoryUsage", allocator);
+  response->AddMember<uint64_t>("budgetBytes", registry.GetBudgetBytes(),
+                                allocator);
+  rapidjson::Value sources(rapidjson::kArrayType);
+  uint64_t total_bytes = 0;
+  for (const auto& usage : registry.GetUsage()) {
+    rapidjson::Value source(rapidjson::kObjectType);
+    source.AddMember("name", rapidjson::Value(usage.name.c_str(), allocator),
+                     allocator);
+    source.AddMember<uint64_t>("bytes", usage.bytes, allocator);
+    sources.PushBack(source, allocator);
+    total_bytes += usage.bytes;
+  }
+  response->AddMember("totalBytes", total_bytes, allocator);
+  response->AddMember("sources", sources, allocator);
+  // Shared by every engine in the process, so not part of the total above.
+  const auto& decoded_image_cache = DecodedImageCache::GetInstance();
+  rapidjson::Value process_sources(rapidjson::kObjectType);
+  process_sources.AddMember<uint64_t>(
+      "decodedImageCacheBytes", decoded_image_cache.GetCurrentBytes(),
+      allocator);
+  process_sources.AddMember<uint64_t>("decodedImageCacheMaxBytes",
+                                      decoded_image_cache.GetMaxBytes(),
+                                      allocator);
+  response->AddMember("process", process_sources, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetStartupProfile(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  auto trace = fml::StartupProfiler::GetInstance().ToChromeTraceJSON();
+  response->Parse(trace.c_str(), trace.size());
+  if (response->HasParseError() || !response->IsObject()) {
+    ServiceProtocolFailureError(response, "Could not format the profile.");
+    return false;
+  }
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "StartupProfile", allocator);
+  response->AddMember(
+      "recording", fml::StartupProfiler::GetInstance().IsRecording(),
+      allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
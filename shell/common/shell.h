@@ -703,6 +703,25 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the bytes retained by each of the caches accounted for by
+  // the rasterizer's ResourceMemoryRegistry, and the budget they are kept in.
+  // The process-wide DecodedImageCache is reported separately under
+  // "process", as it is shared with other engines.
+  bool OnServiceProtocolGetResourceMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the spans recorded by the process' fml::StartupProfiler in
+  // the Chrome trace event format, so that the response can be loaded into
+  // chrome://tracing or Perfetto as is.
+  bool OnServiceProtocolGetStartupProfile(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Renders a frame and responds with various statistics pertaining to the
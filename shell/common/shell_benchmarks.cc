@@ -6,13 +6,62 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/shell_spawn_pool.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+static Settings CreateBenchmarkSettings(
+    const fml::UniqueFD& assets_dir,
+    testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<ThreadHost> CreateBenchmarkThreadHost() {
+  return std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::Platform |
+                               ThreadHost::Type::RASTER |
+                               ThreadHost::Type::IO | ThreadHost::Type::UI));
+}
+
+static TaskRunners CreateBenchmarkTaskRunners(const ThreadHost& thread_host) {
+  return TaskRunners("test", thread_host.platform_thread->GetTaskRunner(),
+                     thread_host.raster_thread->GetTaskRunner(),
+                     thread_host.ui_thread->GetTaskRunner(),
+                     thread_host.io_thread->GetTaskRunner());
+}
+
+static std::unique_ptr<PlatformView> CreateBenchmarkPlatformView(
+    Shell& shell) {
+  return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+}
+
+static std::unique_ptr<Rasterizer> CreateBenchmarkRasterizer(Shell& shell) {
+  return std::make_unique<Rasterizer>(shell);
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,42 +73,12 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
-
-    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
-        "io.flutter.bench.", ThreadHost::Type::Platform |
-                                 ThreadHost::Type::RASTER |
-                                 ThreadHost::Type::IO | ThreadHost::Type::UI));
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
-
-    shell = Shell::Create(
-        flutter::PlatformData(), task_runners, settings,
-        [](Shell& shell) {
-          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
-        },
-        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+    thread_host = CreateBenchmarkThreadHost();
+    shell = Shell::Create(flutter::PlatformData(),
+                          CreateBenchmarkTaskRunners(*thread_host), settings,
+                          CreateBenchmarkPlatformView,
+                          CreateBenchmarkRasterizer);
   }
 
   FML_CHECK(shell);
@@ -120,4 +139,89 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures how long it takes to hand out a running shell spawned from an
+// existing one, either by spawning it on demand or by taking it from a pool
+// that spawned it ahead of time. Only the time spent on the platform thread
+// to obtain the shell is measured, not its shutdown or the refill of the pool.
+static void SpawnShells(benchmark::State& state, bool use_pool) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+  auto thread_host = CreateBenchmarkThreadHost();
+  auto task_runners = CreateBenchmarkTaskRunners(*thread_host);
+  auto platform_runner = task_runners.GetPlatformTaskRunner();
+  auto shell = Shell::Create(flutter::PlatformData(), task_runners, settings,
+                             CreateBenchmarkPlatformView,
+                             CreateBenchmarkRasterizer);
+  FML_CHECK(shell);
+
+  auto create_configuration = [&settings]() {
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    configuration.SetEntrypoint("emptyMain");
+    return configuration;
+  };
+
+  auto run_on_platform_thread = [&platform_runner](const fml::closure& task) {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_runner, [&task, &latch]() {
+      task();
+      latch.Signal();
+    });
+    latch.Wait();
+  };
+
+  std::unique_ptr<ShellSpawnPool> pool;
+  if (use_pool) {
+    run_on_platform_thread([&]() {
+      pool = std::make_unique<ShellSpawnPool>(
+          *shell, ShellSpawnPool::Options{}, create_configuration,
+          CreateBenchmarkPlatformView, CreateBenchmarkRasterizer);
+    });
+  }
+
+  while (state.KeepRunning()) {
+    // Flushing the platform thread lets the pool finish its refill.
+    run_on_platform_thread([]() {});
+
+    std::unique_ptr<Shell> spawn;
+    fml::TimeDelta elapsed;
+    run_on_platform_thread([&]() {
+      auto start = fml::TimePoint::Now();
+      if (pool) {
+        spawn = pool->Acquire();
+      } else {
+        spawn = shell->Spawn(create_configuration(), "/",
+                             CreateBenchmarkPlatformView,
+                             CreateBenchmarkRasterizer);
+      }
+      elapsed = fml::TimePoint::Now() - start;
+    });
+    FML_CHECK(spawn);
+    state.SetIterationTime(elapsed.ToSecondsF());
+
+    run_on_platform_thread([&spawn]() { spawn.reset(); });
+  }
+
+  run_on_platform_thread([&]() {
+    pool.reset();
+    shell.reset();
+  });
+  thread_host.reset();
+}
+
+static void BM_ShellSpawn(benchmark::State& state) {
+  SpawnShells(state, false);
+}
+
+BENCHMARK(BM_ShellSpawn)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_ShellSpawnFromPool(benchmark::State& state) {
+  SpawnShells(state, true);
+}
+
+BENCHMARK(BM_ShellSpawnFromPool)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
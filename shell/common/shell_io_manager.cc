@@ -51,15 +51,7 @@ ShellIOManager::ShellIOManager(
           resource_context_)),
       is_gpu_disabled_sync_switch_(std::move(is_gpu_disabled_sync_switch)),
       impeller_context_(std::move(impeller_context)),
-      weak_factory_(this) {
-  if (!resource_context_) {
-#ifndef OS_FUCHSIA
-    FML_DLOG(WARNING) << "The IO manager was initialized without a resource "
-                         "context. Async texture uploads will be disabled. "
-                         "Expect performance degradation.";
-#endif  // OS_FUCHSIA
-  }
-}
+      weak_factory_(this) {}
 
 ShellIOManager::~ShellIOManager() {
   // Last chance to drain the IO queue as the platform side reference to the
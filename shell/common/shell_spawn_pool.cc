@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shell_spawn_pool.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ShellSpawnPool::ShellSpawnPool(
+    const Shell& parent,
+    Options options,
+    ConfigurationFactory configuration_factory,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer)
+    : parent_(parent),
+      options_(std::move(options)),
+      configuration_factory_(std::move(configuration_factory)),
+      on_create_platform_view_(std::move(on_create_platform_view)),
+      on_create_rasterizer_(std::move(on_create_rasterizer)),
+      weak_factory_(this) {
+  FML_DCHECK(parent_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  FML_DCHECK(configuration_factory_);
+  ScheduleFill();
+}
+
+ShellSpawnPool::~ShellSpawnPool() {
+  FML_DCHECK(parent_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  ready_.clear();
+}
+
+std::unique_ptr<Shell> ShellSpawnPool::Acquire() {
+  TRACE_EVENT0("flutter", "ShellSpawnPool::Acquire");
+  FML_DCHECK(parent_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  std::unique_ptr<Shell> result;
+  if (ready_.empty()) {
+    result = SpawnShell();
+  } else {
+    result = std::move(ready_.front());
+    ready_.pop_front();
+  }
+  ScheduleFill();
+  return result;
+}
+
+void ShellSpawnPool::Drain() {
+  TRACE_EVENT0("flutter", "ShellSpawnPool::Drain");
+  drained_ = true;
+  ready_.clear();
+}
+
+void ShellSpawnPool::Resume() {
+  drained_ = false;
+  ScheduleFill();
+}
+
+size_t ShellSpawnPool::GetReadyCount() const {
+  return ready_.size();
+}
+
+size_t ShellSpawnPool::GetReadyBytes() const {
+  return ready_.size() * options_.bytes_per_shell;
+}
+
+size_t ShellSpawnPool::GetCapacity() const {
+  if (options_.max_bytes == 0 || options_.bytes_per_shell == 0) {
+    return options_.max_shells;
+  }
+  return std::min(options_.max_shells,
+                  options_.max_bytes / options_.bytes_per_shell);
+}
+
+std::unique_ptr<Shell> ShellSpawnPool::SpawnShell() {
+  TRACE_EVENT0("flutter", "ShellSpawnPool::SpawnShell");
+  return parent_.Spawn(configuration_factory_(), options_.initial_route,
+                       on_create_platform_view_, on_create_rasterizer_);
+}
+
+void ShellSpawnPool::ScheduleFill() {
+  if (fill_pending_ || drained_ || ready_.size() >= GetCapacity()) {
+    return;
+  }
+  fill_pending_ = true;
+  // Each task spawns a single shell so that tasks already queued on the
+  // platform thread are not held up by filling the whole pool at once.
+  parent_.GetTaskRunners().GetPlatformTaskRunner()->PostTask(
+      [weak = weak_factory_.GetWeakPtr()]() {
+        if (weak) {
+          weak->Fill();
+        }
+      });
+}
+
+void ShellSpawnPool::Fill() {
+  fill_pending_ = false;
+  if (drained_ || ready_.size() >= GetCapacity()) {
+    return;
+  }
+  auto shell = SpawnShell();
+  if (!shell) {
+    FML_LOG(ERROR) << "Could not spawn a shell for the pool.";
+    return;
+  }
+  ready_.push_back(std::move(shell));
+  ScheduleFill();
+}
+
+}  // namespace flutter
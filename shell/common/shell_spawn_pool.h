@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHELL_SPAWN_POOL_H_
+#define FLUTTER_SHELL_COMMON_SHELL_SPAWN_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/shell.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps a bounded number of shells spawned from a parent shell
+///             ready to be handed out.
+///
+///             Spawning still creates a platform view, rasterizer, engine and
+///             root isolate synchronously. Embedders that open many
+///             short-lived views can use this pool to move that work off the
+///             critical path: shells are spawned one at a time in tasks posted
+///             to the platform task runner, and |Acquire| only pops a shell
+///             that is already running its entrypoint.
+///
+///             Pooled shells have not been given a surface. Their rasterizers
+///             stay idle until the embedder notifies the platform view of the
+///             surface it was acquired for, so the platform view created by
+///             |on_create_platform_view| must not depend on a particular
+///             native view.
+///
+///             The pool is affine to the platform thread of the parent shell
+///             and must be created, used and collected there. The parent shell
+///             must outlive the pool.
+///
+class ShellSpawnPool {
+ public:
+  struct Options {
+    /// The maximum number of shells kept ready.
+    size_t max_shells = 1;
+
+    /// The maximum number of bytes that ready shells may account for. Zero
+    /// means that only |max_shells| bounds the pool.
+    size_t max_bytes = 0;
+
+    /// The number of bytes each ready shell is accounted for. Embedders should
+    /// measure this on their platforms, as it mostly consists of the heap of
+    /// the spawned isolate and the platform view.
+    size_t bytes_per_shell = 0;
+
+    /// The route the spawned engines are created with.
+    std::string initial_route;
+  };
+
+  /// Creates the configuration the spawned isolates run. It is invoked once
+  /// per spawned shell, and the configurations it returns must reference the
+  /// snapshot of the parent shell.
+  using ConfigurationFactory = std::function<RunConfiguration()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pool and starts filling it.
+  ///
+  /// @param[in]  parent                   The shell that spawns pooled shells.
+  /// @param[in]  options                  The size limits of the pool.
+  /// @param[in]  configuration_factory    Creates the configuration of each
+  ///                                      spawned isolate.
+  /// @param[in]  on_create_platform_view  Creates the platform view of each
+  ///                                      spawned shell.
+  /// @param[in]  on_create_rasterizer     Creates the rasterizer of each
+  ///                                      spawned shell.
+  ///
+  ShellSpawnPool(const Shell& parent,
+                 Options options,
+                 ConfigurationFactory configuration_factory,
+                 Shell::CreateCallback<PlatformView> on_create_platform_view,
+                 Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Synchronously shuts down all shells that are still pooled.
+  ///
+  ~ShellSpawnPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands out a ready shell and schedules a replacement. If the
+  ///             pool is empty, a shell is spawned synchronously instead.
+  ///
+  /// @return     A running shell, or null if spawning failed.
+  ///
+  std::unique_ptr<Shell> Acquire();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Shuts down all pooled shells, for example in response to a
+  ///             low memory warning. The pool is not refilled until
+  ///             |Resume| is called.
+  ///
+  void Drain();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resumes filling the pool after it was drained.
+  ///
+  void Resume();
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of shells that are ready to be handed out.
+  ///
+  size_t GetReadyCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of bytes the ready shells account for.
+  ///
+  size_t GetReadyBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of ready shells the options allow for.
+  ///
+  size_t GetCapacity() const;
+
+ private:
+  const Shell& parent_;
+  const Options options_;
+  const ConfigurationFactory configuration_factory_;
+  const Shell::CreateCallback<PlatformView> on_create_platform_view_;
+  const Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
+  std::deque<std::unique_ptr<Shell>> ready_;
+  bool fill_pending_ = false;
+  bool drained_ = false;
+  fml::WeakPtrFactory<ShellSpawnPool> weak_factory_;
+
+  std::unique_ptr<Shell> SpawnShell();
+
+  void ScheduleFill();
+
+  void Fill();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellSpawnPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHELL_SPAWN_POOL_H_
@@ -265,6 +265,12 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kEstimateRasterCacheMemory:
         shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
         break;
+      case ServiceProtocolEnum::kGetResourceMemoryUsage:
+        shell->OnServiceProtocolGetResourceMemoryUsage(params, response);
+        break;
+      case ServiceProtocolEnum::kGetStartupProfile:
+        shell->OnServiceProtocolGetStartupProfile(params, response);
+        break;
       case ServiceProtocolEnum::kSetAssetBundlePath:
         shell->OnServiceProtocolSetAssetBundlePath(params, response);
         break;
@@ -105,6 +105,8 @@ class ShellTest : public FixtureTest {
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetResourceMemoryUsage,
+    kGetStartupProfile,
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
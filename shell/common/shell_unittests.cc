@@ -8,6 +8,7 @@
 #include <ctime>
 #include <future>
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -22,11 +23,14 @@
 #include "flutter/fml/dart/dart_converter.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/startup_profiler.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/shell_spawn_pool.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -2523,6 +2527,111 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetResourceMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  settings.resource_memory_budget_bytes = 1234;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetResourceMemoryUsage,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "ResourceMemoryUsage");
+  EXPECT_EQ(document["budgetBytes"].GetUint64(), 1234u);
+  const auto& sources = document["sources"];
+  ASSERT_TRUE(sources.IsArray());
+  ASSERT_EQ(sources.Size(), 2u);
+  EXPECT_STREQ(sources[0]["name"].GetString(), "rasterCache");
+  EXPECT_STREQ(sources[1]["name"].GetString(), "skiaResourceCache");
+  uint64_t total_bytes = 0;
+  for (const auto& source : sources.GetArray()) {
+    total_bytes += source["bytes"].GetUint64();
+  }
+  EXPECT_EQ(document["totalBytes"].GetUint64(), total_bytes);
+  const auto& process = document["process"];
+  ASSERT_TRUE(process.IsObject());
+  EXPECT_EQ(process["decodedImageCacheMaxBytes"].GetUint64(),
+            DecodedImageCache::GetInstance().GetMaxBytes());
+  EXPECT_TRUE(process["decodedImageCacheBytes"].IsUint64());
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetStartupProfileWorks) {
+  fml::StartupProfiler::GetInstance().Reset();
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetStartupProfile,
+      shell->GetTaskRunners().GetPlatformTaskRunner(), empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "StartupProfile");
+  // No frame was drawn yet.
+  EXPECT_TRUE(document["recording"].GetBool());
+  const auto& events = document["traceEvents"];
+  ASSERT_TRUE(events.IsArray());
+  std::vector<std::string> names;
+  for (const auto& event : events.GetArray()) {
+    EXPECT_STREQ(event["ph"].GetString(), "X");
+    EXPECT_GE(event["dur"].GetInt64(), 0);
+    names.push_back(event["name"].GetString());
+  }
+  auto has_span = [&names](const std::string& name) {
+    return std::find(names.begin(), names.end(), name) != names.end();
+  };
+  EXPECT_TRUE(has_span("Shell::Create"));
+  EXPECT_TRUE(has_span("Shell::CreateWithSnapshot"));
+  EXPECT_TRUE(has_span("DartSnapshot::IsolateSnapshotFromSettings"));
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, StartupProfileEndsWithTheFirstFrame) {
+  auto& startup_profiler = fml::StartupProfiler::GetInstance();
+  startup_profiler.Reset();
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  // The frame is drawn by a task that was posted before this one.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(),
+      [&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  EXPECT_FALSE(startup_profiler.IsRecording());
+  auto spans = startup_profiler.GetSpans();
+  EXPECT_EQ(std::count_if(spans.begin(), spans.end(),
+                          [](const fml::StartupProfiler::Span& span) {
+                            return std::string_view(span.name) ==
+                                   "Rasterizer::Draw (first frame)";
+                          }),
+            1);
+
+  // Later frames are not recorded.
+  PumpOneFrame(shell.get());
+  EXPECT_EQ(startup_profiler.GetSpans().size(), spans.size());
+
+  PlatformViewNotifyDestroyed(shell.get());
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -3223,6 +3332,75 @@ TEST_F(ShellTest, IOManagerIsSharedBetweenParentAndSpawnedShell) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, SpawnPoolHandsOutPrewarmedShells) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  MockPlatformViewDelegate platform_view_delegate;
+  std::unique_ptr<ShellSpawnPool> pool;
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [&] {
+    ShellSpawnPool::Options options;
+    options.max_shells = 3;
+    options.max_bytes = 2500;
+    options.bytes_per_shell = 1000;
+    options.initial_route = "/foo";
+    pool = std::make_unique<ShellSpawnPool>(
+        *shell, options,
+        [&settings] {
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("emptyMain");
+          return configuration;
+        },
+        [&platform_view_delegate](Shell& shell) {
+          auto result = std::make_unique<MockPlatformView>(
+              platform_view_delegate, shell.GetTaskRunners());
+          ON_CALL(*result, CreateRenderingSurface())
+              .WillByDefault(::testing::Invoke(
+                  [] { return std::make_unique<MockSurface>(); }));
+          return result;
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    // The byte budget is tighter than the shell count.
+    ASSERT_EQ(pool->GetCapacity(), 2u);
+    // Shells are spawned in separate tasks.
+    ASSERT_EQ(pool->GetReadyCount(), 0u);
+  });
+
+  // Every fill task spawns one shell and posts the next.
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [] {});
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [] {});
+
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [&] {
+    ASSERT_EQ(pool->GetReadyCount(), 2u);
+    ASSERT_EQ(pool->GetReadyBytes(), 2000u);
+
+    auto spawn = pool->Acquire();
+    ASSERT_TRUE(ValidateShell(spawn.get()));
+    ASSERT_EQ(pool->GetReadyCount(), 1u);
+    PostSync(spawn->GetTaskRunners().GetUITaskRunner(), [&spawn] {
+      ASSERT_EQ("emptyMain", spawn->GetEngine()->GetLastEntrypoint());
+      ASSERT_EQ("/foo", spawn->GetEngine()->InitialRoute());
+    });
+    DestroyShell(std::move(spawn));
+
+    pool->Drain();
+    ASSERT_EQ(pool->GetReadyCount(), 0u);
+    ASSERT_EQ(pool->GetReadyBytes(), 0u);
+
+    // Drained pools still spawn on demand but are not refilled.
+    spawn = pool->Acquire();
+    ASSERT_TRUE(ValidateShell(spawn.get()));
+    DestroyShell(std::move(spawn));
+  });
+
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [&] {
+    ASSERT_EQ(pool->GetReadyCount(), 0u);
+    pool.reset();
+  });
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, IOManagerInSpawnedShellIsNotNullAfterParentShellDestroyed) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -3651,6 +3829,30 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, DefaultFontManagerIsLoadedWhileTheShellIsCreated) {
+  auto get_font_manager_count = [this](Shell* shell) {
+    size_t font_manager_count = 0;
+    PostSync(shell->GetTaskRunners().GetUITaskRunner(),
+             [this, shell, &font_manager_count]() {
+               font_manager_count =
+                   GetFontCollection(shell)->GetFontManagersCount();
+             });
+    return font_manager_count;
+  };
+
+  auto prefetched_settings = CreateSettingsForFixture();
+  prefetched_settings.prefetched_default_font_manager = true;
+  auto prefetched_shell = CreateShell(prefetched_settings);
+  auto prefetched_count = get_font_manager_count(prefetched_shell.get());
+  DestroyShell(std::move(prefetched_shell));
+
+  // Without the flag, the default font manager is loaded on a worker and set
+  // up before any task posted to the UI thread after the shell was created.
+  auto shell = CreateShell(CreateSettingsForFixture());
+  ASSERT_EQ(get_font_manager_count(shell.get()), prefetched_count + 1);
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
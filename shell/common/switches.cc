@@ -431,6 +431,13 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
+  settings.prefetch_dart_snapshot =
+      command_line.HasOption(FlagForSwitch(Switch::PrefetchDartSnapshot));
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPageProfilePath),
+                              &settings.snapshot_page_profile_path);
+  settings.aot_instructions_huge_pages =
+      command_line.HasOption(FlagForSwitch(Switch::AotInstructionsHugePages));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -474,6 +481,26 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    std::string decoded_image_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxBytes),
+        &decoded_image_cache_max_bytes);
+    settings.decoded_image_cache_max_bytes =
+        std::stoull(decoded_image_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ResourceMemoryBudgetBytes))) {
+    std::string resource_memory_budget_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ResourceMemoryBudgetBytes),
+        &resource_memory_budget_bytes);
+    settings.resource_memory_budget_bytes =
+        std::stoull(resource_memory_budget_bytes);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
@@ -185,6 +185,19 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(PrefetchDartSnapshot,
+           "prefetch-dart-snapshot",
+           "Read the pages of the Dart snapshots into memory on a worker "
+           "thread as the VM starts.")
+DEF_SWITCH(SnapshotPageProfilePath,
+           "snapshot-page-profile-path",
+           "Path to the page profile that limits the Dart snapshot prefetch to "
+           "the pages needed for the first frame. If the file does not exist, "
+           "it is recorded once the first frame has been rasterized.")
+DEF_SWITCH(AotInstructionsHugePages,
+           "aot-instructions-huge-pages",
+           "Back the instructions of AOT snapshots with transparent huge "
+           "pages. This is only supported on Linux and Android.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
@@ -229,6 +242,14 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The max bytes of the decoded image cache shared by all engines in "
+           "the process, or 0 to disable it.")
+DEF_SWITCH(ResourceMemoryBudgetBytes,
+           "resource-memory-budget-bytes",
+           "The budget in bytes for the caches that retain memory across "
+           "frames, or 0 for no budget.")
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
@@ -4,7 +4,6 @@
 
 #include "flutter/shell/gpu/gpu_surface_gl_skia.h"
 
-#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/size.h"
@@ -57,8 +56,6 @@ sk_sp<GrDirectContext> GPUSurfaceGLSkia::MakeGLContext(
 
   context->setResourceCacheLimit(kGrCacheMaxByteSize);
 
-  PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(context.get());
-
   return context;
 }
 
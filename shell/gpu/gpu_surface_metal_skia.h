@@ -31,7 +31,6 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetalSkia : public Surface {
   const GPUSurfaceMetalDelegate* delegate_;
   const MTLRenderTargetType render_target_type_;
   sk_sp<GrDirectContext> context_;
-  GrDirectContext* precompiled_sksl_context_ = nullptr;
   MsaaSampleCount msaa_samples_ = MsaaSampleCount::kNone;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
@@ -65,8 +64,6 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetalSkia : public Surface {
   std::unique_ptr<SurfaceFrame> AcquireFrameFromMTLTexture(
       const SkISize& frame_info);
 
-  void PrecompileKnownSkSLsIfNecessary();
-
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceMetalSkia);
 };
 
@@ -9,7 +9,6 @@
 
 #include <utility>
 
-#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/platform/darwin/cf_utils.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
@@ -72,16 +71,6 @@ bool GPUSurfaceMetalSkia::IsValid() {
   return context_ != nullptr;
 }
 
-void GPUSurfaceMetalSkia::PrecompileKnownSkSLsIfNecessary() {
-  auto* current_context = GetContext();
-  if (current_context == precompiled_sksl_context_) {
-    // Known SkSLs have already been prepared in this context.
-    return;
-  }
-  precompiled_sksl_context_ = current_context;
-  flutter::PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(precompiled_sksl_context_);
-}
-
 // |Surface|
 std::unique_ptr<SurfaceFrame> GPUSurfaceMetalSkia::AcquireFrame(const SkISize& frame_size) {
   if (!IsValid()) {
@@ -100,8 +89,6 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalSkia::AcquireFrame(const SkISize& f
         [](const SurfaceFrame& surface_frame, SkCanvas* canvas) { return true; }, frame_size);
   }
 
-  PrecompileKnownSkSLsIfNecessary();
-
   switch (render_target_type_) {
     case MTLRenderTargetType::kCAMetalLayer:
       return AcquireFrameFromCAMetalLayer(frame_size);
@@ -249,10 +236,6 @@ GrDirectContext* GPUSurfaceMetalSkia::GetContext() {
 
 // |Surface|
 std::unique_ptr<GLContextResult> GPUSurfaceMetalSkia::MakeRenderContextCurrent() {
-  // A context may either be necessary to render to the surface or to snapshot an offscreen
-  // surface. Either way, SkSL precompilation must be attempted.
-  PrecompileKnownSkSLsIfNecessary();
-
   // This backend has no such concept.
   return std::make_unique<GLContextDefaultResult>(true);
 }
@@ -47,7 +47,7 @@ void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
       view_params_.at(view_id) == *params.get()) {
     return;
   }
-  view_params_.insert_or_assign(view_id, EmbeddedViewParams(*params.get()));
+  view_params_.insert_or_assign(view_id, std::move(*params));
 }
 
 // |ExternalViewEmbedder|
@@ -31,7 +31,18 @@ AccessibilityBridge::~AccessibilityBridge() {
 
 void AccessibilityBridge::AddFlutterSemanticsNodeUpdate(
     const FlutterSemanticsNode* node) {
-  pending_semantics_node_updates_[node->id] = FromFlutterSemanticsNode(node);
+  SemanticsNode update = FromFlutterSemanticsNode(node);
+  // The framework resends every node it marked dirty, many of which (such as
+  // the items of a scrolled list whose offsets are unchanged) end up identical
+  // to what is already in the tree. Dropping those here keeps them out of the
+  // ui::AXTreeUpdate altogether.
+  auto committed = committed_semantics_nodes_.find(node->id);
+  if (committed != committed_semantics_nodes_.end() &&
+      SemanticsNodeEquals(committed->second, update)) {
+    pending_semantics_node_updates_.erase(node->id);
+    return;
+  }
+  pending_semantics_node_updates_[node->id] = std::move(update);
 }
 
 void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
@@ -72,31 +83,46 @@ void AccessibilityBridge::CommitUpdates() {
   // and keep doing so until the update map is empty. We then concatenate the
   // lists in the reversed order, this guarantees parent updates always come
   // before child updates.
+  update.nodes.reserve(pending_semantics_node_updates_.size());
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
 
   tree_.Unserialize(update);
   pending_semantics_node_updates_.clear();
+  // Nodes restored from the committed tree are converted again in later
+  // updates, which may not resend their custom actions.
+  for (auto& [id, action] : pending_semantics_custom_action_updates_) {
+    committed_semantics_custom_actions_[id] = std::move(action);
+  }
   pending_semantics_custom_action_updates_.clear();
 
   std::string error = tree_.error();
   if (!error.empty()) {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    // The tree no longer necessarily matches what was committed before, so
+    // stop dropping updates that look unchanged.
+    committed_semantics_nodes_.clear();
     return;
   }
+  for (auto& sub_tree_list : results) {
+    for (auto& node : sub_tree_list) {
+      int32_t id = node.id;
+      committed_semantics_nodes_[id] = std::move(node);
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -173,6 +199,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -197,8 +224,9 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 std::optional<ui::AXTreeUpdate>
 AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
+  std::vector<int32_t> reparented_ids;
 
-  for (auto node_update : pending_semantics_node_updates_) {
+  for (const auto& node_update : pending_semantics_node_updates_) {
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_.GetFromId(child_id);
@@ -214,10 +242,10 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
         continue;
       }
 
-      // This pending update moves the current child node.
-      // That new child must have a corresponding pending update.
-      assert(pending_semantics_node_updates_.find(child_id) !=
-             pending_semantics_node_updates_.end());
+      // This pending update moves the current child node. Removing it from
+      // its previous parent deletes its subtree, which must then be re-added
+      // in full even if the framework did not resend it.
+      reparented_ids.push_back(child_id);
 
       // Create an update to remove the child from its previous parent.
       int32_t parent_id = child->parent()->id();
@@ -238,12 +266,17 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
     return std::nullopt;
   }
 
+  for (int32_t id : reparented_ids) {
+    RestoreCommittedSubtree(id);
+  }
+
   ui::AXTreeUpdate update{
       .tree_data = tree_.data(),
       .nodes = std::vector<ui::AXNodeData>(),
   };
 
-  for (std::pair<int32_t, ui::AXNodeData> data : updates) {
+  update.nodes.reserve(updates.size());
+  for (auto& data : updates) {
     update.nodes.push_back(std::move(data.second));
   }
 
@@ -251,15 +284,50 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::RestoreCommittedSubtree(int32_t id) {
+  auto pending = pending_semantics_node_updates_.find(id);
+  if (pending == pending_semantics_node_updates_.end()) {
+    auto committed = committed_semantics_nodes_.find(id);
+    if (committed == committed_semantics_nodes_.end()) {
+      return;
+    }
+    pending =
+        pending_semantics_node_updates_.emplace(id, committed->second).first;
+  }
+  // Copied because restoring the children may rehash the pending updates.
+  std::vector<int32_t> children = pending->second.children_in_traversal_order;
+  for (int32_t child : children) {
+    RestoreCommittedSubtree(child);
+  }
+}
+
+// Private method.
+const AccessibilityBridge::SemanticsCustomAction*
+AccessibilityBridge::FindCustomAction(int32_t id) const {
+  auto pending = pending_semantics_custom_action_updates_.find(id);
+  if (pending != pending_semantics_custom_action_updates_.end()) {
+    return &pending->second;
+  }
+  auto committed = committed_semantics_custom_actions_.find(id);
+  if (committed != committed_semantics_custom_actions_.end()) {
+    return &committed->second;
+  }
+  return nullptr;
+}
+
+// Private method.
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  size_t index = result.size();
+  result.push_back(std::move(target));
+  for (size_t i = 0; i < result[index].children_in_traversal_order.size();
+       i++) {
+    int32_t child = result[index].children_in_traversal_order[i];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -290,7 +358,7 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
     node_data.child_ids.push_back(child);
   }
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -490,10 +558,11 @@ void AccessibilityBridge::SetStringListAttributesFromFlutterUpdate(
   if (actions & FlutterSemanticsAction::kFlutterSemanticsActionCustomAction) {
     std::vector<std::string> custom_action_description;
     for (size_t i = 0; i < node.custom_accessibility_actions.size(); i++) {
-      auto iter = pending_semantics_custom_action_updates_.find(
-          node.custom_accessibility_actions[i]);
-      BASE_DCHECK(iter != pending_semantics_custom_action_updates_.end());
-      custom_action_description.push_back(iter->second.label);
+      const SemanticsCustomAction* action =
+          FindCustomAction(node.custom_accessibility_actions[i]);
+      BASE_DCHECK(action);
+      // Descriptions are matched to the action IDs by index.
+      custom_action_description.push_back(action ? action->label : "");
     }
     node_data.AddStringListAttribute(
         ax::mojom::StringListAttribute::kCustomActionDescriptions,
@@ -603,6 +672,36 @@ AccessibilityBridge::FromFlutterSemanticsNode(
   return result;
 }
 
+bool AccessibilityBridge::SemanticsNodeEquals(const SemanticsNode& a,
+                                              const SemanticsNode& b) {
+  return a.id == b.id && a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         a.scroll_position == b.scroll_position &&
+         a.scroll_extent_max == b.scroll_extent_max &&
+         a.scroll_extent_min == b.scroll_extent_min &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.text_direction == b.text_direction &&
+         a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         a.transform.scaleX == b.transform.scaleX &&
+         a.transform.skewX == b.transform.skewX &&
+         a.transform.transX == b.transform.transX &&
+         a.transform.skewY == b.transform.skewY &&
+         a.transform.scaleY == b.transform.scaleY &&
+         a.transform.transY == b.transform.transY &&
+         a.transform.pers0 == b.transform.pers0 &&
+         a.transform.pers1 == b.transform.pers1 &&
+         a.transform.pers2 == b.transform.pers2 &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value && a.tooltip == b.tooltip;
+}
+
 AccessibilityBridge::SemanticsCustomAction
 AccessibilityBridge::FromFlutterSemanticsCustomAction(
     const FlutterSemanticsCustomAction* flutter_custom_action) {
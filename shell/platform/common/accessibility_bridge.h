@@ -179,8 +179,15 @@ class AccessibilityBridge
   ui::AXTree tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The nodes as of the last successful CommitUpdates, used to drop updates
+  // that would not change the tree.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // Every custom action sent so far, for converting nodes whose update does
+  // not resend the actions they refer to.
+  std::unordered_map<int32_t, SemanticsCustomAction>
+      committed_semantics_custom_actions_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
@@ -189,7 +196,14 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
+  // Adds pending updates for the node and its descendants from their committed
+  // versions where the framework did not send one.
+  void RestoreCommittedSubtree(int32_t id);
+
+  // Returns the most recently sent custom action with the given ID, or null.
+  const SemanticsCustomAction* FindCustomAction(int32_t id) const;
+
+  void GetSubTreeList(SemanticsNode target,
                       std::vector<SemanticsNode>& result);
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
@@ -216,6 +230,8 @@ class AccessibilityBridge
   void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode* flutter_node);
+  static bool SemanticsNodeEquals(const SemanticsNode& a,
+                                  const SemanticsNode& b);
   SemanticsCustomAction FromFlutterSemanticsCustomAction(
       const FlutterSemanticsCustomAction* flutter_custom_action);
 
@@ -483,5 +483,118 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+// Verify that nodes which did not change are neither resent to the tree nor
+// required when they are moved to a new parent.
+TEST(AccessibilityBridgeTest, CanReparentUnchangedNodeWithChild) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> root_children{1, 2};
+  std::vector<int32_t> intermediary1_children{3};
+  FlutterSemanticsNode root = CreateSemanticsNode(0, "root", &root_children);
+  FlutterSemanticsNode intermediary1 =
+      CreateSemanticsNode(1, "intermediary 1", &intermediary1_children);
+  FlutterSemanticsNode intermediary2 =
+      CreateSemanticsNode(2, "intermediary 2");
+  FlutterSemanticsNode leaf1 = CreateSemanticsNode(3, "leaf 1");
+
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&intermediary1);
+  bridge->AddFlutterSemanticsNodeUpdate(&intermediary2);
+  bridge->AddFlutterSemanticsNodeUpdate(&leaf1);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  // Resending identical nodes does not change the tree.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&leaf1);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(bridge->accessibility_events.empty());
+
+  // Move intermediary1 from root to intermediary2 without resending it or its
+  // child.
+  int32_t new_root_children[] = {2};
+  root.child_count = 1;
+  root.children_in_traversal_order = new_root_children;
+
+  int32_t new_intermediary2_children[] = {1};
+  intermediary2.child_count = 1;
+  intermediary2.children_in_traversal_order = new_intermediary2_children;
+
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&intermediary2);
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto intermediary1_node =
+      bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto intermediary2_node =
+      bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  auto leaf1_node = bridge->GetFlutterPlatformNodeDelegateFromID(3).lock();
+  ASSERT_TRUE(intermediary1_node);
+  ASSERT_TRUE(leaf1_node);
+
+  EXPECT_EQ(root_node->GetChildCount(), 1);
+  EXPECT_EQ(root_node->GetData().child_ids[0], 2);
+  EXPECT_EQ(intermediary2_node->GetChildCount(), 1);
+  EXPECT_EQ(intermediary2_node->GetData().child_ids[0], 1);
+  EXPECT_EQ(intermediary1_node->GetChildCount(), 1);
+  EXPECT_EQ(intermediary1_node->GetData().child_ids[0], 3);
+  EXPECT_EQ(intermediary1_node->GetName(), "intermediary 1");
+  EXPECT_EQ(leaf1_node->GetName(), "leaf 1");
+}
+
+TEST(AccessibilityBridgeTest, CanReparentUnchangedNodeWithCustomAction) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> root_children{1, 2};
+  FlutterSemanticsNode root = CreateSemanticsNode(0, "root", &root_children);
+  FlutterSemanticsNode intermediary =
+      CreateSemanticsNode(1, "intermediary");
+  FlutterSemanticsNode leaf = CreateSemanticsNode(2, "leaf");
+  int32_t leaf_actions[] = {7};
+  leaf.actions = kFlutterSemanticsActionCustomAction;
+  leaf.custom_accessibility_actions_count = 1;
+  leaf.custom_accessibility_actions = leaf_actions;
+  FlutterSemanticsCustomAction action{
+      .struct_size = sizeof(FlutterSemanticsCustomAction),
+      .id = 7,
+      .label = "archive",
+      .hint = "",
+  };
+
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&intermediary);
+  bridge->AddFlutterSemanticsNodeUpdate(&leaf);
+  bridge->AddFlutterSemanticsCustomActionUpdate(&action);
+  bridge->CommitUpdates();
+
+  // Move the leaf under the intermediary without resending it or its action.
+  int32_t new_root_children[] = {1};
+  root.child_count = 1;
+  root.children_in_traversal_order = new_root_children;
+  int32_t new_intermediary_children[] = {2};
+  intermediary.child_count = 1;
+  intermediary.children_in_traversal_order = new_intermediary_children;
+
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&intermediary);
+  bridge->CommitUpdates();
+
+  auto intermediary_node =
+      bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto leaf_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  ASSERT_TRUE(leaf_node);
+  EXPECT_EQ(intermediary_node->GetChildCount(), 1);
+  EXPECT_EQ(intermediary_node->GetData().child_ids[0], 2);
+  EXPECT_EQ(leaf_node->GetData().GetIntListAttribute(
+                ax::mojom::IntListAttribute::kCustomActionIds),
+            std::vector<int32_t>{7});
+  EXPECT_EQ(leaf_node->GetData().GetStringListAttribute(
+                ax::mojom::StringListAttribute::kCustomActionDescriptions),
+            std::vector<std::string>{"archive"});
+}
+
 }  // namespace testing
 }  // namespace flutter
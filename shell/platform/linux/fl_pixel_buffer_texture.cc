@@ -7,10 +7,27 @@
 #include <epoxy/gl.h>
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
+// The number of pixel buffer objects uploads rotate through, so a buffer is
+// not written to while the GPU may still be reading from it.
+static constexpr int kPixelBufferObjectCount = 3;
+
 typedef struct {
   GLuint texture_id;
+
+  // Size of the texture storage.
+  uint32_t width;
+  uint32_t height;
+
+  // Pixel buffer objects used to stream uploads, if supported.
+  gboolean checked_pixel_buffer_support;
+  gboolean use_pixel_buffers;
+  GLuint pixel_buffers[kPixelBufferObjectCount];
+  GLsizeiptr pixel_buffer_sizes[kPixelBufferObjectCount];
+  int next_pixel_buffer;
 } FlPixelBufferTexturePrivate;
 
 // Added here to stop the compiler from optimising this function away.
@@ -36,6 +53,10 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     glDeleteTextures(1, &priv->texture_id);
     priv->texture_id = 0;
   }
+  if (priv->use_pixel_buffers) {
+    glDeleteBuffers(kPixelBufferObjectCount, priv->pixel_buffers);
+    priv->use_pixel_buffers = FALSE;
+  }
 
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
@@ -47,6 +68,64 @@ static void check_gl_error(int line) {
   }
 }
 
+// Checks if pixel buffer objects and buffer mapping are available. Both are
+// core in OpenGL 3.0 and OpenGL ES 3.0.
+static gboolean supports_pixel_buffers() {
+  return epoxy_gl_version() >= 30 ||
+         (epoxy_is_desktop_gl() &&
+          epoxy_has_gl_extension("GL_ARB_pixel_buffer_object") &&
+          epoxy_has_gl_extension("GL_ARB_map_buffer_range"));
+}
+
+// Copies a region of @buffer into the next pixel buffer object and uploads it
+// to the bound texture from there. The copy into a mapped buffer does not
+// wait for the GPU, and the upload from it happens asynchronously.
+// Returns %FALSE if the buffer could not be mapped.
+static gboolean upload_with_pixel_buffer(FlPixelBufferTexturePrivate* priv,
+                                         const uint8_t* buffer,
+                                         uint32_t stride,
+                                         uint32_t x,
+                                         uint32_t y,
+                                         uint32_t width,
+                                         uint32_t height) {
+  int index = priv->next_pixel_buffer;
+  priv->next_pixel_buffer = (index + 1) % kPixelBufferObjectCount;
+
+  GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, priv->pixel_buffers[index]);
+  if (priv->pixel_buffer_sizes[index] != size) {
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    priv->pixel_buffer_sizes[index] = size;
+  }
+
+  // Invalidating the buffer lets the driver hand out fresh memory if the
+  // previous contents are still being read.
+  uint8_t* data = static_cast<uint8_t*>(glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, 0, size,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  if (data == nullptr) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return FALSE;
+  }
+  size_t row_size = static_cast<size_t>(width) * 4;
+  size_t source_row_size = static_cast<size_t>(stride) * 4;
+  const uint8_t* source = buffer + (static_cast<size_t>(y) * stride + x) * 4;
+  for (size_t row = 0; row < height; row++) {
+    memcpy(data + row * row_size, source + row * source_row_size, row_size);
+  }
+  if (!glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+    // The contents were lost, e.g. due to a mode change.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return FALSE;
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA,
+                  GL_UNSIGNED_BYTE, nullptr);
+  check_gl_error(__LINE__);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  return TRUE;
+}
+
 gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
                                           uint32_t width,
                                           uint32_t height,
@@ -63,6 +142,16 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     return FALSE;
   }
 
+  if (!priv->checked_pixel_buffer_support) {
+    priv->checked_pixel_buffer_support = TRUE;
+    if (supports_pixel_buffers()) {
+      glGenBuffers(kPixelBufferObjectCount, priv->pixel_buffers);
+      check_gl_error(__LINE__);
+      priv->use_pixel_buffers = TRUE;
+    }
+  }
+
+  gboolean reallocate = FALSE;
   if (priv->texture_id == 0) {
     glGenTextures(1, &priv->texture_id);
     check_gl_error(__LINE__);
@@ -76,13 +165,49 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     check_gl_error(__LINE__);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     check_gl_error(__LINE__);
+    reallocate = TRUE;
   } else {
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
     check_gl_error(__LINE__);
+    reallocate = width != priv->width || height != priv->height;
+  }
+
+  // The storage is only reallocated when the size changes, after which the
+  // whole buffer is uploaded.
+  if (reallocate) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+    check_gl_error(__LINE__);
+    priv->width = width;
+    priv->height = height;
+  }
+
+  uint32_t region_x = 0, region_y = 0;
+  uint32_t region_width = width, region_height = height;
+  FlPixelBufferTextureClass* klass = FL_PIXEL_BUFFER_TEXTURE_GET_CLASS(self);
+  if (!reallocate && klass->get_dirty_region != nullptr &&
+      klass->get_dirty_region(self, &region_x, &region_y, &region_width,
+                              &region_height)) {
+    region_x = MIN(region_x, width);
+    region_y = MIN(region_y, height);
+    region_width = MIN(region_width, width - region_x);
+    region_height = MIN(region_height, height - region_y);
+  }
+
+  if (region_width > 0 && region_height > 0) {
+    if (!priv->use_pixel_buffers ||
+        !upload_with_pixel_buffer(priv, buffer, width, region_x, region_y,
+                                  region_width, region_height)) {
+      // Without pixel buffers whole rows are uploaded straight from the
+      // buffer, as selecting part of a row needs GL_UNPACK_ROW_LENGTH, which
+      // OpenGL ES 2.0 lacks.
+      glTexSubImage2D(
+          GL_TEXTURE_2D, 0, 0, region_y, width, region_height, GL_RGBA,
+          GL_UNSIGNED_BYTE,
+          buffer + static_cast<size_t>(region_y) * width * 4);
+      check_gl_error(__LINE__);
+    }
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
-  check_gl_error(__LINE__);
 
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
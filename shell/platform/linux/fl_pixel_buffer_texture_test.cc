@@ -8,6 +8,7 @@
 #include "flutter/shell/platform/linux/fl_texture_registrar_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "flutter/shell/platform/linux/testing/mock_epoxy.h"
 #include "gtest/gtest.h"
 
 #include <epoxy/gl.h>
@@ -26,6 +27,13 @@ G_DECLARE_FINAL_TYPE(FlTestPixelBufferTexture,
 /// A simple texture with fixed contents.
 struct _FlTestPixelBufferTexture {
   FlPixelBufferTexture parent_instance;
+
+  // Size of the buffer returned by copy_pixels.
+  uint32_t width;
+  uint32_t height;
+
+  // Number of times the dirty region was requested.
+  int dirty_region_count;
 };
 
 G_DEFINE_TYPE(FlTestPixelBufferTexture,
@@ -38,7 +46,7 @@ static gboolean fl_test_pixel_buffer_texture_copy_pixels(
     uint32_t* width,
     uint32_t* height,
     GError** error) {
-  EXPECT_TRUE(FL_IS_TEST_PIXEL_BUFFER_TEXTURE(texture));
+  FlTestPixelBufferTexture* self = FL_TEST_PIXEL_BUFFER_TEXTURE(texture);
 
   // RGBA
   static const uint8_t buffer[] = {0x0a, 0x1a, 0x2a, 0x3a, 0x4a, 0x5a,
@@ -47,9 +55,26 @@ static gboolean fl_test_pixel_buffer_texture_copy_pixels(
   EXPECT_EQ(*width, kBufferWidth);
   EXPECT_EQ(*height, kBufferHeight);
   *out_buffer = buffer;
+  *width = self->width;
+  *height = self->height;
+
+  return TRUE;
+}
+
+static gboolean fl_test_pixel_buffer_texture_get_dirty_region(
+    FlPixelBufferTexture* texture,
+    uint32_t* x,
+    uint32_t* y,
+    uint32_t* width,
+    uint32_t* height) {
+  FlTestPixelBufferTexture* self = FL_TEST_PIXEL_BUFFER_TEXTURE(texture);
+  self->dirty_region_count++;
+
+  // Deliberately extends past the buffer, which must be clamped.
+  *x = 1;
+  *y = 1;
   *width = kRealBufferWidth;
   *height = kRealBufferHeight;
-
   return TRUE;
 }
 
@@ -57,9 +82,14 @@ static void fl_test_pixel_buffer_texture_class_init(
     FlTestPixelBufferTextureClass* klass) {
   FL_PIXEL_BUFFER_TEXTURE_CLASS(klass)->copy_pixels =
       fl_test_pixel_buffer_texture_copy_pixels;
+  FL_PIXEL_BUFFER_TEXTURE_CLASS(klass)->get_dirty_region =
+      fl_test_pixel_buffer_texture_get_dirty_region;
 }
 
-static void fl_test_pixel_buffer_texture_init(FlTestPixelBufferTexture* self) {}
+static void fl_test_pixel_buffer_texture_init(FlTestPixelBufferTexture* self) {
+  self->width = kRealBufferWidth;
+  self->height = kRealBufferHeight;
+}
 
 static FlTestPixelBufferTexture* fl_test_pixel_buffer_texture_new() {
   return FL_TEST_PIXEL_BUFFER_TEXTURE(
@@ -86,3 +116,118 @@ TEST(FlPixelBufferTextureTest, PopulateTexture) {
   EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
   EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
 }
+
+// Test that only the first upload of an unchanged size ignores the dirty
+// region.
+TEST(FlPixelBufferTextureTest, PopulateTextureWithDirtyRegion) {
+  g_autoptr(FlTestPixelBufferTexture) texture =
+      fl_test_pixel_buffer_texture_new();
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(texture->dirty_region_count, 0);
+
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(texture->dirty_region_count, 1);
+  EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+}
+
+// Test that only the dirty region is uploaded, through a pixel buffer.
+TEST(FlPixelBufferTextureTest, UploadsDirtyRegionThroughPixelBuffer) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  g_autoptr(FlTestPixelBufferTexture) texture =
+      fl_test_pixel_buffer_texture_new();
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+
+  EXPECT_CALL(epoxy, glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kRealBufferWidth,
+                                  kRealBufferHeight, 0, GL_RGBA,
+                                  GL_UNSIGNED_BYTE, nullptr));
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kRealBufferWidth,
+                                     kRealBufferHeight, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, nullptr));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  ::testing::Mock::VerifyAndClearExpectations(&epoxy);
+
+  // The dirty region, clamped to the buffer, is copied into a pixel buffer of
+  // its size and uploaded from there.
+  EXPECT_CALL(epoxy, glTexImage2D).Times(0);
+  EXPECT_CALL(epoxy, glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, 4,
+                                      ::testing::_));
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 1, 1, 1, 1, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, nullptr));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+}
+
+// Test that a change of the buffer size reallocates the texture and uploads
+// the whole buffer.
+TEST(FlPixelBufferTextureTest, SizeChangeReallocatesTexture) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  g_autoptr(FlTestPixelBufferTexture) texture =
+      fl_test_pixel_buffer_texture_new();
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+
+  EXPECT_CALL(epoxy, glTexImage2D).Times(1);
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  ::testing::Mock::VerifyAndClearExpectations(&epoxy);
+
+  texture->width = 1;
+  EXPECT_CALL(epoxy, glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1,
+                                  kRealBufferHeight, 0, GL_RGBA,
+                                  GL_UNSIGNED_BYTE, nullptr));
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1,
+                                     kRealBufferHeight, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, nullptr));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.width, 1u);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+}
+
+// Test that without pixel buffer support whole rows of the dirty region are
+// uploaded straight from the buffer.
+TEST(FlPixelBufferTextureTest, UploadsDirectlyWithoutPixelBuffers) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  ON_CALL(epoxy, epoxy_gl_version()).WillByDefault(::testing::Return(20));
+  g_autoptr(FlTestPixelBufferTexture) texture =
+      fl_test_pixel_buffer_texture_new();
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+
+  EXPECT_CALL(epoxy, glMapBufferRange).Times(0);
+  EXPECT_CALL(epoxy, glTexImage2D).Times(1);
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kRealBufferWidth,
+                                     kRealBufferHeight, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, ::testing::NotNull()));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 1, kRealBufferWidth,
+                                     1, GL_RGBA, GL_UNSIGNED_BYTE,
+                                     ::testing::NotNull()));
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      FL_PIXEL_BUFFER_TEXTURE(texture), kBufferWidth, kBufferHeight,
+      &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+}
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -28,6 +29,11 @@ static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 static constexpr int kValueFloat32List = 14;
 
+// Typed lists of at least this many bytes reference the decoded message
+// instead of being copied out of it. Smaller lists are copied so they do not
+// keep large messages alive.
+static constexpr size_t kMinTypedListViewSize = 1024;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
 };
@@ -111,6 +117,37 @@ static const uint8_t* get_data(GBytes* buffer, size_t* offset) {
          *offset;
 }
 
+// Creates a typed list of @length elements at @offset in @buffer, referencing
+// the buffer if the list is large.
+static FlValue* new_typed_list(FlValueType type,
+                               GBytes* buffer,
+                               size_t offset,
+                               size_t length,
+                               size_t element_size) {
+  if (length * element_size >= kMinTypedListViewSize) {
+    return fl_value_new_typed_list_view(type, buffer, offset, length);
+  }
+  const uint8_t* data = get_data(buffer, &offset);
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return fl_value_new_uint8_list(data, length);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return fl_value_new_int32_list(reinterpret_cast<const int32_t*>(data),
+                                     length);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return fl_value_new_int64_list(reinterpret_cast<const int64_t*>(data),
+                                     length);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return fl_value_new_float32_list(reinterpret_cast<const float*>(data),
+                                       length);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return fl_value_new_float_list(reinterpret_cast<const double*>(data),
+                                     length);
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
 // Reads an unsigned 8 bit number from @buffer and writes it to @value.
 // Returns TRUE if successful, otherwise sets an error.
 static gboolean read_uint8(GBytes* buffer,
@@ -243,7 +280,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value = new_typed_list(FL_VALUE_TYPE_UINT8_LIST, buffer, *offset,
+                                  length, sizeof(uint8_t));
   *offset += length;
   return value;
 }
@@ -266,8 +304,8 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = new_typed_list(FL_VALUE_TYPE_INT32_LIST, buffer, *offset,
+                                  length, sizeof(int32_t));
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -290,8 +328,8 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = new_typed_list(FL_VALUE_TYPE_INT64_LIST, buffer, *offset,
+                                  length, sizeof(int64_t));
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -314,8 +352,8 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
+  FlValue* value = new_typed_list(FL_VALUE_TYPE_FLOAT32_LIST, buffer, *offset,
+                                  length, sizeof(float));
   *offset += sizeof(float) * length;
   return value;
 }
@@ -338,8 +376,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = new_typed_list(FL_VALUE_TYPE_FLOAT_LIST, buffer, *offset,
+                                  length, sizeof(double));
   *offset += sizeof(double) * length;
   return value;
 }
@@ -383,7 +421,10 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  // The length is not trusted to size the map, as reading the entries will
+  // fail long before a bogus length is reached.
+  g_autoptr(FlValue) map =
+      fl_value_new_map_sized(MIN(length, g_bytes_get_size(buffer) - *offset));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -401,6 +442,79 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
   return fl_value_ref(map);
 }
 
+// Gets the number of bytes fl_standard_message_codec_write_size() writes.
+static size_t get_size_size(uint32_t size) {
+  if (size < 254) {
+    return sizeof(uint8_t);
+  } else if (size <= 0xffff) {
+    return sizeof(uint8_t) + sizeof(uint16_t);
+  } else {
+    return sizeof(uint8_t) + sizeof(uint32_t);
+  }
+}
+
+// Gets @offset rounded up to a multiple of @align.
+static size_t get_aligned(size_t offset, size_t align) {
+  return offset + (align - offset % align) % align;
+}
+
+// See fl_standard_message_codec_get_encoded_end().
+static size_t get_encoded_end(FlValue* value, size_t offset) {
+  // Type byte.
+  offset += sizeof(uint8_t);
+  if (value == nullptr) {
+    return offset;
+  }
+
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+    case FL_VALUE_TYPE_BOOL:
+      return offset;
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return offset + (v >= INT32_MIN && v <= INT32_MAX ? sizeof(int32_t)
+                                                        : sizeof(int64_t));
+    }
+    case FL_VALUE_TYPE_FLOAT:
+      return get_aligned(offset, 8) + sizeof(double);
+    case FL_VALUE_TYPE_STRING: {
+      size_t length = strlen(fl_value_get_string(value));
+      return offset + get_size_size(length) + length;
+    }
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      size_t length = fl_value_get_length(value);
+      return offset + get_size_size(length) + sizeof(uint8_t) * length;
+    }
+    case FL_VALUE_TYPE_INT32_LIST:
+    case FL_VALUE_TYPE_FLOAT32_LIST: {
+      size_t length = fl_value_get_length(value);
+      return get_aligned(offset + get_size_size(length), 4) +
+             sizeof(int32_t) * length;
+    }
+    case FL_VALUE_TYPE_INT64_LIST:
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      size_t length = fl_value_get_length(value);
+      return get_aligned(offset + get_size_size(length), 8) +
+             sizeof(int64_t) * length;
+    }
+    case FL_VALUE_TYPE_LIST:
+      offset += get_size_size(fl_value_get_length(value));
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        offset = get_encoded_end(fl_value_get_list_value(value, i), offset);
+      }
+      return offset;
+    case FL_VALUE_TYPE_MAP:
+      offset += get_size_size(fl_value_get_length(value));
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        offset = get_encoded_end(fl_value_get_map_key(value, i), offset);
+        offset = get_encoded_end(fl_value_get_map_value(value, i), offset);
+      }
+      return offset;
+  }
+
+  return offset;
+}
+
 // Implements FlMessageCodec::encode_message.
 static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
                                                         FlValue* message,
@@ -408,7 +522,10 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  // Sizing the buffer first avoids reallocating it as values are added, which
+  // for large typed lists would copy the data several times.
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_encoded_end(self, 0, message));
   if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
     return nullptr;
   }
@@ -497,6 +614,13 @@ gboolean fl_standard_message_codec_read_size(FlStandardMessageCodec* codec,
   return TRUE;
 }
 
+size_t fl_standard_message_codec_get_encoded_end(
+    FlStandardMessageCodec* codec,
+    size_t offset,
+    FlValue* value) {
+  return get_encoded_end(value, offset);
+}
+
 gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* self,
                                                GByteArray* buffer,
                                                FlValue* value,
@@ -57,6 +57,22 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
                                                FlValue* value,
                                                GError** error);
 
+/**
+ * fl_standard_message_codec_get_encoded_end:
+ * @codec: an #FlStandardMessageCodec.
+ * @offset: the offset in the buffer @value would be written at.
+ * @value: (allow-none): value to measure.
+ *
+ * Calculates where fl_standard_message_codec_write_value() would finish
+ * writing @value, taking alignment into account. Used to allocate encoding
+ * buffers of the right size up front.
+ *
+ * Returns: the offset after the encoded value.
+ */
+size_t fl_standard_message_codec_get_encoded_end(FlStandardMessageCodec* codec,
+                                                 size_t offset,
+                                                 FlValue* value);
+
 /**
  * fl_standard_message_codec_read_value:
  * @codec: an #FlStandardMessageCodec.
@@ -6,6 +6,8 @@
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "gtest/gtest.h"
 
+#include <vector>
+
 // NOTE(robert-ancell) These test cases assumes a little-endian architecture.
 // These tests will need to be updated if tested on a big endian architecture.
 
@@ -777,6 +779,48 @@ TEST(FlStandardMessageCodecTest, EncodeDecodeLargeList) {
   ASSERT_TRUE(fl_value_equal(value, decoded_value));
 }
 
+TEST(FlStandardMessageCodecTest, EncodeDecodeLargeTypedLists) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  std::vector<double> doubles(4096);
+  std::vector<uint8_t> bytes(4096);
+  for (size_t i = 0; i < doubles.size(); i++) {
+    doubles[i] = i * 0.5;
+    bytes[i] = i % 256;
+  }
+  g_autoptr(FlValue) value = fl_value_new_list();
+  fl_value_append_take(value, fl_value_new_bool(TRUE));
+  fl_value_append_take(value,
+                       fl_value_new_float_list(doubles.data(), doubles.size()));
+  fl_value_append_take(value,
+                       fl_value_new_uint8_list(bytes.data(), bytes.size()));
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  EXPECT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  g_autoptr(FlValue) decoded_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(decoded_value, nullptr);
+  ASSERT_TRUE(fl_value_equal(value, decoded_value));
+
+  // Large lists reference the message rather than copying it.
+  gsize message_size;
+  const uint8_t* message_data =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, &message_size));
+  const uint8_t* list_data =
+      fl_value_get_uint8_list(fl_value_get_list_value(decoded_value, 2));
+  EXPECT_GE(list_data, message_data);
+  EXPECT_LT(list_data, message_data + message_size);
+
+  // The lists remain valid after the message is released.
+  g_clear_pointer(&message, g_bytes_unref);
+  ASSERT_TRUE(fl_value_equal(value, decoded_value));
+}
+
 TEST(FlStandardMessageCodecTest, EncodeMapEmpty) {
   g_autoptr(FlValue) value = fl_value_new_map();
   g_autofree gchar* hex_string = encode_message(value);
@@ -41,8 +41,11 @@ static GBytes* fl_standard_method_codec_encode_method_call(FlMethodCodec* codec,
                                                            GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
   g_autoptr(FlValue) name_value = fl_value_new_string(name);
+  size_t size =
+      fl_standard_message_codec_get_encoded_end(self->codec, 0, name_value);
+  size = fl_standard_message_codec_get_encoded_end(self->codec, size, args);
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(size);
   if (!fl_standard_message_codec_write_value(self->codec, buffer, name_value,
                                              error)) {
     return nullptr;
@@ -102,7 +105,8 @@ static GBytes* fl_standard_method_codec_encode_success_envelope(
     GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_encoded_end(self->codec, 1, result));
   guint8 type = kEnvelopeTypeSuccess;
   g_byte_array_append(buffer, &type, 1);
   if (!fl_standard_message_codec_write_value(self->codec, buffer, result,
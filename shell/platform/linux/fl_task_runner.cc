@@ -5,9 +5,27 @@
 #include "flutter/shell/platform/linux/fl_task_runner.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 
+#include <glib-unix.h>
+#include <unistd.h>
+
+#include "flutter/fml/platform/linux/timerfd.h"
+
 static constexpr int kMicrosecondsPerNanosecond = 1000;
 static constexpr int kMillisecondsPerMicrosecond = 1000;
 
+// Tasks due within this long of the current time are run along with expired
+// tasks, rather than waking up again moments later.
+static constexpr gint64 kCoalescingWindowNanos = 50 * 1000;
+
+// A source that dispatches when a timerfd expires. Unlike g_timeout_add(),
+// which rounds up to whole milliseconds, this wakes up at the requested time
+// in nanoseconds.
+typedef struct {
+  GSource parent;
+  int timer_fd;
+  gpointer timer_fd_tag;
+} FlTimerSource;
+
 struct _FlTaskRunner {
   GObject parent_instance;
 
@@ -16,30 +34,92 @@ struct _FlTaskRunner {
   GMutex mutex;
   GCond cond;
 
+  // Used to wake up for the next task. If a timerfd can not be created tasks
+  // are scheduled with g_timeout_add() instead.
+  FlTimerSource* timer_source;
   guint timeout_source_id;
   GList /*<FlTaskRunnerTask>*/* pending_tasks;
   gboolean blocking_main_thread;
 };
 
 typedef struct _FlTaskRunnerTask {
-  // absolute time of task (based on g_get_monotonic_time)
-  gint64 task_time_micros;
+  // absolute time of task (based on CLOCK_MONOTONIC, as g_get_monotonic_time)
+  gint64 task_time_nanos;
   FlutterTask task;
 } FlTaskRunnerTask;
 
 G_DEFINE_TYPE(FlTaskRunner, fl_task_runner, G_TYPE_OBJECT)
 
+static gboolean fl_timer_source_dispatch(GSource* source,
+                                         GSourceFunc callback,
+                                         gpointer user_data) {
+  FlTimerSource* self = reinterpret_cast<FlTimerSource*>(source);
+  fml::TimerDrain(self->timer_fd);
+  return callback(user_data);
+}
+
+static void fl_timer_source_finalize(GSource* source) {
+  FlTimerSource* self = reinterpret_cast<FlTimerSource*>(source);
+  close(self->timer_fd);
+}
+
+static GSourceFuncs fl_timer_source_funcs = {
+    nullptr,  // prepare
+    nullptr,  // check
+    fl_timer_source_dispatch,
+    fl_timer_source_finalize,
+};
+
+// Creates a timer source attached to the default main context, or returns
+// %NULL if a timerfd can not be created.
+static FlTimerSource* fl_timer_source_new(GSourceFunc callback,
+                                          gpointer user_data) {
+  int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd < 0) {
+    g_warning("Failed to create timerfd, falling back to g_timeout_add");
+    return nullptr;
+  }
+
+  FlTimerSource* self = reinterpret_cast<FlTimerSource*>(
+      g_source_new(&fl_timer_source_funcs, sizeof(FlTimerSource)));
+  self->timer_fd = timer_fd;
+  self->timer_fd_tag = g_source_add_unix_fd(&self->parent, timer_fd, G_IO_IN);
+  g_source_set_callback(&self->parent, callback, user_data, nullptr);
+  g_source_attach(&self->parent, nullptr);
+  return self;
+}
+
+// Arms the timer to expire at @time_nanos, or disarms it if @time_nanos is
+// G_MAXINT64.
+static void fl_timer_source_set_expiration_time(FlTimerSource* self,
+                                                gint64 time_nanos) {
+  if (time_nanos == G_MAXINT64) {
+    struct itimerspec spec = {};
+    timerfd_settime(self->timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    return;
+  }
+  fml::TimerRearm(self->timer_fd,
+                  fml::TimePoint::FromEpochDelta(
+                      fml::TimeDelta::FromNanoseconds(time_nanos)));
+}
+
+static void fl_timer_source_destroy(FlTimerSource* self) {
+  g_source_destroy(&self->parent);
+  g_source_unref(&self->parent);
+}
+
 // Removes expired tasks from the task queue and executes them.
 // The execution is performed with mutex unlocked.
 static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
   GList* expired_tasks = nullptr;
 
-  gint64 current_time = g_get_monotonic_time();
+  gint64 current_time = g_get_monotonic_time() * kMicrosecondsPerNanosecond;
+  gint64 expiration_time = current_time + kCoalescingWindowNanos;
 
   GList* l = self->pending_tasks;
   while (l != nullptr) {
     FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    if (task->task_time_micros <= current_time) {
+    if (task->task_time_nanos <= expiration_time) {
       GList* link = l;
       l = l->next;
       self->pending_tasks = g_list_remove_link(self->pending_tasks, link);
@@ -65,7 +145,7 @@ static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
 
 static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self);
 
-// Invoked from a timeout source. Removes and executes expired tasks
+// Invoked from the timer or timeout source. Removes and executes expired tasks
 // and reschedules timeout if needed.
 static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
   FlTaskRunner* self = FL_TASK_RUNNER(data);
@@ -81,20 +161,24 @@ static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
   // reschedule timeout
   fl_task_runner_tasks_did_change_locked(self);
 
+  // The timer source stays attached and is rearmed as needed.
+  gboolean result =
+      self->timer_source != nullptr ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+
   g_object_unref(self);
 
-  return FALSE;
+  return result;
 }
 
-// Returns the absolute time of next expired task (in microseconds, based on
-// g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
+// Returns the absolute time of next expired task (in nanoseconds, based on
+// CLOCK_MONOTONIC). If no task is scheduled returns G_MAXINT64.
 static gint64 fl_task_runner_next_task_expiration_time_locked(
     FlTaskRunner* self) {
   gint64 min_time = G_MAXINT64;
   GList* l = self->pending_tasks;
   while (l != nullptr) {
     FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    min_time = MIN(min_time, task->task_time_micros);
+    min_time = MIN(min_time, task->task_time_nanos);
     l = l->next;
   }
   return min_time;
@@ -104,6 +188,11 @@ static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
   if (self->blocking_main_thread) {
     // Wake up blocked thread
     g_cond_signal(&self->cond);
+  } else if (self->timer_source != nullptr) {
+    // Rearm the timer, which is thread safe.
+    fl_timer_source_set_expiration_time(
+        self->timer_source,
+        fl_task_runner_next_task_expiration_time_locked(self));
   } else {
     // Reschedule timeout
     if (self->timeout_source_id != 0) {
@@ -112,7 +201,8 @@ static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
     }
     gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
     if (min_time != G_MAXINT64) {
-      gint64 remaining = MAX(min_time - g_get_monotonic_time(), 0);
+      gint64 remaining = MAX(
+          min_time / kMicrosecondsPerNanosecond - g_get_monotonic_time(), 0);
       self->timeout_source_id =
           g_timeout_add(remaining / kMillisecondsPerMicrosecond + 1,
                         fl_task_runner_on_expired_timeout, self);
@@ -142,6 +232,10 @@ void fl_task_runner_dispose(GObject* object) {
   g_cond_clear(&self->cond);
 
   g_list_free_full(self->pending_tasks, g_free);
+  if (self->timer_source != nullptr) {
+    fl_timer_source_destroy(self->timer_source);
+    self->timer_source = nullptr;
+  }
   if (self->timeout_source_id != 0) {
     g_source_remove(self->timeout_source_id);
   }
@@ -156,6 +250,8 @@ static void fl_task_runner_class_init(FlTaskRunnerClass* klass) {
 static void fl_task_runner_init(FlTaskRunner* self) {
   g_mutex_init(&self->mutex);
   g_cond_init(&self->cond);
+  self->timer_source =
+      fl_timer_source_new(fl_task_runner_on_expired_timeout, self);
 }
 
 FlTaskRunner* fl_task_runner_new(FlEngine* engine) {
@@ -174,8 +270,7 @@ void fl_task_runner_post_task(FlTaskRunner* self,
 
   FlTaskRunnerTask* runner_task = g_new0(FlTaskRunnerTask, 1);
   runner_task->task = task;
-  runner_task->task_time_micros =
-      target_time_nanos / kMicrosecondsPerNanosecond;
+  runner_task->task_time_nanos = target_time_nanos;
 
   self->pending_tasks = g_list_append(self->pending_tasks, runner_task);
   fl_task_runner_tasks_did_change_locked(self);
@@ -191,8 +286,11 @@ void fl_task_runner_block_main_thread(FlTaskRunner* self) {
 
   self->blocking_main_thread = true;
   while (self->blocking_main_thread) {
+    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
     g_cond_wait_until(&self->cond, &self->mutex,
-                      fl_task_runner_next_task_expiration_time_locked(self));
+                      min_time == G_MAXINT64
+                          ? G_MAXINT64
+                          : min_time / kMicrosecondsPerNanosecond);
     fl_task_runner_process_expired_tasks_locked(self);
   }
 
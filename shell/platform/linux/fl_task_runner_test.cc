@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Included first as it collides with the X11 headers.
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <time.h>
+
+#include <thread>
+#include <vector>
+
+#include "flutter/shell/platform/embedder/test_utils/proc_table_replacement.h"
+#include "flutter/shell/platform/linux/fl_engine_private.h"
+#include "flutter/shell/platform/linux/fl_task_runner.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+
+// MOCK_ENGINE_PROC is leaky by design
+// NOLINTBEGIN(clang-analyzer-core.StackAddressEscape)
+
+namespace {
+
+constexpr int64_t kNanosecondsPerMillisecond = 1000000;
+
+// Tasks that were run, in the order they were run in.
+struct RunTasks {
+  std::vector<uint64_t> ids;
+  std::vector<int64_t> times_nanos;
+  GMainLoop* loop = nullptr;
+  size_t quit_after = 0;
+};
+
+// Returns the current time on the clock task target times are based on.
+int64_t now_nanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+FlutterTask make_task(uint64_t id) {
+  FlutterTask task = {};
+  task.task = id;
+  return task;
+}
+
+// Makes @engine record the tasks it runs, quitting the loop in @run_tasks
+// once enough have run.
+void record_tasks(FlEngine* engine, RunTasks* run_tasks) {
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+  embedder_api->RunTask = MOCK_ENGINE_PROC(
+      RunTask, ([run_tasks](auto engine, const FlutterTask* task) {
+        run_tasks->ids.push_back(task->task);
+        run_tasks->times_nanos.push_back(now_nanos());
+        if (run_tasks->loop != nullptr &&
+            run_tasks->ids.size() >= run_tasks->quit_after) {
+          g_main_loop_quit(run_tasks->loop);
+        }
+        return kSuccess;
+      }));
+}
+
+// Runs the main loop until @count tasks in total have been run.
+void run_until(RunTasks* run_tasks, size_t count) {
+  g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, 0);
+  run_tasks->loop = loop;
+  run_tasks->quit_after = count;
+  g_main_loop_run(loop);
+  run_tasks->loop = nullptr;
+}
+
+}  // namespace
+
+// Checks a delayed task is not run before its target time.
+TEST(FlTaskRunnerTest, DelayedTaskRunsNoEarlierThanItsTime) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  RunTasks run_tasks;
+  record_tasks(engine, &run_tasks);
+  g_autoptr(FlTaskRunner) runner = fl_task_runner_new(engine);
+
+  int64_t target_time = now_nanos() + 20 * kNanosecondsPerMillisecond;
+  fl_task_runner_post_task(runner, make_task(1), target_time);
+  run_until(&run_tasks, 1);
+
+  EXPECT_THAT(run_tasks.ids, ::testing::ElementsAre(1u));
+  EXPECT_GE(run_tasks.times_nanos[0], target_time);
+}
+
+// Checks posting a task due earlier than a pending one rearms the timer for
+// the earlier task.
+TEST(FlTaskRunnerTest, EarlierTaskRearmsTheTimer) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  RunTasks run_tasks;
+  record_tasks(engine, &run_tasks);
+  g_autoptr(FlTaskRunner) runner = fl_task_runner_new(engine);
+
+  int64_t start_time = now_nanos();
+  int64_t later_time = start_time + 200 * kNanosecondsPerMillisecond;
+  int64_t earlier_time = start_time + 10 * kNanosecondsPerMillisecond;
+  fl_task_runner_post_task(runner, make_task(1), later_time);
+  fl_task_runner_post_task(runner, make_task(2), earlier_time);
+
+  run_until(&run_tasks, 1);
+  EXPECT_THAT(run_tasks.ids, ::testing::ElementsAre(2u));
+  EXPECT_GE(run_tasks.times_nanos[0], earlier_time);
+  EXPECT_LT(run_tasks.times_nanos[0], later_time);
+
+  // The later task still runs once it is due.
+  run_until(&run_tasks, 2);
+  EXPECT_THAT(run_tasks.ids, ::testing::ElementsAre(2u, 1u));
+  EXPECT_GE(run_tasks.times_nanos[1], later_time);
+}
+
+// Checks tasks posted before and while the main thread is blocked are run, and
+// that the timer is rearmed for the ones still pending once it is released.
+TEST(FlTaskRunnerTest, BlockingTheMainThreadDoesNotDropTasks) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  RunTasks run_tasks;
+  record_tasks(engine, &run_tasks);
+  g_autoptr(FlTaskRunner) runner = fl_task_runner_new(engine);
+
+  int64_t start_time = now_nanos();
+  fl_task_runner_post_task(runner, make_task(1),
+                           start_time + 100 * kNanosecondsPerMillisecond);
+  fl_task_runner_post_task(runner, make_task(3),
+                           start_time + 200 * kNanosecondsPerMillisecond);
+
+  // The main thread is released once task 1 and the task posted meanwhile
+  // have run.
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+  auto record = embedder_api->RunTask;
+  embedder_api->RunTask = MOCK_ENGINE_PROC(
+      RunTask,
+      ([record, runner, &run_tasks](auto engine, const FlutterTask* task) {
+        FlutterEngineResult result = record(engine, task);
+        if (run_tasks.ids.size() == 2) {
+          fl_task_runner_release_main_thread(runner);
+        }
+        return result;
+      }));
+
+  std::thread poster([runner]() {
+    fl_task_runner_post_task(runner, make_task(2), now_nanos());
+  });
+  fl_task_runner_block_main_thread(runner);
+  poster.join();
+  EXPECT_THAT(run_tasks.ids, ::testing::ElementsAre(2u, 1u));
+
+  run_until(&run_tasks, 3);
+  EXPECT_THAT(run_tasks.ids, ::testing::ElementsAre(2u, 1u, 3u));
+}
+
+// NOLINTEND(clang-analyzer-core.StackAddressEscape)
@@ -3,9 +3,11 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
+#include <cstdint>
 #include <cstring>
 
 struct _FlValue {
@@ -33,34 +35,41 @@ typedef struct {
   gchar* value;
 } FlValueString;
 
+// Typed lists either own their values, or reference the data of the GBytes in
+// owner.
 typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  GBytes* owner;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  GBytes* owner;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  GBytes* owner;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  GBytes* owner;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  GBytes* owner;
 } FlValueFloatList;
 
 typedef struct {
@@ -72,8 +81,14 @@ typedef struct {
   FlValue parent;
   GPtrArray* keys;
   GPtrArray* values;
+  // Maps keys to their index plus one. Only created once the map holds
+  // kMapIndexThreshold entries, as scanning small maps is cheaper.
+  GHashTable* index;
 } FlValueMap;
 
+// The number of entries at which a map starts indexing its keys.
+static constexpr guint kMapIndexThreshold = 8;
+
 static FlValue* fl_value_new(FlValueType type, size_t size) {
   FlValue* self = static_cast<FlValue*>(g_malloc0(size));
   self->type = type;
@@ -86,12 +101,47 @@ static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
 }
 
+// Frees the values of a typed list.
+static void free_list_values(gpointer values, GBytes* owner) {
+  if (owner != nullptr) {
+    g_bytes_unref(owner);
+  } else {
+    g_free(values);
+  }
+}
+
+// Helper functions to match GHashFunc and GEqualFunc types.
+static guint fl_value_key_hash(gconstpointer key) {
+  return fl_value_hash(static_cast<FlValue*>(const_cast<gpointer>(key)));
+}
+
+static gboolean fl_value_key_equal(gconstpointer a, gconstpointer b) {
+  return fl_value_equal(static_cast<FlValue*>(const_cast<gpointer>(a)),
+                        static_cast<FlValue*>(const_cast<gpointer>(b)));
+}
+
+// Indexes the keys of a FlValueMap.
+static void fl_value_map_build_index(FlValueMap* self) {
+  self->index = g_hash_table_new(fl_value_key_hash, fl_value_key_equal);
+  for (guint i = 0; i < self->keys->len; i++) {
+    g_hash_table_insert(self->index, g_ptr_array_index(self->keys, i),
+                        GSIZE_TO_POINTER(i + 1));
+  }
+}
+
 // Finds the index of a key in a FlValueMap.
-// FIXME(robert-ancell) This is highly inefficient, and should be optimized if
-// necessary.
 static ssize_t fl_value_lookup_index(FlValue* self, FlValue* key) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_MAP, -1);
 
+  FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+  if (v->index == nullptr && v->keys->len >= kMapIndexThreshold) {
+    fl_value_map_build_index(v);
+  }
+  if (v->index != nullptr) {
+    gpointer index = g_hash_table_lookup(v->index, key);
+    return index == nullptr ? -1 : GPOINTER_TO_SIZE(index) - 1;
+  }
+
   for (size_t i = 0; i < fl_value_get_length(self); i++) {
     FlValue* k = fl_value_get_map_key(self, i);
     if (fl_value_equal(k, key)) {
@@ -101,6 +151,24 @@ static ssize_t fl_value_lookup_index(FlValue* self, FlValue* key) {
   return -1;
 }
 
+// Mixes a value into a hash.
+static guint hash_combine(guint hash, guint64 value) {
+  hash ^= static_cast<guint>(value ^ (value >> 32)) + 0x9e3779b9 + (hash << 6) +
+          (hash >> 2);
+  return hash;
+}
+
+// Hashes a floating point number consistently with the == used by
+// fl_value_equal(), under which 0.0 and -0.0 are equal.
+static guint64 float_hash_value(double value) {
+  if (value == 0.0) {
+    return 0;
+  }
+  guint64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
 // Converts an integer to a string and adds it to the buffer.
 static void int_to_string(int64_t value, GString* buffer) {
   g_string_append_printf(buffer, "%" G_GINT64_FORMAT, value);
@@ -335,6 +403,96 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+FlValue* fl_value_new_typed_list_view(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t length) {
+  g_return_val_if_fail(bytes != nullptr, nullptr);
+
+  size_t element_size;
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      element_size = sizeof(uint8_t);
+      break;
+    case FL_VALUE_TYPE_INT32_LIST:
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      element_size = sizeof(int32_t);
+      break;
+    case FL_VALUE_TYPE_INT64_LIST:
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      element_size = sizeof(int64_t);
+      break;
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+  g_return_val_if_fail(
+      offset + element_size * length <= g_bytes_get_size(bytes), nullptr);
+
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) + offset;
+  bool aligned = reinterpret_cast<uintptr_t>(data) % element_size == 0;
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+          fl_value_new(type, sizeof(FlValueUint8List)));
+      self->values = const_cast<uint8_t*>(data);
+      self->values_length = length;
+      self->owner = g_bytes_ref(bytes);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      if (!aligned) {
+        return fl_value_new_int32_list(
+            reinterpret_cast<const int32_t*>(data), length);
+      }
+      FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
+          fl_value_new(type, sizeof(FlValueInt32List)));
+      self->values = reinterpret_cast<int32_t*>(const_cast<uint8_t*>(data));
+      self->values_length = length;
+      self->owner = g_bytes_ref(bytes);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      if (!aligned) {
+        return fl_value_new_int64_list(
+            reinterpret_cast<const int64_t*>(data), length);
+      }
+      FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
+          fl_value_new(type, sizeof(FlValueInt64List)));
+      self->values = reinterpret_cast<int64_t*>(const_cast<uint8_t*>(data));
+      self->values_length = length;
+      self->owner = g_bytes_ref(bytes);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_FLOAT32_LIST: {
+      if (!aligned) {
+        return fl_value_new_float32_list(reinterpret_cast<const float*>(data),
+                                         length);
+      }
+      FlValueFloat32List* self = reinterpret_cast<FlValueFloat32List*>(
+          fl_value_new(type, sizeof(FlValueFloat32List)));
+      self->values = reinterpret_cast<float*>(const_cast<uint8_t*>(data));
+      self->values_length = length;
+      self->owner = g_bytes_ref(bytes);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      if (!aligned) {
+        return fl_value_new_float_list(reinterpret_cast<const double*>(data),
+                                       length);
+      }
+      FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+          fl_value_new(type, sizeof(FlValueFloatList)));
+      self->values = reinterpret_cast<double*>(const_cast<uint8_t*>(data));
+      self->values_length = length;
+      self->owner = g_bytes_ref(bytes);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
@@ -353,10 +511,17 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
+  return fl_value_new_map_sized(0);
+}
+
+FlValue* fl_value_new_map_sized(guint length) {
   FlValueMap* self = reinterpret_cast<FlValueMap*>(
       fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->keys = g_ptr_array_new_full(length, fl_value_destroy);
+  self->values = g_ptr_array_new_full(length, fl_value_destroy);
+  if (length >= kMapIndexThreshold) {
+    fl_value_map_build_index(self);
+  }
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -382,27 +547,27 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->owner);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->owner);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->owner);
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->owner);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->owner);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -412,6 +577,9 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_MAP: {
       FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+      if (v->index != nullptr) {
+        g_hash_table_unref(v->index);
+      }
       g_ptr_array_unref(v->keys);
       g_ptr_array_unref(v->values);
       break;
@@ -549,6 +717,80 @@ G_MODULE_EXPORT bool fl_value_equal(FlValue* a, FlValue* b) {
   }
 }
 
+G_MODULE_EXPORT guint fl_value_hash(FlValue* value) {
+  g_return_val_if_fail(value != nullptr, 0);
+
+  guint hash = hash_combine(0, value->type);
+  switch (value->type) {
+    case FL_VALUE_TYPE_NULL:
+      return hash;
+    case FL_VALUE_TYPE_BOOL:
+      return hash_combine(hash, fl_value_get_bool(value) ? 1 : 0);
+    case FL_VALUE_TYPE_INT:
+      return hash_combine(hash, fl_value_get_int(value));
+    case FL_VALUE_TYPE_FLOAT:
+      return hash_combine(hash, float_hash_value(fl_value_get_float(value)));
+    case FL_VALUE_TYPE_STRING:
+      return hash_combine(hash, g_str_hash(fl_value_get_string(value)));
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      const uint8_t* values = fl_value_get_uint8_list(value);
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash, values[i]);
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      const int32_t* values = fl_value_get_int32_list(value);
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash, values[i]);
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      const int64_t* values = fl_value_get_int64_list(value);
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash, values[i]);
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_FLOAT32_LIST: {
+      const float* values = fl_value_get_float32_list(value);
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash, float_hash_value(values[i]));
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      const double* values = fl_value_get_float_list(value);
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash, float_hash_value(values[i]));
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_LIST: {
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        hash = hash_combine(hash,
+                            fl_value_hash(fl_value_get_list_value(value, i)));
+      }
+      return hash;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      // Entries are summed so that the order does not matter, matching
+      // fl_value_equal().
+      guint entries_hash = 0;
+      for (size_t i = 0; i < fl_value_get_length(value); i++) {
+        guint entry_hash =
+            hash_combine(fl_value_hash(fl_value_get_map_key(value, i)),
+                         fl_value_hash(fl_value_get_map_value(value, i)));
+        entries_hash += entry_hash;
+      }
+      return hash_combine(hash, entries_hash);
+    }
+  }
+
+  return hash;
+}
+
 G_MODULE_EXPORT void fl_value_append(FlValue* self, FlValue* value) {
   g_return_if_fail(self != nullptr);
   g_return_if_fail(self->type == FL_VALUE_TYPE_LIST);
@@ -588,7 +830,14 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   if (index < 0) {
     g_ptr_array_add(v->keys, key);
     g_ptr_array_add(v->values, value);
+    if (v->index != nullptr) {
+      g_hash_table_insert(v->index, key, GSIZE_TO_POINTER(v->keys->len));
+    }
   } else {
+    // Update the index first, as it compares against the old key.
+    if (v->index != nullptr) {
+      g_hash_table_replace(v->index, key, GSIZE_TO_POINTER(index + 1));
+    }
     fl_value_destroy(v->keys->pdata[index]);
     v->keys->pdata[index] = key;
     fl_value_destroy(v->values->pdata[index]);
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_map_sized:
+ * @length: the number of entries that are expected to be added.
+ *
+ * Creates a map with space reserved for @length entries. If the map is large
+ * enough to be indexed the index is created up front, so adding the entries
+ * does not scan the map. Used when decoding maps of a known size.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_map_sized(guint length);
+
+/**
+ * fl_value_new_typed_list_view:
+ * @type: the type of list to create, one of #FL_VALUE_TYPE_UINT8_LIST,
+ * #FL_VALUE_TYPE_INT32_LIST, #FL_VALUE_TYPE_INT64_LIST,
+ * #FL_VALUE_TYPE_FLOAT32_LIST or #FL_VALUE_TYPE_FLOAT_LIST.
+ * @bytes: the buffer holding the list data.
+ * @offset: the offset of the first element in @bytes.
+ * @length: the number of elements in the list.
+ *
+ * Creates a typed list that references the data in @bytes rather than
+ * copying it, keeping @bytes alive for as long as the list is. The data is
+ * copied if it is not aligned for the element type.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_typed_list_view(FlValueType type,
+                                      GBytes* bytes,
+                                      size_t offset,
+                                      size_t length);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
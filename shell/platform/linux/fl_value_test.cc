@@ -682,6 +682,31 @@ TEST(FlValueTest, MapLookupString) {
   ASSERT_EQ(v, nullptr);
 }
 
+TEST(FlValueTest, MapLookupLarge) {
+  // Large enough for the keys to be indexed.
+  g_autoptr(FlValue) value = fl_value_new_map();
+  for (int i = 0; i < 100; i++) {
+    fl_value_set_take(value, fl_value_new_int(i), fl_value_new_int(i * 2));
+  }
+  for (int i = 0; i < 100; i++) {
+    g_autoptr(FlValue) key = fl_value_new_int(i);
+    FlValue* v = fl_value_lookup(value, key);
+    ASSERT_NE(v, nullptr);
+    EXPECT_EQ(fl_value_get_int(v), i * 2);
+  }
+  g_autoptr(FlValue) missing_key = fl_value_new_int(100);
+  EXPECT_EQ(fl_value_lookup(value, missing_key), nullptr);
+
+  // Replacing an entry keeps its position.
+  fl_value_set_take(value, fl_value_new_int(50), fl_value_new_string("fifty"));
+  EXPECT_EQ(fl_value_get_length(value), static_cast<size_t>(100));
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_map_value(value, 50)),
+               "fifty");
+  g_autoptr(FlValue) fifty_key = fl_value_new_int(50);
+  EXPECT_EQ(fl_value_lookup(value, fifty_key),
+            fl_value_get_map_value(value, 50));
+}
+
 TEST(FlValueTest, MapValueypes) {
   g_autoptr(FlValue) value = fl_value_new_map();
   fl_value_set_take(value, fl_value_new_string("null"), fl_value_new_null());
@@ -842,6 +867,40 @@ TEST(FlValueTest, MapEmptyNotEqual) {
   EXPECT_FALSE(fl_value_equal(value1, value2));
 }
 
+TEST(FlValueTest, MapLargeEqualDifferentOrder) {
+  g_autoptr(FlValue) value1 = fl_value_new_map();
+  g_autoptr(FlValue) value2 = fl_value_new_map();
+  for (int i = 0; i < 100; i++) {
+    fl_value_set_take(value1, fl_value_new_int(i), fl_value_new_int(i));
+    fl_value_set_take(value2, fl_value_new_int(99 - i),
+                      fl_value_new_int(99 - i));
+  }
+  EXPECT_TRUE(fl_value_equal(value1, value2));
+  EXPECT_EQ(fl_value_hash(value1), fl_value_hash(value2));
+}
+
+TEST(FlValueTest, Hash) {
+  g_autoptr(FlValue) zero = fl_value_new_float(0.0);
+  g_autoptr(FlValue) negative_zero = fl_value_new_float(-0.0);
+  EXPECT_EQ(fl_value_hash(zero), fl_value_hash(negative_zero));
+
+  g_autoptr(FlValue) string1 = fl_value_new_string("hello");
+  g_autoptr(FlValue) string2 = fl_value_new_string("hello");
+  EXPECT_EQ(fl_value_hash(string1), fl_value_hash(string2));
+
+  const int32_t data[] = {1, 2, 3};
+  g_autoptr(FlValue) list1 = fl_value_new_int32_list(data, 3);
+  g_autoptr(FlValue) list2 = fl_value_new_int32_list(data, 3);
+  g_autoptr(FlValue) list3 = fl_value_new_int32_list(data, 2);
+  EXPECT_EQ(fl_value_hash(list1), fl_value_hash(list2));
+  EXPECT_NE(fl_value_hash(list1), fl_value_hash(list3));
+
+  // Values of different types that are not equal do not collide trivially.
+  g_autoptr(FlValue) one = fl_value_new_int(1);
+  g_autoptr(FlValue) true_value = fl_value_new_bool(true);
+  EXPECT_NE(fl_value_hash(one), fl_value_hash(true_value));
+}
+
 TEST(FlValueTest, MapToString) {
   g_autoptr(FlValue) value = fl_value_new_map();
   fl_value_set_take(value, fl_value_new_string("null"), fl_value_new_null());
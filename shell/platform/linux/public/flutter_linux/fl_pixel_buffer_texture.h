@@ -100,6 +100,32 @@ struct _FlPixelBufferTextureClass {
                           uint32_t* width,
                           uint32_t* height,
                           GError** error);
+
+  /**
+   * FlPixelBufferTexture::get_dirty_region:
+   * @texture: an #FlPixelBufferTexture.
+   * @x: (out): left edge of the changed region in pixels.
+   * @y: (out): top edge of the changed region in pixels.
+   * @width: (out): width of the changed region in pixels.
+   * @height: (out): height of the changed region in pixels.
+   *
+   * Optional. Called after a successful copy_pixels() to get the region of
+   * the buffer that changed since the previous call, so only that region is
+   * uploaded. Return %FALSE, or leave this unset, to upload the whole buffer.
+   * The whole buffer is always uploaded the first time and whenever its size
+   * changes. Returning an empty region skips the upload.
+   *
+   * Adding this vfunc changed the size of #FlPixelBufferTextureClass, so
+   * subclasses must be compiled against this version of the header. Plugins
+   * are built from source along with the application, which ensures this.
+   *
+   * Returns: %TRUE if only the returned region changed.
+   */
+  gboolean (*get_dirty_region)(FlPixelBufferTexture* texture,
+                               uint32_t* x,
+                               uint32_t* y,
+                               uint32_t* width,
+                               uint32_t* height);
 };
 
 G_END_DECLS
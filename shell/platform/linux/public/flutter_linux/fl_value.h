@@ -327,6 +327,18 @@ FlValueType fl_value_get_type(FlValue* value);
  */
 bool fl_value_equal(FlValue* a, FlValue* b);
 
+/**
+ * fl_value_hash:
+ * @value: an #FlValue.
+ *
+ * Calculates a hash of @value that is consistent with fl_value_equal(), i.e.
+ * equivalent values have the same hash. This is suitable for use as a
+ * #GHashFunc, for example to key a #GHashTable with #FlValue.
+ *
+ * Returns: a hash value.
+ */
+guint fl_value_hash(FlValue* value);
+
 /**
  * fl_value_append:
  * @value: an #FlValue of type #FL_VALUE_TYPE_LIST.
@@ -571,9 +583,8 @@ FlValue* fl_value_get_map_value(FlValue* value, size_t index);
  * fl_value_equal(). Calling this with an #FlValue that is not of type
  * #FL_VALUE_TYPE_MAP is a programming error.
  *
- * Map lookups are not optimized for performance - if you have a large map or
- * need frequent access you should copy the data into another structure, e.g.
- * #GHashTable.
+ * Larger maps index their keys using fl_value_hash(), so keys must not be
+ * modified once they have been added to a map.
  *
  * Returns: (allow-none): the value with this key or %NULL if not one present.
  */
@@ -588,9 +599,8 @@ FlValue* fl_value_lookup(FlValue* value, FlValue* key);
  * fl_value_equal(). Calling this with an #FlValue that is not of type
  * #FL_VALUE_TYPE_MAP is a programming error.
  *
- * Map lookups are not optimized for performance - if you have a large map or
- * need frequent access you should copy the data into another structure, e.g.
- * #GHashTable.
+ * Larger maps index their keys using fl_value_hash(), so keys must not be
+ * modified once they have been added to a map.
  *
  * Returns: (allow-none): the value with this key or %NULL if not one present.
  */
@@ -3,9 +3,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/shell/platform/linux/testing/mock_epoxy.h"
+
 #include <epoxy/egl.h>
 #include <epoxy/gl.h>
 
+#include <vector>
+
+using namespace flutter::testing;
+
+static MockEpoxy* mock = nullptr;
+
 typedef struct {
   EGLint config_id;
   EGLint buffer_size;
@@ -334,10 +342,19 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   return bool_success();
 }
 
+static void _glBindBuffer(GLenum target, GLuint buffer) {}
+
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
 
+static void _glBufferData(GLenum target,
+                          GLsizeiptr size,
+                          const void* data,
+                          GLenum usage) {}
+
+void _glDeleteBuffers(GLsizei n, const GLuint* buffers) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
@@ -348,9 +365,17 @@ static void _glFramebufferTexture2D(GLenum target,
                                     GLuint texture,
                                     GLint level) {}
 
+static void _glGenBuffers(GLsizei n, GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffers[i] = 0;
+  }
+}
+
 static void _glGenTextures(GLsizei n, GLuint* textures) {
+  // Names are non-zero so that textures are seen as created.
+  static GLuint next_texture = 1;
   for (GLsizei i = 0; i < n; i++) {
-    textures[i] = 0;
+    textures[i] = next_texture++;
   }
 }
 
@@ -360,6 +385,24 @@ static void _glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
   }
 }
 
+// Backing store for mapped buffers. Only one buffer is mapped at a time.
+static std::vector<uint8_t> mapped_buffer;
+
+static void* map_buffer_range(GLsizeiptr length) {
+  mapped_buffer.resize(length);
+  return mapped_buffer.data();
+}
+
+static void* _glMapBufferRange(GLenum target,
+                               GLintptr offset,
+                               GLsizeiptr length,
+                               GLbitfield access) {
+  if (mock) {
+    return mock->glMapBufferRange(target, offset, length, access);
+  }
+  return map_buffer_range(length);
+}
+
 static void _glTexParameterf(GLenum target, GLenum pname, GLfloat param) {}
 
 static void _glTexParameteri(GLenum target, GLenum pname, GLint param) {}
@@ -372,7 +415,31 @@ static void _glTexImage2D(GLenum target,
                           GLint border,
                           GLenum format,
                           GLenum type,
-                          const void* pixels) {}
+                          const void* pixels) {
+  if (mock) {
+    mock->glTexImage2D(target, level, internalformat, width, height, border,
+                       format, type, pixels);
+  }
+}
+
+static void _glTexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) {
+  if (mock) {
+    mock->glTexSubImage2D(target, level, xoffset, yoffset, width, height,
+                          format, type, pixels);
+  }
+}
+
+static GLboolean _glUnmapBuffer(GLenum target) {
+  return GL_TRUE;
+}
 
 static GLenum _glGetError() {
   return GL_NO_ERROR;
@@ -386,8 +453,31 @@ bool epoxy_is_desktop_gl(void) {
   return false;
 }
 
+// OpenGL ES 3.0, which supports pixel buffer objects.
+static constexpr int kDefaultGLVersion = 30;
+
 int epoxy_gl_version(void) {
-  return 0;
+  if (mock) {
+    return mock->epoxy_gl_version();
+  }
+  return kDefaultGLVersion;
+}
+
+MockEpoxy::MockEpoxy() {
+  mock = this;
+  ON_CALL(*this, epoxy_gl_version())
+      .WillByDefault(::testing::Return(kDefaultGLVersion));
+  ON_CALL(*this, glMapBufferRange(::testing::_, ::testing::_, ::testing::_,
+                                  ::testing::_))
+      .WillByDefault(
+          [](GLenum target, GLintptr offset, GLsizeiptr length,
+             GLbitfield access) { return map_buffer_range(length); });
+}
+
+MockEpoxy::~MockEpoxy() {
+  if (mock == this) {
+    mock = nullptr;
+  }
 }
 
 #ifdef __GNUC__
@@ -440,8 +530,14 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
 
+void (*epoxy_glBindBuffer)(GLenum target, GLuint buffer);
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
+void (*epoxy_glBufferData)(GLenum target,
+                           GLsizeiptr size,
+                           const void* data,
+                           GLenum usage);
+void (*epoxy_glDeleteBuffers)(GLsizei n, const GLuint* buffers);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
@@ -449,8 +545,13 @@ void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum textarget,
                                      GLuint texture,
                                      GLint level);
+void (*epoxy_glGenBuffers)(GLsizei n, GLuint* buffers);
 void (*epoxy_glGenFramebuffers)(GLsizei n, GLuint* framebuffers);
 void (*epoxy_glGenTextures)(GLsizei n, GLuint* textures);
+void* (*epoxy_glMapBufferRange)(GLenum target,
+                                GLintptr offset,
+                                GLsizeiptr length,
+                                GLbitfield access);
 void (*epoxy_glTexParameterf)(GLenum target, GLenum pname, GLfloat param);
 void (*epoxy_glTexParameteri)(GLenum target, GLenum pname, GLint param);
 void (*epoxy_glTexImage2D)(GLenum target,
@@ -462,6 +563,16 @@ void (*epoxy_glTexImage2D)(GLenum target,
                            GLenum format,
                            GLenum type,
                            const void* pixels);
+void (*epoxy_glTexSubImage2D)(GLenum target,
+                              GLint level,
+                              GLint xoffset,
+                              GLint yoffset,
+                              GLsizei width,
+                              GLsizei height,
+                              GLenum format,
+                              GLenum type,
+                              const void* pixels);
+GLboolean (*epoxy_glUnmapBuffer)(GLenum target);
 GLenum (*epoxy_glGetError)();
 
 static void library_init() {
@@ -478,15 +589,22 @@ static void library_init() {
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
 
+  epoxy_glBindBuffer = _glBindBuffer;
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
+  epoxy_glBufferData = _glBufferData;
+  epoxy_glDeleteBuffers = _glDeleteBuffers;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
+  epoxy_glGenBuffers = _glGenBuffers;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
+  epoxy_glMapBufferRange = _glMapBufferRange;
   epoxy_glTexParameterf = _glTexParameterf;
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
+  epoxy_glTexSubImage2D = _glTexSubImage2D;
+  epoxy_glUnmapBuffer = _glUnmapBuffer;
   epoxy_glGetError = _glGetError;
 }
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_TESTING_MOCK_EPOXY_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_TESTING_MOCK_EPOXY_H_
+
+#include <epoxy/gl.h>
+
+#include "gmock/gmock.h"
+
+namespace flutter {
+namespace testing {
+
+// Receives some of the OpenGL calls made through the mock epoxy library while
+// it exists. Without expectations, calls behave as they do without a mock:
+// the reported version is OpenGL ES 3.0 and buffers can be mapped.
+class MockEpoxy {
+ public:
+  MockEpoxy();
+  ~MockEpoxy();
+
+  MOCK_METHOD0(epoxy_gl_version, int());
+
+  MOCK_METHOD4(glMapBufferRange,
+               void*(GLenum target,
+                     GLintptr offset,
+                     GLsizeiptr length,
+                     GLbitfield access));
+
+  MOCK_METHOD9(glTexImage2D,
+               void(GLenum target,
+                    GLint level,
+                    GLint internalformat,
+                    GLsizei width,
+                    GLsizei height,
+                    GLint border,
+                    GLenum format,
+                    GLenum type,
+                    const void* pixels));
+
+  MOCK_METHOD9(glTexSubImage2D,
+               void(GLenum target,
+                    GLint level,
+                    GLint xoffset,
+                    GLint yoffset,
+                    GLsizei width,
+                    GLsizei height,
+                    GLenum format,
+                    GLenum type,
+                    const void* pixels));
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_TESTING_MOCK_EPOXY_H_
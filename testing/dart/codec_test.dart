@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:io';
+import 'dart:math' as math;
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 
@@ -99,6 +100,46 @@ void main() {
       expect(e.toString(), contains('Decoded image has been disposed'));
     }
   });
+
+  test('progressive codec returns partial frames before the data is complete', () async {
+    final Uint8List data = await _getSkiaResource('baby_tux.png').readAsBytes();
+    final ui.ProgressiveCodec codec = ui.ProgressiveCodec();
+    final int half = data.length ~/ 2;
+    for (int offset = 0; offset < half; offset += 1024) {
+      codec.addChunk(Uint8List.sublistView(data, offset, math.min(offset + 1024, half)));
+    }
+
+    final ui.FrameInfo partial = await codec.getNextFrame();
+    expect(codec.isComplete, false);
+    expect(partial.image.width, 240);
+    expect(partial.image.height, 246);
+    partial.image.dispose();
+
+    codec.addChunk(Uint8List.sublistView(data, half));
+    codec.finish();
+    do {
+      final ui.FrameInfo frame = await codec.getNextFrame();
+      frame.image.dispose();
+    } while (!codec.isComplete);
+
+    final ui.FrameInfo again = await codec.getNextFrame();
+    expect(codec.isComplete, true);
+    expect(again.image.width, 240);
+    expect(again.image.height, 246);
+    codec.dispose();
+  });
+
+  test('progressive codec fails with invalid data', () async {
+    final ui.ProgressiveCodec codec = ui.ProgressiveCodec();
+    codec.addChunk(Uint8List.fromList(List<int>.filled(1024, 0xAB)));
+    codec.finish();
+    try {
+      await codec.getNextFrame();
+      fail('exception not thrown');
+    } on Exception catch (e) {
+      expect(e.toString(), contains('Codec failed'));
+    }
+  });
 }
 
 /// Returns a File handle to a file in the skia/resources directory.